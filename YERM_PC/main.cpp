@@ -19,8 +19,8 @@ int main(int argc, char* argv[]){
         printer() {
             fc = new FinalScene(YRGraphics::createRenderPass2Screen(0, 0, {}));
 
-            ve = VisualElement::create();
-            fc->insert(ve);
+            veh = fc->insert();
+            VisualElement* ve = fc->get(veh);
             ve->instanceCount = 1;
             ve->pipeline = get2DDefaultPipeline();
             ve->mesh0 = get2DDefaultQuad();
@@ -56,7 +56,7 @@ int main(int argc, char* argv[]){
             delete fc;
         }
         FinalScene* fc;
-        pVisualElement ve;
+        VisualElementHandle veh;
     };
     Entity e;
     game.setInit([&e]() {
@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "yr_2d.h"
+#include "yr_scene.h"
+#include "logger.hpp"
+
+#include <cstring>
 
 namespace onart{
     YRGraphics::pPipeline get2DDefaultPipeline() {
@@ -244,8 +248,8 @@ void main() {
         return YRGraphics::getPipeline(_2dppid);
     }
 
-    YRGraphics::pPipeline get2DInstancedPipeline() {
-        static int32_t _2dppid = INT32_MIN;
+    /// @brief 인스턴스 2D 파이프라인을 생성합니다. sdf가 true면 텍스처 알파를 부호 있는 거리장으로 보고 0.5를 경계로 부드럽게 잘라 그립니다.
+    static YRGraphics::pPipeline create2DInstancedPipeline(int32_t& _2dppid, bool sdf) {
         if (_2dppid == INT32_MIN) {
             _2dppid = YRGraphics::issuePipelineKey();
 
@@ -340,10 +344,31 @@ void main() {
                 */
                 const uint32_t _2DFS[] = { 119734787,65536,851979,32,0,131089,1,393227,1,1280527431,1685353262,808793134,0,196622,0,1,458767,4,4,1852399981,0,9,17,196624,4,7,262215,9,30,0,262215,13,34,2,262215,13,33,0,262215,17,30,0,262215,22,6,16,327752,23,0,35,0,327752,23,1,35,16,196679,23,2,131091,2,196641,3,2,196630,6,32,262167,7,6,4,262176,8,3,7,262203,8,9,3,589849,10,6,1,0,0,0,1,0,196635,11,10,262176,12,0,11,262203,12,13,0,262167,15,6,2,262176,16,1,15,262203,16,17,1,262165,20,32,0,262187,20,21,7,262172,22,7,21,262174,23,7,22,262176,24,9,23,262203,24,25,9,262165,26,32,1,262187,26,27,0,262176,28,9,7,327734,2,4,0,3,131320,5,262205,11,14,13,262205,15,18,17,327767,7,19,14,18,327745,28,29,25,27,262205,7,30,29,327813,7,31,19,30,196670,9,31,65789,65592 };
 
+                /*
+                #version 450
+
+                layout(location = 0) in vec2 tc;
+
+                layout(location = 0) out vec4 outColor;
+                layout(set = 2, binding = 0) uniform sampler2D tex;
+
+                layout(std140, push_constant) uniform ui{
+                    vec4 color;
+                    vec4 pad[7];
+                };
+
+                void main() {
+                    float dist = texture(tex, tc).a;
+                    float w = max(fwidth(dist), 1e-4);
+                    outColor = vec4(color.rgb, color.a * smoothstep(0.5 - w, 0.5 + w, dist));
+                }
+                */
+                const uint32_t _2DSDFFS[] = { 119734787,65536,851979,45,0,131089,1,393227,1,1280527431,1685353262,808793134,0,196622,0,1,458767,4,4,1852399981,0,9,17,196624,4,7,262215,9,30,0,262215,13,34,2,262215,13,33,0,262215,17,30,0,262215,22,6,16,327752,23,0,35,0,327752,23,1,35,16,196679,23,2,131091,2,196641,3,2,196630,6,32,262187,6,41,953267991,262187,6,42,1056964608,262167,7,6,4,262176,8,3,7,262203,8,9,3,589849,10,6,1,0,0,0,1,0,196635,11,10,262176,12,0,11,262203,12,13,0,262167,15,6,2,262176,16,1,15,262203,16,17,1,262165,20,32,0,262187,20,21,7,262172,22,7,21,262174,23,7,22,262176,24,9,23,262203,24,25,9,262165,26,32,1,262187,26,27,0,262176,28,9,7,327734,2,4,0,3,131320,5,262205,11,14,13,262205,15,18,17,327767,7,19,14,18,327745,28,29,25,27,262205,7,30,29,327761,6,32,19,3,262353,6,33,32,458764,6,34,1,40,33,41,327811,6,35,42,34,327809,6,36,42,34,524300,6,37,1,49,35,36,32,327761,6,38,30,3,327813,6,39,38,37,393298,7,43,39,30,3,196670,9,43,65789,65592 };
                 int32_t vshk = YRGraphics::issueShaderKey();
                 opts.vertexShader = YRGraphics::createShader(vshk, { _2DVS, sizeof(_2DVS), ShaderStage::VERTEX });
                 int32_t fshk = YRGraphics::issueShaderKey();
-                opts.fragmentShader = YRGraphics::createShader(fshk, { _2DFS, sizeof(_2DFS), ShaderStage::FRAGMENT });
+                if (sdf) { opts.fragmentShader = YRGraphics::createShader(fshk, { _2DSDFFS, sizeof(_2DSDFFS), ShaderStage::FRAGMENT }); }
+                else { opts.fragmentShader = YRGraphics::createShader(fshk, { _2DFS, sizeof(_2DFS), ShaderStage::FRAGMENT }); }
             }
             else if constexpr (YRGraphics::OPENGL_GRAPHICS) {
                 const char _2DVS[] = R"(
@@ -385,11 +410,27 @@ layout(std140, binding=11) uniform ui{
 void main() {
     outColor = texture(tex, tc) * color;
 }
+)";
+                const char _2DSDFFS[] = R"(
+#version 450
+layout(location = 0) in vec2 tc;
+out vec4 outColor;
+layout(binding = 0) uniform sampler2D tex;
+layout(std140, binding=11) uniform ui{
+    vec4 color;
+    vec4 pad[7];
+};
+void main() {
+    float dist = texture(tex, tc).a;
+    float w = max(fwidth(dist), 1e-4);
+    outColor = vec4(color.rgb, color.a * smoothstep(0.5 - w, 0.5 + w, dist));
+}
 )";
                 int32_t vshk = YRGraphics::issueShaderKey();
                 opts.vertexShader = YRGraphics::createShader(vshk, { _2DVS, sizeof(_2DVS), ShaderStage::VERTEX });
                 int32_t fshk = YRGraphics::issueShaderKey();
-                opts.fragmentShader = YRGraphics::createShader(fshk, { _2DFS, sizeof(_2DFS), ShaderStage::FRAGMENT });
+                if (sdf) { opts.fragmentShader = YRGraphics::createShader(fshk, { _2DSDFFS, sizeof(_2DSDFFS), ShaderStage::FRAGMENT }); }
+                else { opts.fragmentShader = YRGraphics::createShader(fshk, { _2DFS, sizeof(_2DFS), ShaderStage::FRAGMENT }); }
             }
             else if constexpr (YRGraphics::D3D11_GRAPHICS) {
                 /*
@@ -481,11 +522,28 @@ layout(std140) uniform push{
 void main() {
     outColor = texture(tex, tc) * color;
 }
+)";
+                const char _2DSDFFS[] = R"(#version 300 es
+precision mediump float;
+
+in vec2 tc;
+out vec4 outColor;
+uniform sampler2D tex;
+layout(std140) uniform push{
+    vec4 color;
+    vec4 pad[7];
+};
+void main() {
+    float dist = texture(tex, tc).a;
+    float w = max(fwidth(dist), 1e-4);
+    outColor = vec4(color.rgb, color.a * smoothstep(0.5 - w, 0.5 + w, dist));
+}
 )";
                 int32_t vshk = YRGraphics::issueShaderKey();
                 opts.vertexShader = YRGraphics::createShader(vshk, { _2DVS, sizeof(_2DVS), ShaderStage::VERTEX });
                 int32_t fshk = YRGraphics::issueShaderKey();
-                opts.fragmentShader = YRGraphics::createShader(fshk, { _2DFS, sizeof(_2DFS), ShaderStage::FRAGMENT });
+                if (sdf) { opts.fragmentShader = YRGraphics::createShader(fshk, { _2DSDFFS, sizeof(_2DSDFFS), ShaderStage::FRAGMENT }); }
+                else { opts.fragmentShader = YRGraphics::createShader(fshk, { _2DFS, sizeof(_2DFS), ShaderStage::FRAGMENT }); }
             }
             else {
                 static_assert(YRGraphics::VULKAN_GRAPHICS || YRGraphics::D3D11_GRAPHICS || YRGraphics::OPENGL_GRAPHICS || YRGraphics::OPENGLES_GRAPHICS || YRGraphics::WEBGL_GRAPHICS, "Not ready");
@@ -495,6 +553,23 @@ void main() {
         return YRGraphics::getPipeline(_2dppid);
     }
 
+    YRGraphics::pPipeline get2DInstancedPipeline() {
+        static int32_t _2dppid = INT32_MIN;
+        return create2DInstancedPipeline(_2dppid, false);
+    }
+
+    YRGraphics::pPipeline get2DTextPipeline() {
+        if constexpr (YRGraphics::D3D11_GRAPHICS) {
+            // SDF용 HLSL 바이트코드가 없으므로 거리 값을 알파로 그리는 대체 파이프라인을 주지 않습니다.
+            LOGWITH("SDF text pipeline is not available on D3D11");
+            return {};
+        }
+        else {
+            static int32_t _2dppid = INT32_MIN;
+            return create2DInstancedPipeline(_2dppid, true);
+        }
+    }
+
     YRGraphics::pMesh get2DDefaultQuad() {
         static int32_t _2dmeshid = INT32_MIN;
         if (_2dmeshid == INT32_MIN) {
@@ -517,4 +592,139 @@ void main() {
         }
         return YRGraphics::getMesh(_2dmeshid);
     }
+
+    YRGraphics::pTexture get2DWhiteTexture() {
+        static int32_t whiteid = INT32_MIN;
+        if (whiteid == INT32_MIN) {
+            whiteid = YRGraphics::issueTextureKey();
+            const uint8_t white[4] = { 255, 255, 255, 255 };
+            TextureCreationOptions opts;
+            opts.linearSampled = false;
+            YRGraphics::createTextureFromColor(whiteid, white, 1, 1, opts);
+        }
+        return YRGraphics::getTexture(whiteid);
+    }
+
+    /// @brief 배치 전용 사각형 메시를 생성합니다. OpenGL에서는 VAO가 기본 메시에 인스턴스 버퍼와 함께 묶이므로 인스턴스 버퍼를 새로 만들 때마다 이것도 새로 만들어야 합니다.
+    static YRGraphics::pMesh createSpriteQuad() {
+        MeshCreationOptions opts{};
+        opts.vertexCount = 4;
+        opts.indexCount = 6;
+        float verts[] = {
+            -1,-1,0,0,
+            -1,1,0,1,
+            1,-1,1,0,
+            1,1,1,1
+        };
+        uint16_t inds[]{ 0,1,2,2,1,3 };
+        opts.vertices = verts;
+        opts.indices = inds;
+        opts.singleIndexSize = 2;
+        opts.singleVertexSize = sizeof(_2dvertex_t);
+        return YRGraphics::createMesh(INT32_MIN, opts);
+    }
+
+    SpriteBatch::SpriteBatch(uint32_t initialCapacity, const YRGraphics::pPipeline& pipeline): pipeline(pipeline ? pipeline : get2DInstancedPipeline()), capacity(initialCapacity ? initialCapacity : 1) {
+        instances.reserve(capacity);
+    }
+
+    void SpriteBatch::add(const mat4& model, const YRGraphics::pTexture& texture, const vec4& texrect, const vec4& color) {
+        const uint32_t index = (uint32_t)instances.size();
+        SpriteInstance& inst = instances.emplace_back();
+        std::memcpy(inst.model, model.a, sizeof(inst.model));
+        std::memcpy(inst.texrect, texrect.entry, sizeof(inst.texrect));
+        if (runs.empty() || runs.back().texture != texture || runs.back().color != color) {
+            runs.push_back({ texture, color, index, 1 });
+        }
+        else {
+            runs.back().count++;
+        }
+        dirty = true;
+    }
+
+    SpriteInstance* SpriteBatch::allocate(uint32_t count, const YRGraphics::pTexture& texture, const vec4& color) {
+        if (count == 0) return nullptr;
+        const uint32_t index = (uint32_t)instances.size();
+        instances.resize(index + count);
+        if (runs.empty() || runs.back().texture != texture || runs.back().color != color) {
+            runs.push_back({ texture, color, index, count });
+        }
+        else {
+            runs.back().count += count;
+        }
+        dirty = true;
+        return instances.data() + index;
+    }
+
+    void SpriteBatch::clear() {
+        instances.clear();
+        runs.clear();
+        dirty = true;
+    }
+
+    void SpriteBatch::upload() {
+        if (!dirty) return;
+        dirty = false;
+        if (instances.empty()) return;
+        if (!instanceBuffer || instances.size() > capacity) {
+            while (capacity < instances.size()) { capacity *= 2; }
+            std::unique_ptr<SpriteInstance[]> initial(new SpriteInstance[capacity]());
+            MeshCreationOptions opts{};
+            opts.vertices = initial.get();
+            opts.vertexCount = capacity;
+            opts.singleVertexSize = sizeof(SpriteInstance);
+            opts.fixed = false;
+            instanceBuffer = YRGraphics::createMesh(INT32_MIN, opts);
+            quad = createSpriteQuad();
+        }
+        if (instanceBuffer) { instanceBuffer->update(instances.data(), 0, (uint32_t)(instances.size() * sizeof(SpriteInstance))); }
+    }
+
+    template<class RP>
+    void SpriteBatch::drawTo(RP* target) {
+        if (runs.empty()) return;
+#ifdef YR_HAS_STREAM_GEOMETRY
+        // 인스턴스 데이터는 매 프레임 새로 만들므로 스트리밍 버퍼에 바로 써서 메시 갱신(Vulkan에서는 스테이징 복사와 제출)을 피합니다.
+        if (!quad) { quad = createSpriteQuad(); }
+        YRGraphics::StreamGeometry instanceInfo = YRGraphics::allocateStreamGeometry((uint32_t)instances.size(), sizeof(SpriteInstance));
+        if (!quad || !instanceInfo) return;
+        std::memcpy(instanceInfo.vertices, instances.data(), instances.size() * sizeof(SpriteInstance));
+#else
+        upload();
+        if (!instanceBuffer || !quad) return;
+        const YRGraphics::pMesh& instanceInfo = instanceBuffer;
+#endif
+        target->usePipeline(pipeline.get(), 0);
+        vec4 prevColor(-1);
+        for (Run& run : runs) {
+            if (run.color != prevColor) {
+                target->push(&run.color, 0, sizeof(vec4));
+                prevColor = run.color;
+            }
+            target->bind(_2D_TEXTURE_BIND_INDEX, run.texture);
+            target->invoke(quad, instanceInfo, run.count, run.start);
+        }
+    }
+
+    void SpriteBatch::draw(YRGraphics::RenderPass* target) { drawTo(target); }
+#ifdef YR_USE_VULKAN
+    void SpriteBatch::draw(YRGraphics::RenderPass2Screen* target) { drawTo(target); }
+#endif
+
+    Sprite::Sprite(SpriteBatch* batch, const YRGraphics::pTexture& texture, const vec4& texrect, const vec4& color): texture(texture), texrect(texrect), color(color), batch(batch) {}
+
+    void Sprite::draw(Transform& transform) {
+        batch->add(transform.getGlobalTransform(), texture, texrect, color);
+    }
+
+    SpriteBatch* addSpriteBatch(Scene& scene, VisualElementHandle* handle, const YRGraphics::pPipeline& pipeline) {
+        VisualElementHandle h = scene.insert();
+        VisualElement* elem = scene.get(h);
+        SpriteBatch* batch = new SpriteBatch(1024, pipeline);
+        elem->fr.reset(batch);
+        elem->pipeline = batch->getPipeline();
+        elem->transparent = true;
+        if (handle) { *handle = h; }
+        return batch;
+    }
 }
\ No newline at end of file
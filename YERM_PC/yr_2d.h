@@ -14,7 +14,7 @@
 #ifndef __YR_2D_H__
 #define __YR_2D_H__
 
-#include "yr_graphics.h"
+#include "yr_visual.h"
 
 namespace onart{
     class Transform;
@@ -22,18 +22,92 @@ namespace onart{
 
     using _2dvertex_t = YRGraphics::Vertex<float[2], float[2]>;
     YRGraphics::pPipeline get2DDefaultPipeline();
+    /// @brief get2DDefaultPipeline()의 푸시 상수 앞부분입니다.
+    struct _2dpush_t {
+        mat4 model;
+        vec4 texrect;
+        vec4 color;
+    };
+    /// @brief 2D 파이프라인들의 텍스처 바인드 위치입니다.
+    constexpr uint32_t _2D_TEXTURE_BIND_INDEX = YRGraphics::VULKAN_GRAPHICS ? 2 : 0;
     YRGraphics::pPipeline get2DInstancedPipeline();
+    /// @brief get2DInstancedPipeline()과 입력이 같고, 텍스처 알파를 부호 있는 거리장(SDF)으로 해석하여 그리는 파이프라인입니다. 글리프 등에 사용합니다. D3D11에서는 지원하지 않으며 빈 포인터를 리턴합니다.
+    YRGraphics::pPipeline get2DTextPipeline();
     YRGraphics::pMesh get2DDefaultQuad();
+    /// @brief 1x1 흰색 텍스처입니다. 2D 파이프라인으로 단색 도형을 그릴 때 사용합니다.
+    YRGraphics::pTexture get2DWhiteTexture();
+
+    /// @brief get2DInstancedPipeline()의 인스턴스 속성 1개입니다. 행 우선 모델 행렬의 위 3행과 텍스처 좌표 변환(xy: 배율, zw: 오프셋)입니다.
+    struct SpriteInstance {
+        float model[12];
+        float texrect[4];
+    };
+    static_assert(sizeof(SpriteInstance) == sizeof(YRGraphics::Vertex<float[4], float[4], float[4], float[4]>), "SpriteInstance must match the instance layout of get2DInstancedPipeline()");
+
+    /// @brief 한 프레임 동안 제출된 스프라이트를 모아 연속으로 같은 텍스처, 색을 쓰는 구간마다 인스턴스 드로우 1회로 그립니다.
+    /// Vulkan, OpenGL에서는 인스턴스 데이터를 스트리밍 버퍼(YRGraphics::allocateStreamGeometry)에 바로 씁니다. 그 외에서는 프레임 간 재사용하는 인스턴스 버퍼를 갱신하며, 이 버퍼는 용량이 부족할 때만 2배로 늘어납니다. 그리는 순서는 제출 순서를 따르므로 같은 텍스처끼리 이어서 제출할수록 드로우 수가 줄어듭니다.
+    class SpriteBatch: public FreeRenderer {
+        public:
+            /// @param initialCapacity 처음 확보할 인스턴스 수
+            /// @param pipeline 사용할 파이프라인. get2DInstancedPipeline()과 입력 형식이 같아야 합니다. 주어지지 않으면 get2DInstancedPipeline()을 사용합니다.
+            SpriteBatch(uint32_t initialCapacity = 1024, const YRGraphics::pPipeline& pipeline = {});
+            /// @brief 스프라이트 하나를 이번 프레임 목록에 추가합니다.
+            /// @param model 모델 행렬. 기본 사각형은 -1~1 범위입니다.
+            /// @param texture 텍스처
+            /// @param texrect 텍스처 좌표 변환 (xy: 배율, zw: 오프셋)
+            /// @param color 텍스처에 곱할 색
+            void add(const mat4& model, const YRGraphics::pTexture& texture, const vec4& texrect = vec4(1, 1, 0, 0), const vec4& color = vec4(1));
+            /// @brief 같은 텍스처, 색을 쓰는 스프라이트 count개의 자리를 이번 프레임 목록 끝에 확보하고 그 첫 항목을 리턴합니다. 파티클처럼 인스턴스 데이터를 직접 채우는 경우에 사용합니다.
+            /// 리턴된 포인터는 다음 add/allocate/clear 호출 전까지만 유효합니다. count가 0이면 nullptr를 리턴합니다.
+            SpriteInstance* allocate(uint32_t count, const YRGraphics::pTexture& texture, const vec4& color = vec4(1));
+            /// @brief 이번 프레임 목록을 비웁니다. 인스턴스 버퍼는 해제하지 않습니다. 매 프레임 스프라이트를 제출하기 전에 호출하세요.
+            void clear();
+            /// @brief 이번 프레임에 제출된 스프라이트 수를 리턴합니다.
+            inline size_t size() const { return instances.size(); }
+            /// @brief 이번 프레임에 필요한 드로우 호출 수를 리턴합니다.
+            inline size_t drawCount() const { return runs.size(); }
+            inline const YRGraphics::pPipeline& getPipeline() const { return pipeline; }
+            void draw(YRGraphics::RenderPass*) override;
+#ifdef YR_USE_VULKAN
+            void draw(YRGraphics::RenderPass2Screen*) override;
+#endif
+        private:
+            template<class RP>
+            void drawTo(RP* target);
+            /// @brief 인스턴스 버퍼가 이번 프레임 목록을 담을 수 있도록 하고 내용을 올립니다. 스트리밍 버퍼가 없는 백엔드에서만 사용합니다.
+            void upload();
+            struct Run {
+                YRGraphics::pTexture texture;
+                vec4 color;
+                uint32_t start;
+                uint32_t count;
+            };
+            std::vector<SpriteInstance> instances;
+            std::vector<Run> runs;
+            YRGraphics::pPipeline pipeline;
+            YRGraphics::pMesh quad;
+            YRGraphics::pMesh instanceBuffer;
+            uint32_t capacity;
+            bool dirty = false;
+    };
 
+    /// @brief 스프라이트 1개의 텍스처와 색 정보입니다. 그릴 때마다 SpriteBatch에 인스턴스 1개를 추가할 뿐이므로 개별 VisualElement를 만들지 않습니다.
     class Sprite{
         public:
-            void draw(const class Transform&);
+            Sprite(SpriteBatch* batch, const YRGraphics::pTexture& texture, const vec4& texrect = vec4(1, 1, 0, 0), const vec4& color = vec4(1));
+            /// @brief 주어진 변환의 전역 행렬로 이번 프레임에 이 스프라이트를 그리도록 합니다.
+            void draw(class Transform&);
+            YRGraphics::pTexture texture;
+            vec4 texrect;
+            vec4 color;
         private:
-            Sprite();
-            struct VisualElement* elem;
+            SpriteBatch* batch;
     };
 
-    void addSprite(class Scene& scene);
+    /// @brief 장면에 SpriteBatch를 그리는 요소를 추가하고 그 배치를 리턴합니다. 리턴된 포인터는 해당 요소가 제거될 때까지 유효합니다.
+    /// @param handle nullptr가 아니면 추가된 요소의 핸들을 여기에 저장합니다.
+    /// @param pipeline 배치가 사용할 파이프라인. 주어지지 않으면 get2DInstancedPipeline()을 사용합니다.
+    SpriteBatch* addSpriteBatch(class Scene& scene, VisualElementHandle* handle = nullptr, const YRGraphics::pPipeline& pipeline = {});
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,165 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "yr_atlas.h"
+#include "logger.hpp"
+
+#include "../externals/single_header/stb_image.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace onart {
+
+    TextureAtlas::TextureAtlas(uint32_t pageWidth, uint32_t pageHeight, uint32_t padding, const TextureCreationOptions& opts)
+        :opts(opts), pageWidth(pageWidth), pageHeight(pageHeight), padding(padding) {
+        this->opts.nChannels = 4;
+    }
+
+    bool TextureAtlas::allocate(uint32_t width, uint32_t height, Entry& entry) {
+        const uint32_t pw = width + padding * 2, ph = height + padding * 2;
+        if (pw > pageWidth || ph > pageHeight) return false;
+        entry.width = width;
+        entry.height = height;
+        for (uint32_t i = 0; i < pages.size(); i++) {
+            if (pages[i].packer.insert(pw, ph, entry.rect)) {
+                entry.page = i;
+                return true;
+            }
+        }
+        Page& page = pages.emplace_back();
+        page.packer.reset(pageWidth, pageHeight);
+        page.pixels.resize((size_t)pageWidth * pageHeight * 4);
+        page.packer.insert(pw, ph, entry.rect);
+        entry.page = (uint32_t)pages.size() - 1;
+        return true;
+    }
+
+    void TextureAtlas::blit(const Entry& entry, const uint8_t* rgba, uint32_t stride) {
+        Page& page = pages[entry.page];
+        const size_t rowBytes = (size_t)entry.width * 4;
+        const uint32_t left = entry.rect.x + padding, top = entry.rect.y + padding;
+        for (uint32_t y = 0; y < entry.height; y++) {
+            uint8_t* row = &page.pixels[(((size_t)top + y) * pageWidth + left) * 4];
+            std::memcpy(row, rgba + (size_t)y * stride * 4, rowBytes);
+            for (uint32_t p = 1; p <= padding; p++) {
+                std::memcpy(row - p * 4, row, 4);
+                std::memcpy(row + rowBytes + (p - 1) * 4, row + rowBytes - 4, 4);
+            }
+        }
+        const size_t paddedBytes = (size_t)entry.rect.width * 4;
+        const uint8_t* first = &page.pixels[((size_t)top * pageWidth + entry.rect.x) * 4];
+        const uint8_t* last = &page.pixels[(((size_t)top + entry.height - 1) * pageWidth + entry.rect.x) * 4];
+        for (uint32_t p = 1; p <= padding; p++) {
+            std::memcpy(&page.pixels[(((size_t)top - p) * pageWidth + entry.rect.x) * 4], first, paddedBytes);
+            std::memcpy(&page.pixels[(((size_t)top + entry.height - 1 + p) * pageWidth + entry.rect.x) * 4], last, paddedBytes);
+        }
+        page.dirty = true;
+    }
+
+    uint32_t TextureAtlas::add(const uint8_t* rgba, uint32_t width, uint32_t height) {
+        Entry entry;
+        if (width == 0 || height == 0 || !allocate(width, height, entry)) {
+            LOGWITH("Image of size", width, 'x', height, "does not fit in an atlas page");
+            return UINT32_MAX;
+        }
+        blit(entry, rgba, width);
+        uint32_t id;
+        if (freeIds.empty()) {
+            id = (uint32_t)entries.size();
+            entries.push_back(entry);
+        }
+        else {
+            id = freeIds.back();
+            freeIds.pop_back();
+            entries[id] = entry;
+        }
+        return id;
+    }
+
+    uint32_t TextureAtlas::addFromImage(const char* fileName) {
+        int x, y, nChannels;
+        uint8_t* pix = stbi_load(fileName, &x, &y, &nChannels, 4);
+        if (!pix) {
+            LOGWITH("Failed to load image:", stbi_failure_reason());
+            return UINT32_MAX;
+        }
+        uint32_t id = add(pix, (uint32_t)x, (uint32_t)y);
+        stbi_image_free(pix);
+        return id;
+    }
+
+    uint32_t TextureAtlas::addFromImage(const void* mem, size_t size) {
+        int x, y, nChannels;
+        uint8_t* pix = stbi_load_from_memory((const uint8_t*)mem, (int)size, &x, &y, &nChannels, 4);
+        if (!pix) {
+            LOGWITH("Failed to load image:", stbi_failure_reason());
+            return UINT32_MAX;
+        }
+        uint32_t id = add(pix, (uint32_t)x, (uint32_t)y);
+        stbi_image_free(pix);
+        return id;
+    }
+
+    void TextureAtlas::remove(uint32_t id) {
+        if (id >= entries.size() || entries[id].page == UINT32_MAX) return;
+        Entry& entry = entries[id];
+        pages[entry.page].packer.remove(entry.rect);
+        entry.page = UINT32_MAX;
+        freeIds.push_back(id);
+    }
+
+    void TextureAtlas::defragment() {
+        std::vector<Page> old;
+        old.swap(pages);
+        std::vector<uint32_t> order;
+        order.reserve(entries.size());
+        for (uint32_t i = 0; i < entries.size(); i++) {
+            if (entries[i].page != UINT32_MAX) { order.push_back(i); }
+        }
+        std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+            const Entry& ea = entries[a];
+            const Entry& eb = entries[b];
+            return ea.height != eb.height ? ea.height > eb.height : ea.width > eb.width;
+        });
+        for (uint32_t id : order) {
+            Entry& entry = entries[id];
+            const Page& src = old[entry.page];
+            const uint8_t* origin = &src.pixels[(((size_t)entry.rect.y + padding) * pageWidth + entry.rect.x + padding) * 4];
+            allocate(entry.width, entry.height, entry);
+            blit(entry, origin, pageWidth);
+        }
+        version++;
+    }
+
+    void TextureAtlas::flush() {
+        for (Page& page : pages) {
+            if (!page.dirty) continue;
+            page.texture = YRGraphics::createTextureFromColor(INT32_MIN, page.pixels.data(), pageWidth, pageHeight, opts);
+            page.dirty = false;
+        }
+    }
+
+    vec4 TextureAtlas::getTexrect(uint32_t id) const {
+        const Entry& entry = entries[id];
+        const float iw = 1.0f / pageWidth, ih = 1.0f / pageHeight;
+        return vec4(entry.width * iw, entry.height * ih, (entry.rect.x + padding) * iw, (entry.rect.y + padding) * ih);
+    }
+
+    float TextureAtlas::occupancy() const {
+        if (pages.empty()) return 0.0f;
+        float sum = 0;
+        for (const Page& page : pages) { sum += page.packer.occupancy(); }
+        return sum / pages.size();
+    }
+}
@@ -0,0 +1,82 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef __YR_ATLAS_H__
+#define __YR_ATLAS_H__
+
+#include "yr_graphics.h"
+#include "yr_rectpack.hpp"
+
+namespace onart {
+
+    /// @brief 작은 RGBA 이미지 여러 개를 큰 텍스처(페이지) 몇 장에 모아 담습니다. 추가/제거는 CPU 측 픽셀에만 반영되며 flush()에서 바뀐 페이지만 다시 올립니다.
+    /// 각 이미지의 위치는 get2DInstancedPipeline()과 SpriteBatch가 그대로 받는 texrect(xy: 배율, zw: 오프셋)로 얻을 수 있습니다.
+    class TextureAtlas {
+    public:
+        /// @param pageWidth 페이지 가로 길이(px)
+        /// @param pageHeight 페이지 세로 길이(px)
+        /// @param padding 이미지 사이 간격(px). 선형 필터링 시 번짐을 막기 위해 이 간격만큼 가장자리 픽셀을 늘려 채웁니다.
+        /// @param opts 페이지 텍스처 생성 옵션
+        TextureAtlas(uint32_t pageWidth = 2048, uint32_t pageHeight = 2048, uint32_t padding = 1, const TextureCreationOptions& opts = {});
+        /// @brief RGBA 픽셀 데이터를 추가하고 그 번호를 리턴합니다. 페이지보다 큰 이미지면 UINT32_MAX를 리턴합니다.
+        /// @param rgba 행 사이 패딩이 없는 RGBA8 픽셀 데이터
+        uint32_t add(const uint8_t* rgba, uint32_t width, uint32_t height);
+        /// @brief 이미지 파일을 불러와 추가하고 그 번호를 리턴합니다. 실패하면 UINT32_MAX를 리턴합니다.
+        uint32_t addFromImage(const char* fileName);
+        /// @brief 메모리 내의 이미지 파일을 불러와 추가하고 그 번호를 리턴합니다. 실패하면 UINT32_MAX를 리턴합니다.
+        uint32_t addFromImage(const void* mem, size_t size);
+        /// @brief 주어진 번호의 이미지를 제거합니다. 그 영역은 다음 추가 때 재사용됩니다.
+        void remove(uint32_t id);
+        /// @brief 남아 있는 이미지를 큰 것부터 새로 배치하여 빈 공간과 페이지 수를 줄입니다. 이미지 번호는 유지되지만 페이지와 texrect가 바뀌므로 다시 얻어야 합니다.
+        void defragment();
+        /// @brief 바뀐 페이지의 텍스처를 새로 만듭니다. 그리기 전에 호출하세요. 이전에 얻은 텍스처는 바뀌기 전 내용을 유지하므로 페이지 텍스처도 다시 얻어야 합니다.
+        void flush();
+        /// @brief 이미지가 있는 페이지 번호를 리턴합니다.
+        inline uint32_t getPage(uint32_t id) const { return entries[id].page; }
+        /// @brief 이미지 영역의 texrect(xy: 배율, zw: 오프셋)를 리턴합니다.
+        vec4 getTexrect(uint32_t id) const;
+        /// @brief 페이지 텍스처를 리턴합니다. flush() 이전에는 최신 내용이 아닐 수 있습니다.
+        inline const YRGraphics::pTexture& getTexture(uint32_t page) const { return pages[page].texture; }
+        /// @brief 이미지가 있는 페이지 텍스처를 리턴합니다.
+        inline const YRGraphics::pTexture& getTextureOf(uint32_t id) const { return pages[entries[id].page].texture; }
+        inline size_t pageCount() const { return pages.size(); }
+        /// @brief 배치가 바뀔 때마다(defragment) 증가합니다. 보관해 둔 texrect를 다시 얻어야 하는지 판단할 때 사용합니다.
+        inline uint32_t getVersion() const { return version; }
+        /// @brief 모든 페이지 면적 중 이미지가 차지한 비율을 리턴합니다.
+        float occupancy() const;
+    private:
+        struct Page {
+            RectPacker packer;
+            std::vector<uint8_t> pixels;
+            YRGraphics::pTexture texture;
+            bool dirty = false;
+        };
+        struct Entry {
+            RectPacker::Rect rect; // 패딩을 포함한 영역
+            uint32_t page = UINT32_MAX;
+            uint32_t width = 0, height = 0;
+        };
+        /// @brief 패딩을 포함한 영역을 어느 페이지에 배치합니다. 자리가 없으면 페이지를 새로 만듭니다.
+        bool allocate(uint32_t width, uint32_t height, Entry& entry);
+        /// @brief 픽셀을 페이지에 복사하고 패딩 영역을 가장자리 픽셀로 채웁니다.
+        void blit(const Entry& entry, const uint8_t* rgba, uint32_t stride);
+        std::vector<Page> pages;
+        std::vector<Entry> entries;
+        std::vector<uint32_t> freeIds;
+        TextureCreationOptions opts;
+        uint32_t pageWidth, pageHeight, padding;
+        uint32_t version = 0;
+    };
+}
+
+#endif
@@ -14,7 +14,10 @@
 #ifndef __YR_BITS_HPP__
 #define __YR_BITS_HPP__
 
+#include "yr_simd.hpp"
+
 #include <cstdint>
+#include <cmath>
 
 constexpr int SIZEOF_FLOAT = sizeof(float);
 constexpr int SIZEOF_INT32 = sizeof(int32_t);
@@ -90,6 +93,276 @@ namespace onart {
         return regInt64(f) ^ ZERO_EXP64;
     }
 
+    /// @brief float를 IEEE 754 반정밀도(half)로 바꿉니다. 가장 가까운 짝수로 반올림하며, 범위를 넘는 값은 무한대, NaN은 NaN이 됩니다.
+    inline uint16_t floatToHalf(float f){
+        constexpr uint32_t F32_INF = 255u << 23;
+        constexpr uint32_t F16_MAX = (127u + 16) << 23; // 이 이상은 반정밀도에서 무한대
+        constexpr uint32_t DENORM_MAGIC = ((127u - 15) + (23 - 10) + 1) << 23;
+        uint32_t u = (uint32_t)regInt32(f);
+        const uint32_t sign = u & 0x80000000u;
+        u ^= sign;
+        uint32_t o;
+        if (u >= F16_MAX) { o = u > F32_INF ? 0x7e00 : 0x7c00; }
+        else if (u < (113u << 23)) { // 결과가 비정규수
+            o = (uint32_t)regInt32(regFloat32((int32_t)u) + regFloat32((int32_t)DENORM_MAGIC)) - DENORM_MAGIC;
+        }
+        else {
+            const uint32_t mantOdd = (u >> 13) & 1;
+            u += (uint32_t)(15 - 127) << 23;
+            u += 0xfff + mantOdd;
+            o = u >> 13;
+        }
+        return (uint16_t)(o | (sign >> 16));
+    }
+
+    /// @brief IEEE 754 반정밀도(half)를 float로 바꿉니다. 손실이 없습니다.
+    inline float halfToFloat(uint16_t h){
+        constexpr uint32_t SHIFTED_EXP = 0x7c00u << 13;
+        uint32_t o = ((uint32_t)h & 0x7fff) << 13;
+        const uint32_t exp = SHIFTED_EXP & o;
+        o += (127u - 15) << 23;
+        if (exp == SHIFTED_EXP) { o += (128u - 16) << 23; } // 무한대/NaN
+        else if (exp == 0) { // 비정규수
+            o += 1u << 23;
+            o = (uint32_t)regInt32(regFloat32((int32_t)o) - regFloat32(113 << 23));
+        }
+        return regFloat32((int32_t)(o | (((uint32_t)h & 0x8000) << 16)));
+    }
+
+    /// @brief [-1, 1] 구간의 float를 snorm16으로 바꿉니다. 구간 밖의 값은 잘라냅니다.
+    inline int16_t floatToSnorm16(float f){ return (int16_t)std::lrint((f < -1.0f ? -1.0f : (f > 1.0f ? 1.0f : f)) * 32767.0f); }
+    /// @brief snorm16을 [-1, 1] 구간의 float로 바꿉니다. -32768은 -1이 됩니다.
+    inline float snorm16ToFloat(int16_t i){ const float f = (float)i * (1.0f / 32767.0f); return f < -1.0f ? -1.0f : f; }
+    /// @brief [0, 1] 구간의 float를 unorm8로 바꿉니다. 구간 밖의 값은 잘라냅니다.
+    inline uint8_t floatToUnorm8(float f){ return (uint8_t)std::lrint((f < 0.0f ? 0.0f : (f > 1.0f ? 1.0f : f)) * 255.0f); }
+    /// @brief unorm8을 [0, 1] 구간의 float로 바꿉니다.
+    inline float unorm8ToFloat(uint8_t i){ return (float)i * (1.0f / 255.0f); }
+
+    /// @brief 단위 법선 벡터를 팔면체(octahedral) 매핑으로 snorm16 2개에 담습니다. 디코딩 후 각도 오차는 약 0.04도 이내입니다.
+    /// @param n 법선 벡터 (x, y, z). 영벡터는 안 됩니다. 길이가 1이 아니어도 방향만 담습니다.
+    /// @param out 인코딩 결과 2개를 받을 배열
+    inline void octEncode(const float* n, int16_t* out){
+        const float inv = 1.0f / ((std::abs(n[0]) + std::abs(n[1])) + std::abs(n[2]));
+        float x = n[0] * inv, y = n[1] * inv;
+        if (n[2] < 0) {
+            const float fx = (1.0f - std::abs(y)) * std::copysign(1.0f, x);
+            y = (1.0f - std::abs(x)) * std::copysign(1.0f, y);
+            x = fx;
+        }
+        out[0] = floatToSnorm16(x);
+        out[1] = floatToSnorm16(y);
+    }
+
+    /// @brief octEncode로 인코딩한 법선을 단위 벡터로 복원합니다.
+    /// @param in 인코딩된 값 2개
+    /// @param n 법선 벡터 (x, y, z)를 받을 배열
+    inline void octDecode(const int16_t* in, float* n){
+        float x = snorm16ToFloat(in[0]), y = snorm16ToFloat(in[1]);
+        const float z = (1.0f - std::abs(x)) - std::abs(y);
+        const float t = z < 0 ? -z : 0.0f;
+        x -= std::copysign(t, x);
+        y -= std::copysign(t, y);
+        const float inv = 1.0f / std::sqrt((x * x + y * y) + z * z);
+        n[0] = x * inv; n[1] = y * inv; n[2] = z * inv;
+    }
+
+#ifdef YR_USING_SIMD
+    /// @brief floatToHalf의 4레인 구현입니다. 결과는 32비트 레인의 하위 16비트에 (부호 확장되어) 들어갑니다.
+    inline __m128i floatToHalf4(__m128 f){
+        const __m128i f16Max = _mm_set1_epi32((127 + 16) << 23);
+        const __m128i subnormMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+        const __m128 justSign = _mm_and_ps(f, _mm_set1_ps(-0.0f));
+        const __m128 absf = _mm_xor_ps(f, justSign);
+        const __m128i absi = _mm_castps_si128(absf);
+        const __m128i isNan = _mm_cmpgt_epi32(absi, _mm_set1_epi32(255 << 23));
+        const __m128i isRegular = _mm_cmpgt_epi32(f16Max, absi);
+        const __m128i infOrNan = _mm_or_si128(_mm_and_si128(isNan, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7c00));
+        const __m128i isSub = _mm_cmpgt_epi32(_mm_set1_epi32(113 << 23), absi);
+        const __m128i subnorm = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absf, _mm_castsi128_ps(subnormMagic))), subnormMagic);
+        const __m128i mantOdd = _mm_srai_epi32(_mm_slli_epi32(absi, 31 - 13), 31); // 가수 최하위 비트가 홀수면 -1
+        const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absi, _mm_set1_epi32(0xfff - ((127 - 15) << 23))), mantOdd), 13);
+        const __m128i nonSpecial = _mm_or_si128(_mm_and_si128(isSub, subnorm), _mm_andnot_si128(isSub, normal));
+        const __m128i joined = _mm_or_si128(_mm_and_si128(isRegular, nonSpecial), _mm_andnot_si128(isRegular, infOrNan));
+        return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(justSign), 16));
+    }
+
+    /// @brief halfToFloat의 4레인 구현입니다. 입력은 32비트 레인의 하위 16비트에 0 확장되어 있어야 합니다.
+    inline __m128 halfToFloat4(__m128i h){
+        const __m128i expMant = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+        const __m128i justSign = _mm_xor_si128(h, expMant);
+        const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expMant, 13)), _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+        const __m128 infNanExp = _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(expMant, _mm_set1_epi32(0x7bff))), _mm_castsi128_ps(_mm_set1_epi32(255 << 23)));
+        return _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(_mm_slli_epi32(justSign, 16)), infNanExp));
+    }
+#endif
+
+    /// @brief float 배열을 반정밀도 배열로 바꿉니다. 결과는 floatToHalf와 같습니다.
+    /// @param in 입력 배열
+    /// @param out 결과를 받을 배열
+    /// @param count 원소 수
+    inline void floatToHalfAll(const float* in, uint16_t* out, size_t count){
+        size_t i = 0;
+#ifdef YR_USING_SIMD
+        const size_t end = count - count % 8;
+        for (; i < end; i += 8) {
+            _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(floatToHalf4(_mm_loadu_ps(in + i)), floatToHalf4(_mm_loadu_ps(in + i + 4))));
+        }
+#endif
+        for (; i < count; i++) { out[i] = floatToHalf(in[i]); }
+    }
+
+    /// @brief 반정밀도 배열을 float 배열로 바꿉니다.
+    /// @param in 입력 배열
+    /// @param out 결과를 받을 배열
+    /// @param count 원소 수
+    inline void halfToFloatAll(const uint16_t* in, float* out, size_t count){
+        size_t i = 0;
+#ifdef YR_USING_SIMD
+        const __m128i zero = _mm_setzero_si128();
+        const size_t end = count - count % 8;
+        for (; i < end; i += 8) {
+            const __m128i h = _mm_loadu_si128((const __m128i*)(in + i));
+            _mm_storeu_ps(out + i, halfToFloat4(_mm_unpacklo_epi16(h, zero)));
+            _mm_storeu_ps(out + i + 4, halfToFloat4(_mm_unpackhi_epi16(h, zero)));
+        }
+#endif
+        for (; i < count; i++) { out[i] = halfToFloat(in[i]); }
+    }
+
+    /// @brief float 배열을 snorm16 배열로 바꿉니다. 결과는 floatToSnorm16과 같습니다.
+    /// @param in 입력 배열
+    /// @param out 결과를 받을 배열
+    /// @param count 원소 수
+    inline void floatToSnorm16All(const float* in, int16_t* out, size_t count){
+        size_t i = 0;
+#ifdef YR_USING_SIMD
+        const __m128 lo = _mm_set1_ps(-1.0f), hi = _mm_set1_ps(1.0f), scale = _mm_set1_ps(32767.0f);
+        const size_t end = count - count % 8;
+        for (; i < end; i += 8) {
+            const __m128i a = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i), lo), hi), scale));
+            const __m128i b = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i + 4), lo), hi), scale));
+            _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(a, b));
+        }
+#endif
+        for (; i < count; i++) { out[i] = floatToSnorm16(in[i]); }
+    }
+
+    /// @brief snorm16 배열을 float 배열로 바꿉니다. 결과는 snorm16ToFloat와 같습니다.
+    /// @param in 입력 배열
+    /// @param out 결과를 받을 배열
+    /// @param count 원소 수
+    inline void snorm16ToFloatAll(const int16_t* in, float* out, size_t count){
+        size_t i = 0;
+#ifdef YR_USING_SIMD
+        const __m128 lo = _mm_set1_ps(-1.0f), scale = _mm_set1_ps(1.0f / 32767.0f);
+        const size_t end = count - count % 8;
+        for (; i < end; i += 8) {
+            const __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+            _mm_storeu_ps(out + i, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)), scale), lo));
+            _mm_storeu_ps(out + i + 4, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)), scale), lo));
+        }
+#endif
+        for (; i < count; i++) { out[i] = snorm16ToFloat(in[i]); }
+    }
+
+    /// @brief float 배열을 unorm8 배열로 바꿉니다. 결과는 floatToUnorm8과 같습니다.
+    /// @param in 입력 배열
+    /// @param out 결과를 받을 배열
+    /// @param count 원소 수
+    inline void floatToUnorm8All(const float* in, uint8_t* out, size_t count){
+        size_t i = 0;
+#ifdef YR_USING_SIMD
+        const __m128 lo = _mm_setzero_ps(), hi = _mm_set1_ps(1.0f), scale = _mm_set1_ps(255.0f);
+        const size_t end = count - count % 16;
+        for (; i < end; i += 16) {
+            __m128i q[4];
+            for (int k = 0; k < 4; k++) { q[k] = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i + 4 * k), lo), hi), scale)); }
+            _mm_storeu_si128((__m128i*)(out + i), _mm_packus_epi16(_mm_packs_epi32(q[0], q[1]), _mm_packs_epi32(q[2], q[3])));
+        }
+#endif
+        for (; i < count; i++) { out[i] = floatToUnorm8(in[i]); }
+    }
+
+    /// @brief unorm8 배열을 float 배열로 바꿉니다. 결과는 unorm8ToFloat와 같습니다.
+    /// @param in 입력 배열
+    /// @param out 결과를 받을 배열
+    /// @param count 원소 수
+    inline void unorm8ToFloatAll(const uint8_t* in, float* out, size_t count){
+        size_t i = 0;
+#ifdef YR_USING_SIMD
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+        const size_t end = count - count % 16;
+        for (; i < end; i += 16) {
+            const __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+            const __m128i w[2] = { _mm_unpacklo_epi8(v, zero), _mm_unpackhi_epi8(v, zero) };
+            for (int k = 0; k < 2; k++) {
+                _mm_storeu_ps(out + i + 8 * k, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(w[k], zero)), scale));
+                _mm_storeu_ps(out + i + 8 * k + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(w[k], zero)), scale));
+            }
+        }
+#endif
+        for (; i < count; i++) { out[i] = unorm8ToFloat(in[i]); }
+    }
+
+    /// @brief 법선 배열을 팔면체 매핑으로 인코딩합니다. 결과는 octEncode와 같습니다.
+    /// @param normals 법선 배열 (x, y, z가 빈틈없이 이어진 배열)
+    /// @param out 결과를 받을 배열 (법선당 2개)
+    /// @param count 법선 수
+    inline void octEncodeAll(const float* normals, int16_t* out, size_t count){
+        size_t i = 0;
+#ifdef YR_USING_SIMD
+        const __m128 signMask = _mm_set1_ps(-0.0f), one = _mm_set1_ps(1.0f), lo = _mm_set1_ps(-1.0f), scale = _mm_set1_ps(32767.0f);
+        const size_t end = count - count % 4;
+        for (; i < end; i += 4) {
+            const float* n = normals + 3 * i;
+            const __m128 x = _mm_setr_ps(n[0], n[3], n[6], n[9]), y = _mm_setr_ps(n[1], n[4], n[7], n[10]), z = _mm_setr_ps(n[2], n[5], n[8], n[11]);
+            const __m128 inv = _mm_div_ps(one, _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)), _mm_andnot_ps(signMask, z)));
+            const __m128 px = _mm_mul_ps(x, inv), py = _mm_mul_ps(y, inv);
+            // z < 0인 반구는 바깥 삼각형으로 접음
+            const __m128 fx = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, py)), _mm_or_ps(_mm_and_ps(px, signMask), one));
+            const __m128 fy = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, px)), _mm_or_ps(_mm_and_ps(py, signMask), one));
+            const __m128 lower = _mm_cmplt_ps(z, _mm_setzero_ps());
+            const __m128 ex = _mm_or_ps(_mm_and_ps(lower, fx), _mm_andnot_ps(lower, px));
+            const __m128 ey = _mm_or_ps(_mm_and_ps(lower, fy), _mm_andnot_ps(lower, py));
+            const __m128i ix = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(ex, lo), one), scale));
+            const __m128i iy = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(ey, lo), one), scale));
+            _mm_storeu_si128((__m128i*)(out + 2 * i), _mm_packs_epi32(_mm_unpacklo_epi32(ix, iy), _mm_unpackhi_epi32(ix, iy)));
+        }
+#endif
+        for (; i < count; i++) { octEncode(normals + 3 * i, out + 2 * i); }
+    }
+
+    /// @brief 팔면체 매핑으로 인코딩된 법선 배열을 단위 벡터 배열로 복원합니다. 결과는 octDecode와 같습니다.
+    /// @param in 인코딩된 배열 (법선당 2개)
+    /// @param normals 결과를 받을 배열 (x, y, z가 빈틈없이 이어진 배열)
+    /// @param count 법선 수
+    inline void octDecodeAll(const int16_t* in, float* normals, size_t count){
+        size_t i = 0;
+#ifdef YR_USING_SIMD
+        const __m128 signMask = _mm_set1_ps(-0.0f), one = _mm_set1_ps(1.0f), lo = _mm_set1_ps(-1.0f), scale = _mm_set1_ps(1.0f / 32767.0f);
+        const size_t end = count - count % 4;
+        for (; i < end; i += 4) {
+            const __m128i v = _mm_loadu_si128((const __m128i*)(in + 2 * i));
+            const __m128 a = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)), scale), lo);
+            const __m128 b = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)), scale), lo);
+            __m128 x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            const __m128 z = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, x)), _mm_andnot_ps(signMask, y));
+            const __m128 t = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+            x = _mm_sub_ps(x, _mm_or_ps(_mm_and_ps(x, signMask), t));
+            y = _mm_sub_ps(y, _mm_or_ps(_mm_and_ps(y, signMask), t));
+            const __m128 inv = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z))));
+            alignas(16) float r[3][4];
+            _mm_store_ps(r[0], _mm_mul_ps(x, inv));
+            _mm_store_ps(r[1], _mm_mul_ps(y, inv));
+            _mm_store_ps(r[2], _mm_mul_ps(z, inv));
+            float* n = normals + 3 * i;
+            for (int k = 0; k < 4; k++) { n[3 * k] = r[0][k]; n[3 * k + 1] = r[1][k]; n[3 * k + 2] = r[2][k]; }
+        }
+#endif
+        for (; i < count; i++) { octDecode(in + 2 * i, normals + 3 * i); }
+    }
+
 }
 
 
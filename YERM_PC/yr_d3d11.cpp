@@ -79,6 +79,9 @@ namespace onart {
             reason = result;
             return;
         }
+        if (context->QueryInterface(__uuidof(ID3D11DeviceContext1), (void**)&context1) != S_OK) {
+            context1 = nullptr;
+        }
 
         D3D11_RASTERIZER_DESC rasterizerInfo{};
         rasterizerInfo.CullMode = D3D11_CULL_NONE;
@@ -352,6 +355,7 @@ namespace onart {
 
         context->ClearState();
         context->Flush();
+        if (context1) { context1->Release(); }
         context->Release();
         device->Release();
     }
@@ -1806,8 +1810,8 @@ namespace onart {
         return mat4();
     }
 
-    D3D11Machine::UniformBuffer::UniformBuffer(uint32_t length, ID3D11Buffer* ubo)
-        :length(length), ubo(ubo) {
+    D3D11Machine::UniformBuffer::UniformBuffer(uint32_t length, ID3D11Buffer* ubo, uint32_t individual)
+        :length(length), ubo(ubo), individual(individual) {
 
     }
 
@@ -1823,14 +1827,16 @@ namespace onart {
     }
 
     void D3D11Machine::UniformBuffer::update(const void* input, uint32_t index, uint32_t offset, uint32_t size) {
-        if (offset + size > length) {
+        uint64_t begin = (uint64_t)individual * index + offset;
+        if (begin + size > length) {
             LOGWITH("Requested buffer update range is invalid");
             return;
         }
+        D3D11_MAP mapType = (individual && begin == 0) ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
         D3D11_MAPPED_SUBRESOURCE mappedResource;
-        if (singleton->context->Map(ubo, 0, D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mappedResource) == S_OK)
+        if (singleton->context->Map(ubo, 0, mapType, 0, &mappedResource) == S_OK)
         {
-            std::memcpy((uint8_t*)mappedResource.pData + offset, input, size);
+            std::memcpy((uint8_t*)mappedResource.pData + begin, input, size);
             singleton->context->Unmap(ubo, 0);
         }
         else {
@@ -1841,9 +1847,20 @@ namespace onart {
 
     D3D11Machine::pUniformBuffer D3D11Machine::createUniformBuffer(int32_t key, const UniformBufferCreationOptions& opts) {
         if (auto ret = getUniformBuffer(key)) { return ret; }
+        uint32_t individual = 0;
+        size_t length = opts.size;
+        if (opts.count > 1) {
+            if (!singleton->context1) {
+                LOGWITH("Dynamic uniform buffer requires D3D 11.1 runtime");
+                return {};
+            }
+            // 상수 버퍼 일부 바인드 단위는 상수 16개(256바이트)
+            individual = (uint32_t)((opts.size + 255) & ~(size_t)255);
+            length = (size_t)individual * opts.count;
+        }
         ID3D11Buffer* buffer{};
         D3D11_BUFFER_DESC bufferInfo{};
-        bufferInfo.ByteWidth = opts.size;
+        bufferInfo.ByteWidth = (UINT)length;
         bufferInfo.Usage = D3D11_USAGE_DYNAMIC;
         bufferInfo.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
         bufferInfo.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
@@ -1854,7 +1871,7 @@ namespace onart {
             return {};
         }
 
-        pUniformBuffer ret = std::make_shared<shp_t<UniformBuffer>>(opts.size, buffer);
+        pUniformBuffer ret = std::make_shared<shp_t<UniformBuffer>>(length, buffer, individual);
         if (key == INT32_MIN) return ret;
         return singleton->uniformBuffers[key] = std::move(ret);
     }
@@ -2054,13 +2071,21 @@ namespace onart {
     }
 
     void D3D11Machine::RenderPass::bind(uint32_t pos, UniformBuffer* ub, uint32_t ubPos) {
-        if (ubPos == 13) {
+        if (pos == 13) {
             LOGWITH("Invalid call: bind pos 13 is reserved for push()");
             return;
         }
         if (currentPass >= 0) {
-            singleton->context->VSSetConstantBuffers(pos, 1, &ub->ubo);
-            singleton->context->PSSetConstantBuffers(pos, 1, &ub->ubo); // �ӽ�
+            if (ub->individual) {
+                UINT first = ub->individual / 16 * ubPos;
+                UINT count = ub->individual / 16;
+                singleton->context1->VSSetConstantBuffers1(pos, 1, &ub->ubo, &first, &count);
+                singleton->context1->PSSetConstantBuffers1(pos, 1, &ub->ubo, &first, &count);
+            }
+            else {
+                singleton->context->VSSetConstantBuffers(pos, 1, &ub->ubo);
+                singleton->context->PSSetConstantBuffers(pos, 1, &ub->ubo); // �ӽ�
+            }
         }
         else {
             LOGWITH("No subpass is running");
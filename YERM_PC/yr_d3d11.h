@@ -19,7 +19,7 @@
 #include "yr_math.hpp"
 #include "yr_threadpool.hpp"
 #include "yr_graphics_param.h"
-#include <d3d11.h>
+#include <d3d11_1.h>
 
 #include <type_traits>
 #include <vector>
@@ -299,6 +299,7 @@ namespace onart {
         static uint64_t currentRenderPass;
         ID3D11Device* device{};
         ID3D11DeviceContext* context{};
+        ID3D11DeviceContext1* context1{}; // 상수 버퍼 일부 바인드용 (D3D 11.1 미지원 환경에서는 nullptr)
         class WindowSystem;
         std::map<int32_t, WindowSystem*> windowSystems;
         int vsync = 1;
@@ -636,21 +637,25 @@ namespace onart {
         /// @brief 아무 동작도 하지 않습니다.
         void resize(uint32_t size);
         /// @brief 유니폼 버퍼의 내용을 갱신합니다. 넘치게 데이터를 줘도 추가 할당은 하지 않으므로 주의하세요.
+        /// 동적 유니폼 버퍼의 0번 항목 처음부터 쓰는 경우 기존 내용은 버려지므로 프레임마다 전체를 한 번에 갱신하는 용도로 사용하세요.
         /// @param input 입력 데이터
-        /// @param index 사용되지 않습니다.
-        /// @param offset 데이터 내에서 몇 바이트째부터 수정할지
-        /// @param size 덮어쓸 양
+        /// @param index 동적 유니폼 버퍼인 경우 갱신할 항목 번호입니다. 동적 유니폼 버퍼가 아니면 사용되지 않습니다.
+        /// @param offset 데이터 내에서 몇 바이트째부터 수정할지 (index번째 항목의 시작 기준)
+        /// @param size 덮어쓸 양. 여러 항목에 걸쳐도 됩니다.
         void update(const void* input, uint32_t index, uint32_t offset, uint32_t size);
+        /// @brief 동적 유니폼 버퍼의 항목 간격(바이트)을 리턴합니다. 동적 유니폼 버퍼가 아니면 0을 리턴합니다.
+        inline uint32_t getStride() const { return individual; }
         /// @brief 0을 리턴합니다.
         inline static uint16_t getIndex() { return 0; }
         /// @brief 0을 리턴합니다.
         inline static int getLayout() { return 0; }
     protected:
-        UniformBuffer(uint32_t length, ID3D11Buffer* ubo);
+        UniformBuffer(uint32_t length, ID3D11Buffer* ubo, uint32_t individual = 0);
         ~UniformBuffer();
     private:
         ID3D11Buffer* ubo;
         uint32_t length;
+        uint32_t individual; // 동적 유니폼 버퍼 항목 간격 (동적이 아니면 0)
     };
 
     class D3D11Machine::Mesh {
@@ -0,0 +1,251 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "yr_debugdraw.h"
+
+#ifdef YR_HAS_DEBUG_DRAW
+#include "yr_text.h"
+#include "yr_scene.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace onart {
+
+    /// @brief 비트 0, 1, 2가 각각 x, y, z의 최대 쪽을 나타내는 꼭짓점 8개로 이루어진 육면체의 모서리 12개를 추가합니다.
+    static void appendBoxEdges(std::vector<float>& points, const vec3 (&corners)[8]) {
+        static const uint8_t EDGES[12][2] = {
+            {0, 1}, {2, 3}, {4, 5}, {6, 7},
+            {0, 2}, {1, 3}, {4, 6}, {5, 7},
+            {0, 4}, {1, 5}, {2, 6}, {3, 7}
+        };
+        for (const auto& e : EDGES) {
+            const vec3& a = corners[e[0]];
+            const vec3& b = corners[e[1]];
+            const float p[6] = { a[0], a[1], a[2], b[0], b[1], b[2] };
+            points.insert(points.end(), p, p + 6);
+        }
+    }
+
+    DebugDraw::DebugDraw() {
+        inverseViewProjection = viewProjection.inverse();
+    }
+
+    void DebugDraw::setViewProjection(const mat4& viewProjection, bool zeroToOneDepth) {
+        this->viewProjection = viewProjection;
+        inverseViewProjection = viewProjection.inverse();
+        this->zeroToOneDepth = zeroToOneDepth;
+    }
+
+    void DebugDraw::setFont(Font* font) {
+        this->font = font;
+        if (font && !labelBatch) { labelBatch.reset(new SpriteBatch(256, get2DTextPipeline())); }
+    }
+
+    std::vector<float>& DebugDraw::bucketOf(const vec4& color) {
+        // 같은 색을 연달아 추가하는 경우가 대부분이므로 직전 버킷을 먼저 봅니다.
+        if (lastBucket < buckets.size() && buckets[lastBucket].color == color) return buckets[lastBucket].points;
+        for (size_t i = 0; i < buckets.size(); i++) {
+            if (buckets[i].color == color) {
+                lastBucket = i;
+                return buckets[i].points;
+            }
+        }
+        lastBucket = buckets.size();
+        buckets.push_back({ color, {} });
+        return buckets.back().points;
+    }
+
+    void DebugDraw::addLine(const vec3& a, const vec3& b, const vec4& color) {
+        const float p[6] = { a[0], a[1], a[2], b[0], b[1], b[2] };
+        std::vector<float>& points = bucketOf(color);
+        points.insert(points.end(), p, p + 6);
+    }
+
+    void DebugDraw::addBox(const AABB& box, const vec4& color, const mat4& transform) {
+        vec3 corners[8];
+        for (int i = 0; i < 8; i++) {
+            const vec4 c(i & 1 ? box.max[0] : box.min[0], i & 2 ? box.max[1] : box.min[1], i & 4 ? box.max[2] : box.min[2], 1);
+            corners[i] = (transform * c).xyz();
+        }
+        appendBoxEdges(bucketOf(color), corners);
+    }
+
+    void DebugDraw::addSphere(const Sphere& sphere, const vec4& color, uint32_t segments) {
+        if (segments < 3) segments = 3;
+        std::vector<float>& points = bucketOf(color);
+        points.reserve(points.size() + (size_t)segments * 18);
+        const float step = 6.2831853f / segments;
+        const float r = sphere.radius;
+        const vec3& c = sphere.center;
+        float c0 = r, s0 = 0;
+        for (uint32_t i = 1; i <= segments; i++) {
+            const float c1 = r * std::cos(step * i), s1 = r * std::sin(step * i);
+            const float p[18] = {
+                c[0] + c0, c[1] + s0, c[2], c[0] + c1, c[1] + s1, c[2],
+                c[0], c[1] + c0, c[2] + s0, c[0], c[1] + c1, c[2] + s1,
+                c[0] + s0, c[1], c[2] + c0, c[0] + s1, c[1], c[2] + c1
+            };
+            points.insert(points.end(), p, p + 18);
+            c0 = c1; s0 = s1;
+        }
+    }
+
+    void DebugDraw::addFrustum(const mat4& viewProjection, const vec4& color, bool zeroToOneDepth) {
+        const mat4 inv = viewProjection.inverse();
+        const float nearZ = zeroToOneDepth ? 0.0f : -1.0f;
+        vec3 corners[8];
+        for (int i = 0; i < 8; i++) {
+            const vec4 c = inv * vec4(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : nearZ, 1);
+            corners[i] = c.xyz() / c[3];
+        }
+        appendBoxEdges(bucketOf(color), corners);
+    }
+
+    void DebugDraw::addText(const vec3& position, const char* utf8, const vec4& color, float pixelHeight) {
+        if (!font || !utf8) return;
+        const size_t length = std::strlen(utf8);
+        labels.push_back({ position, color, pixelHeight, (uint32_t)labelText.size() });
+        labelText.insert(labelText.end(), utf8, utf8 + length + 1);
+    }
+
+    void DebugDraw::clear() {
+        // 버킷의 용량은 다음 프레임에 재사용합니다.
+        for (Bucket& b : buckets) { b.points.clear(); }
+        labels.clear();
+        labelText.clear();
+    }
+
+    size_t DebugDraw::lineCount() const {
+        size_t count = 0;
+        for (const Bucket& b : buckets) { count += b.points.size() / 6; }
+        return count;
+    }
+
+    uint32_t DebugDraw::expand(const std::vector<float>& points, float* vertices, uint32_t* indices, uint32_t firstLine) const {
+        const float* m = &viewProjection[0];
+        const float hx = viewport[0] * 0.5f, hy = viewport[1] * 0.5f;
+        const float invHx = 1.0f / hx, invHy = 1.0f / hy;
+        const float halfWidth = lineWidth * 0.5f;
+        const float nearW = zeroToOneDepth ? 0.0f : 1.0f; // 가까운 평면: z + nearW * w >= 0
+        const size_t count = points.size() / 6;
+        uint32_t written = 0;
+        for (size_t i = 0; i < count; i++) {
+            const float* p = &points[i * 6];
+            float a[4], b[4];
+            for (int r = 0; r < 4; r++) {
+                a[r] = m[r * 4] * p[0] + m[r * 4 + 1] * p[1] + m[r * 4 + 2] * p[2] + m[r * 4 + 3];
+                b[r] = m[r * 4] * p[3] + m[r * 4 + 1] * p[4] + m[r * 4 + 2] * p[5] + m[r * 4 + 3];
+            }
+            const float da = a[2] + nearW * a[3], db = b[2] + nearW * b[3];
+            if (da < 0 && db < 0) continue;
+            if (da < 0) {
+                const float t = da / (da - db);
+                for (int r = 0; r < 4; r++) { a[r] += (b[r] - a[r]) * t; }
+            }
+            else if (db < 0) {
+                const float t = db / (db - da);
+                for (int r = 0; r < 4; r++) { b[r] += (a[r] - b[r]) * t; }
+            }
+            if (a[3] <= 1e-6f || b[3] <= 1e-6f) continue;
+            // 화면 픽셀 단위로 선의 법선을 구해 두께가 화면 비율에 관계 없이 일정하게 합니다.
+            const float ax = a[0] / a[3] * hx, ay = a[1] / a[3] * hy;
+            const float bx = b[0] / b[3] * hx, by = b[1] / b[3] * hy;
+            const float dx = bx - ax, dy = by - ay;
+            const float len2 = dx * dx + dy * dy;
+            float nx = 0, ny = halfWidth;
+            if (len2 > 1e-12f) {
+                const float s = halfWidth / std::sqrt(len2);
+                nx = -dy * s; ny = dx * s;
+            }
+            float* v = vertices + (size_t)written * 16;
+            v[0] = (ax + nx) * invHx; v[1] = (ay + ny) * invHy; v[2] = 0.5f; v[3] = 0.5f;
+            v[4] = (ax - nx) * invHx; v[5] = (ay - ny) * invHy; v[6] = 0.5f; v[7] = 0.5f;
+            v[8] = (bx + nx) * invHx; v[9] = (by + ny) * invHy; v[10] = 0.5f; v[11] = 0.5f;
+            v[12] = (bx - nx) * invHx; v[13] = (by - ny) * invHy; v[14] = 0.5f; v[15] = 0.5f;
+            const uint32_t base = (firstLine + written) * 4;
+            uint32_t* idx = indices + (size_t)written * 6;
+            idx[0] = base; idx[1] = base + 1; idx[2] = base + 2;
+            idx[3] = base + 2; idx[4] = base + 1; idx[5] = base + 3;
+            written++;
+        }
+        return written;
+    }
+
+    template<class RP>
+    void DebugDraw::drawTo(RP* target) {
+        lastDrawCount = 0;
+        if (!COMPILED || !enabled) return;
+        const size_t total = lineCount();
+        if (total > 0) {
+            // 최대 크기로 한 번에 할당하고, 잘려 나간 선만큼은 비워 둡니다.
+            YRGraphics::StreamGeometry geometry = YRGraphics::allocateStreamGeometry((uint32_t)total * 4, sizeof(_2dvertex_t), (uint32_t)total * 6, 4);
+            if (geometry) {
+                float* vertices = (float*)geometry.vertices;
+                uint32_t* indices = (uint32_t*)geometry.indices;
+                target->usePipeline(get2DDefaultPipeline().get(), 0);
+                target->bind(_2D_TEXTURE_BIND_INDEX, get2DWhiteTexture());
+                // 정점은 이미 정규 장치 좌표이므로 셰이더에서 곱해지는 카메라 행렬을 역행렬로 상쇄합니다.
+                _2dpush_t push;
+                push.model = inverseViewProjection;
+                push.texrect = vec4(1, 1, 0, 0);
+                push.color = vec4(1);
+                target->push(&push, 0, sizeof(push));
+                uint32_t written = 0;
+                for (const Bucket& bucket : buckets) {
+                    if (bucket.points.empty()) continue;
+                    const uint32_t lines = expand(bucket.points, vertices + (size_t)written * 16, indices + (size_t)written * 6, written);
+                    if (lines == 0) continue;
+                    push.color = bucket.color;
+                    target->push(&push.color, offsetof(_2dpush_t, color), offsetof(_2dpush_t, color) + sizeof(vec4));
+                    target->invoke(geometry, written * 6, lines * 6);
+                    written += lines;
+                    lastDrawCount++;
+                }
+            }
+        }
+        if (font && labelBatch && !labels.empty()) {
+            // 글자는 위치만 투영하고, 정규 장치 좌표에서 px 단위로 배치한 뒤 역시 카메라 행렬을 상쇄합니다.
+            constexpr float FLIP = YRGraphics::VULKAN_GRAPHICS ? 1.0f : -1.0f;
+            const mat4 pixelToNdc = mat4::scale(2.0f / viewport[0], FLIP * 2.0f / viewport[1], 1);
+            labelBatch->clear();
+            for (const Label& label : labels) {
+                const vec4 clip = viewProjection * vec4(label.position[0], label.position[1], label.position[2], 1);
+                if (clip[3] <= 1e-6f || clip[2] + (zeroToOneDepth ? 0.0f : clip[3]) < 0) continue;
+                const mat4 transform = inverseViewProjection * mat4::translate(clip[0] / clip[3], clip[1] / clip[3], 0.5f) * pixelToNdc;
+                drawText(*labelBatch, *font, &labelText[label.offset], transform, label.pixelHeight, label.color);
+            }
+            labelBatch->draw(target);
+            lastDrawCount += labelBatch->drawCount();
+        }
+        clear();
+    }
+
+    void DebugDraw::draw(YRGraphics::RenderPass* target) { drawTo(target); }
+#ifdef YR_USE_VULKAN
+    void DebugDraw::draw(YRGraphics::RenderPass2Screen* target) { drawTo(target); }
+#endif
+
+    DebugDraw* addDebugDraw(Scene& scene, VisualElementHandle* handle) {
+        VisualElementHandle h = scene.insert();
+        VisualElement* elem = scene.get(h);
+        DebugDraw* debugDraw = new DebugDraw;
+        elem->fr.reset(debugDraw);
+        elem->pipeline = get2DDefaultPipeline();
+        elem->transparent = true;
+        if (handle) { *handle = h; }
+        return debugDraw;
+    }
+}
+
+#endif // YR_HAS_DEBUG_DRAW
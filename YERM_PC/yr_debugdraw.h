@@ -0,0 +1,120 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef __YR_DEBUGDRAW_H__
+#define __YR_DEBUGDRAW_H__
+
+#include "yr_2d.h"
+#include "yr_geometry.hpp"
+
+// 스트리밍 버퍼(YRGraphics::allocateStreamGeometry)가 있는 Vulkan, OpenGL에서만 사용할 수 있습니다.
+#ifdef YR_HAS_STREAM_GEOMETRY
+#define YR_HAS_DEBUG_DRAW
+
+#include <memory>
+
+namespace onart {
+
+    class Font;
+
+    /// @brief 선, 상자, 구, 절두체, 글자 표시를 매 프레임 모아 그리는 즉시 모드 디버그 그리기입니다. 컬링 범위나 프로파일링 표시를 확인하는 데 사용합니다.
+    /// 선은 CPU에서 투영하여 화면 공간 두께의 사각형으로 펼친 뒤 스트리밍 버퍼(YRGraphics::allocateStreamGeometry) 하나에 담아, get2DDefaultPipeline()으로 색마다 드로우 1회로 그립니다.
+    /// 모은 도형은 그린 뒤 비워집니다. 꺼져 있으면 추가 함수는 분기 하나만 실행하며, YR_DISABLE_DEBUG_DRAW를 정의하면 컴파일 시점에 모두 제거됩니다.
+    /// 장면의 맨 뒤(가장 위)에 그려지도록 배치하세요.
+    class DebugDraw: public FreeRenderer {
+        public:
+#ifdef YR_DISABLE_DEBUG_DRAW
+            constexpr static bool COMPILED = false;
+#else
+            constexpr static bool COMPILED = true;
+#endif
+            DebugDraw();
+            /// @brief 켜거나 끕니다. 끄면 모아 둔 도형을 비웁니다.
+            inline void setEnabled(bool enabled) { this->enabled = enabled; if (!enabled) { clear(); } }
+            inline bool isEnabled() const { return COMPILED && enabled; }
+            /// @brief 이 요소를 그리는 장면의 카메라 뷰-투사 행렬을 설정합니다. 도형은 이 행렬로 투영되며, 셰이더에서 곱해지는 같은 행렬은 푸시 상수의 역행렬로 상쇄됩니다.
+            /// @param zeroToOneDepth 정규 장치 좌표의 z 범위가 [0, 1]이면 참, [-1, 1]이면 거짓. 가까운 평면 뒤쪽의 선을 자르는 데 사용합니다.
+            void setViewProjection(const mat4& viewProjection, bool zeroToOneDepth = true);
+            /// @brief 그리는 대상의 크기(px)를 설정합니다. 선 두께와 글자 크기에 사용합니다.
+            inline void setViewport(float width, float height) { viewport = vec2(width, height); }
+            /// @brief 선 두께(px)를 설정합니다.
+            inline void setLineWidth(float width) { lineWidth = width; }
+            /// @brief 글자 표시에 사용할 글꼴을 설정합니다. 주어지지 않으면 글자 표시는 무시됩니다.
+            void setFont(Font* font);
+            inline void line(const vec3& a, const vec3& b, const vec4& color) { if (COMPILED && enabled) { addLine(a, b, color); } }
+            /// @brief 상자의 모서리 12개를 그립니다.
+            /// @param transform 상자에 적용할 변환. 회전된 상자(OBB)는 지역 공간 상자와 변환으로 그릴 수 있습니다.
+            inline void box(const AABB& box, const vec4& color, const mat4& transform = mat4()) { if (COMPILED && enabled) { addBox(box, color, transform); } }
+            /// @brief 구를 세 축에 수직인 원 3개로 그립니다.
+            /// @param segments 원 1개의 선분 수
+            inline void sphere(const Sphere& sphere, const vec4& color, uint32_t segments = 16) { if (COMPILED && enabled) { addSphere(sphere, color, segments); } }
+            /// @brief 주어진 뷰-투사 행렬의 절두체 모서리 12개를 그립니다.
+            inline void frustum(const mat4& viewProjection, const vec4& color, bool zeroToOneDepth = true) { if (COMPILED && enabled) { addFrustum(viewProjection, color, zeroToOneDepth); } }
+            /// @brief 주어진 위치에 글자를 표시합니다. 글자 크기는 거리와 관계 없이 일정합니다.
+            /// @param pixelHeight 글자 크기(px)
+            inline void text(const vec3& position, const char* utf8, const vec4& color = vec4(1), float pixelHeight = 16) { if (COMPILED && enabled) { addText(position, utf8, color, pixelHeight); } }
+            /// @brief 모아 둔 도형을 비웁니다.
+            void clear();
+            /// @brief 모아 둔 선 수를 리턴합니다.
+            size_t lineCount() const;
+            /// @brief 직전에 그릴 때 사용한 드로우 호출 수를 리턴합니다.
+            inline size_t drawCount() const { return lastDrawCount; }
+            void draw(YRGraphics::RenderPass*) override;
+#ifdef YR_USE_VULKAN
+            void draw(YRGraphics::RenderPass2Screen*) override;
+#endif
+        private:
+            template<class RP>
+            void drawTo(RP* target);
+            void addLine(const vec3& a, const vec3& b, const vec4& color);
+            void addBox(const AABB& box, const vec4& color, const mat4& transform);
+            void addSphere(const Sphere& sphere, const vec4& color, uint32_t segments);
+            void addFrustum(const mat4& viewProjection, const vec4& color, bool zeroToOneDepth);
+            void addText(const vec3& position, const char* utf8, const vec4& color, float pixelHeight);
+            /// @brief 주어진 색의 선 목록을 리턴합니다.
+            std::vector<float>& bucketOf(const vec4& color);
+            /// @brief 선 목록을 투영하여 사각형으로 펼칩니다. 가까운 평면 뒤쪽 부분은 자릅니다.
+            /// @return 기록한 선 수
+            uint32_t expand(const std::vector<float>& points, float* vertices, uint32_t* indices, uint32_t firstLine) const;
+            struct Bucket {
+                vec4 color;
+                std::vector<float> points; // 선 1개당 시작점, 끝점 xyz 6개
+            };
+            struct Label {
+                vec3 position;
+                vec4 color;
+                float pixelHeight;
+                uint32_t offset; // labelText 내 시작 위치
+            };
+            std::vector<Bucket> buckets;
+            std::vector<Label> labels;
+            std::vector<char> labelText;
+            std::unique_ptr<SpriteBatch> labelBatch;
+            Font* font = nullptr;
+            mat4 viewProjection, inverseViewProjection;
+            vec2 viewport = vec2(1280, 720);
+            float lineWidth = 1.5f;
+            size_t lastBucket = 0;
+            size_t lastDrawCount = 0;
+            bool zeroToOneDepth = true;
+            bool enabled = true;
+    };
+
+    /// @brief 장면에 DebugDraw를 그리는 요소를 추가하고 그것을 리턴합니다. 리턴된 포인터는 해당 요소가 제거될 때까지 유효합니다.
+    /// @param handle nullptr가 아니면 추가된 요소의 핸들을 여기에 저장합니다.
+    DebugDraw* addDebugDraw(class Scene& scene, VisualElementHandle* handle = nullptr);
+}
+
+#endif // YR_USE_VULKAN || YR_USE_OPENGL
+
+#endif
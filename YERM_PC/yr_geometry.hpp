@@ -0,0 +1,522 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef __YR_GEOMETRY_HPP__
+#define __YR_GEOMETRY_HPP__
+
+#include "yr_math.hpp"
+
+#include <algorithm>
+
+namespace onart {
+
+    /// @brief 축 정렬 경계 상자(AABB)입니다.
+    struct alignas(16) AABB: public align16 {
+        vec3 min; ///< 최소 꼭짓점
+        vec3 max; ///< 최대 꼭짓점
+        /// @brief 원점 하나로 이루어진 상자를 만듭니다.
+        inline AABB() = default;
+        /// @brief 두 꼭짓점으로 상자를 만듭니다. min의 모든 성분이 max 이하여야 합니다.
+        inline AABB(const vec3& min, const vec3& max): min(min), max(max) {}
+        /// @brief 중심과 각 축 방향 반 길이로 상자를 만듭니다.
+        inline static AABB fromCenterExtent(const vec3& center, const vec3& extent) { return AABB(center - extent, center + extent); }
+        /// @brief 주어진 점들을 모두 포함하는 가장 작은 상자를 만듭니다.
+        inline static AABB fromPoints(const vec3* points, size_t count) {
+            if (count == 0) return AABB();
+            AABB ret(points[0], points[0]);
+            for (size_t i = 1; i < count; i++) { ret.merge(points[i]); }
+            return ret;
+        }
+        /// @brief 상자의 중심을 리턴합니다.
+        inline vec3 center() const { return (min + max) * 0.5f; }
+        /// @brief 상자의 각 축 방향 반 길이를 리턴합니다.
+        inline vec3 extent() const { return (max - min) * 0.5f; }
+        /// @brief 점이 상자 안(경계 포함)에 있으면 참을 리턴합니다.
+        inline bool contains(const vec3& p) const { return (movemask(b_and(cmple(min.rg, p.rg), cmple(p.rg, max.rg))) & 0b111) == 0b111; }
+        /// @brief 점을 포함하도록 상자를 넓힙니다.
+        inline void merge(const vec3& p) { min = vec3(onart::min(min.rg, p.rg)); max = vec3(onart::max(max.rg, p.rg)); }
+        /// @brief 다른 상자를 포함하도록 상자를 넓힙니다.
+        inline void merge(const AABB& b) { min = vec3(onart::min(min.rg, b.min.rg)); max = vec3(onart::max(max.rg, b.max.rg)); }
+        /// @brief 아핀 변환을 적용한 상자를 포함하는 가장 작은 축 정렬 상자를 리턴합니다.
+        inline AABB transformed(const mat4& m) const {
+            const vec3 c = center(), e = extent();
+            vec3 nc, ne;
+            for (int i = 0; i < 3; i++) {
+                nc[i] = m[i * 4] * c[0] + m[i * 4 + 1] * c[1] + m[i * 4 + 2] * c[2] + m[i * 4 + 3];
+                ne[i] = std::abs(m[i * 4]) * e[0] + std::abs(m[i * 4 + 1]) * e[1] + std::abs(m[i * 4 + 2]) * e[2];
+            }
+            return fromCenterExtent(nc, ne);
+        }
+    };
+
+    /// @brief 경계 구입니다.
+    struct alignas(16) Sphere: public align16 {
+        vec3 center; ///< 중심
+        float radius = 0; ///< 반지름
+        inline Sphere() = default;
+        inline Sphere(const vec3& center, float radius): center(center), radius(radius) {}
+        /// @brief 점이 구 안(경계 포함)에 있으면 참을 리턴합니다.
+        inline bool contains(const vec3& p) const { return center.distance2(p) <= radius * radius; }
+        /// @brief 아핀 변환을 적용한 구를 포함하는 구를 리턴합니다. 배율이 균등하지 않으면 가장 큰 배율을 사용합니다.
+        inline Sphere transformed(const mat4& m) const {
+            const vec3 c(m[0] * center[0] + m[1] * center[1] + m[2] * center[2] + m[3],
+                m[4] * center[0] + m[5] * center[1] + m[6] * center[2] + m[7],
+                m[8] * center[0] + m[9] * center[1] + m[10] * center[2] + m[11]);
+            const float s2 = std::max({ m.col(0).xyz().length2(), m.col(1).xyz().length2(), m.col(2).xyz().length2() });
+            return Sphere(c, radius * std::sqrt(s2));
+        }
+    };
+
+    /// @brief 평면 dot(normal, p) + d = 0입니다. 법선 방향이 앞쪽(거리가 양수)입니다.
+    struct alignas(16) Plane: public align16 {
+        vec3 normal; ///< 법선
+        float d = 0; ///< 원점에서의 부호 있는 거리의 반대 값
+        inline Plane() = default;
+        inline Plane(const vec3& normal, float d): normal(normal), d(d) {}
+        /// @brief 평면 위의 한 점과 법선으로 평면을 만듭니다. 법선은 정규화됩니다.
+        inline static Plane fromPointNormal(const vec3& p, const vec3& n) { const vec3 un = n / n.length(); return Plane(un, -un.dot(p)); }
+        /// @brief 세 점을 지나는 평면을 만듭니다. 앞쪽에서 볼 때 a, b, c가 반시계 방향입니다.
+        inline static Plane fromPoints(const vec3& a, const vec3& b, const vec3& c) { return fromPointNormal(a, cross(b - a, c - a)); }
+        /// @brief 점과의 부호 있는 거리를 리턴합니다. 법선이 단위 벡터가 아니면 그 길이만큼 배가 된 값입니다.
+        inline float distance(const vec3& p) const { return normal.dot(p) + d; }
+        /// @brief 법선이 단위 벡터가 되도록 평면 방정식을 조정합니다.
+        inline void normalize() { const float inv = 1.0f / normal.length(); normal *= inv; d *= inv; }
+    };
+
+    /// @brief 방향 있는 경계 상자(OBB)입니다.
+    struct alignas(16) OBB: public align16 {
+        vec3 center; ///< 중심
+        vec3 axis[3] = { vec3(1, 0, 0), vec3(0, 1, 0), vec3(0, 0, 1) }; ///< 상자의 지역 x, y, z축 (단위 벡터)
+        vec3 extent; ///< 각 지역 축 방향 반 길이
+        inline OBB() = default;
+        /// @brief 중심, 회전, 반 길이로 상자를 만듭니다.
+        inline OBB(const vec3& center, const Quaternion& rotation, const vec3& extent): center(center), extent(extent) {
+            const mat4 r = rotation.toMat4();
+            for (int i = 0; i < 3; i++) { axis[i] = r.col(i).xyz(); }
+        }
+        /// @brief 지역 공간의 축 정렬 상자에 아핀 변환을 적용하여 상자를 만듭니다. 변환에 기울임(shear)이 없어야 정확합니다.
+        inline OBB(const AABB& local, const mat4& m): extent(local.extent()) {
+            const vec3 c = local.center();
+            for (int i = 0; i < 3; i++) {
+                center[i] = m[i * 4] * c[0] + m[i * 4 + 1] * c[1] + m[i * 4 + 2] * c[2] + m[i * 4 + 3];
+                const vec3 col = m.col(i).xyz();
+                const float len = col.length();
+                axis[i] = col / len;
+                extent[i] *= len;
+            }
+        }
+        /// @brief 점이 상자 안(경계 포함)에 있으면 참을 리턴합니다.
+        inline bool contains(const vec3& p) const {
+            const vec3 v = p - center;
+            return std::abs(v.dot(axis[0])) <= extent[0] && std::abs(v.dot(axis[1])) <= extent[1] && std::abs(v.dot(axis[2])) <= extent[2];
+        }
+        /// @brief 이 상자를 포함하는 가장 작은 축 정렬 상자를 리턴합니다.
+        inline AABB toAABB() const {
+            vec3 e;
+            for (int j = 0; j < 3; j++) { e[j] = std::abs(axis[0][j]) * extent[0] + std::abs(axis[1][j]) * extent[1] + std::abs(axis[2][j]) * extent[2]; }
+            return AABB::fromCenterExtent(center, e);
+        }
+    };
+
+    /// @brief 절두체(뷰 볼륨)입니다. 6개 평면의 법선은 모두 안쪽을 향하며 정규화되어 있습니다.
+    struct alignas(16) Frustum: public align16 {
+        /// @brief 순서대로 x=-w, x=w, y=-w, y=w, 근평면, 원평면에 해당하는 평면입니다.
+        Plane planes[6];
+        /// @brief 뷰-투사 행렬로부터 절두체를 추출합니다.
+        /// @param viewProj 투사 행렬과 뷰 행렬을 곱한 것 (proj * view)
+        /// @param zeroToOneDepth 정규 장치 좌표의 z 범위가 [0, 1]이면 참(mat4::perspective, Vulkan), [-1, 1]이면 거짓(GL)
+        inline static Frustum fromMatrix(const mat4& viewProj, bool zeroToOneDepth = true) {
+            const vec4 r0 = viewProj.row(0), r1 = viewProj.row(1), r2 = viewProj.row(2), r3 = viewProj.row(3);
+            const vec4 eq[6] = { r3 + r0, r3 - r0, r3 + r1, r3 - r1, zeroToOneDepth ? r2 : r3 + r2, r3 - r2 };
+            Frustum ret;
+            for (int i = 0; i < 6; i++) {
+                ret.planes[i] = Plane(eq[i].xyz(), eq[i].w);
+                ret.planes[i].normalize();
+            }
+            return ret;
+        }
+        /// @brief 점이 절두체 안(경계 포함)에 있으면 참을 리턴합니다.
+        inline bool contains(const vec3& p) const {
+            for (const Plane& pl : planes) { if (pl.distance(p) < 0) return false; }
+            return true;
+        }
+    };
+
+    /// @brief 반직선 origin + t * direction (t >= 0)입니다. 방향 벡터는 정규화하지 않아도 되며, 교차 검사로 얻는 t는 방향 벡터 길이를 단위로 합니다.
+    struct alignas(16) Ray: public align16 {
+        vec3 origin; ///< 시작점
+        vec3 direction = vec3(0, 0, 1); ///< 방향
+        inline Ray() = default;
+        inline Ray(const vec3& origin, const vec3& direction): origin(origin), direction(direction) {}
+        /// @brief 정규 장치 좌표의 한 점을 지나는 시선을 만듭니다. 마우스 피킹에 사용합니다.
+        /// @param inverseViewProj 뷰-투사 행렬의 역행렬
+        /// @param ndc 정규 장치 좌표 x, y
+        /// @param zeroToOneDepth 정규 장치 좌표의 z 범위가 [0, 1]이면 참(mat4::perspective, Vulkan), [-1, 1]이면 거짓(GL)
+        inline static Ray fromNDC(const mat4& inverseViewProj, const vec2& ndc, bool zeroToOneDepth = true) {
+            vec4 n = inverseViewProj * vec4(ndc.x, ndc.y, zeroToOneDepth ? 0.0f : -1.0f, 1.0f);
+            vec4 f = inverseViewProj * vec4(ndc.x, ndc.y, 1.0f, 1.0f);
+            n /= n.w; f /= f.w;
+            return Ray(n.xyz(), (f - n).xyz());
+        }
+        /// @brief 반직선 위의 점을 리턴합니다.
+        inline vec3 at(float t) const { return origin + direction * t; }
+        /// @brief 방향 벡터의 성분별 역수를 리턴합니다. 0인 성분은 inf/nan 대신 충분히 큰 유한값이 되도록 아주 작은 값으로 대체합니다.
+        inline vec3 inverseDirection() const {
+            vec3 ret;
+            for (int i = 0; i < 3; i++) {
+                const float c = direction[i];
+                ret[i] = 1.0f / (std::abs(c) < 1e-30f ? std::copysign(1e-30f, c) : c);
+            }
+            return ret;
+        }
+    };
+
+    /// @brief 두 상자가 겹치면(접하는 경우 포함) 참을 리턴합니다.
+    inline bool intersects(const AABB& a, const AABB& b) {
+        return (movemask(b_and(cmple(a.min.rg, b.max.rg), cmple(b.min.rg, a.max.rg))) & 0b111) == 0b111;
+    }
+
+    /// @brief 두 구가 겹치면(접하는 경우 포함) 참을 리턴합니다.
+    inline bool intersects(const Sphere& a, const Sphere& b) {
+        const float r = a.radius + b.radius;
+        return a.center.distance2(b.center) <= r * r;
+    }
+
+    /// @brief 상자와 구가 겹치면(접하는 경우 포함) 참을 리턴합니다.
+    inline bool intersects(const AABB& a, const Sphere& s) {
+        const vec3 closest(onart::min(onart::max(s.center.rg, a.min.rg), a.max.rg));
+        return closest.distance2(s.center) <= s.radius * s.radius;
+    }
+
+    /// @brief 상자와 구가 겹치면(접하는 경우 포함) 참을 리턴합니다.
+    inline bool intersects(const Sphere& s, const AABB& a) { return intersects(a, s); }
+
+    /// @brief 상자가 평면과 걸쳐 있으면 참을 리턴합니다.
+    inline bool intersects(const Plane& p, const AABB& a) {
+        const vec3 e = a.extent();
+        const float r = std::abs(p.normal[0]) * e[0] + std::abs(p.normal[1]) * e[1] + std::abs(p.normal[2]) * e[2];
+        return std::abs(p.distance(a.center())) <= r;
+    }
+
+    /// @brief 두 방향 있는 상자가 겹치면 참을 리턴합니다. 분리축 정리(15개 축)를 사용합니다.
+    inline bool intersects(const OBB& a, const OBB& b) {
+        // 평행한 모서리 쌍의 외적이 영벡터가 되어 잘못 분리되는 것을 막기 위한 여유
+        constexpr float EPS = 1e-6f;
+        float r[3][3], ar[3][3];
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                r[i][j] = a.axis[i].dot(b.axis[j]);
+                ar[i][j] = std::abs(r[i][j]) + EPS;
+            }
+        }
+        const vec3 d = b.center - a.center;
+        const float t[3] = { d.dot(a.axis[0]), d.dot(a.axis[1]), d.dot(a.axis[2]) };
+        const vec3& ea = a.extent;
+        const vec3& eb = b.extent;
+        for (int i = 0; i < 3; i++) {
+            if (std::abs(t[i]) > ea[i] + eb[0] * ar[i][0] + eb[1] * ar[i][1] + eb[2] * ar[i][2]) return false;
+        }
+        for (int j = 0; j < 3; j++) {
+            if (std::abs(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j]) > ea[0] * ar[0][j] + ea[1] * ar[1][j] + ea[2] * ar[2][j] + eb[j]) return false;
+        }
+        for (int i = 0; i < 3; i++) {
+            const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+            for (int j = 0; j < 3; j++) {
+                const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+                const float ra = ea[i1] * ar[i2][j] + ea[i2] * ar[i1][j];
+                const float rb = eb[j1] * ar[i][j2] + eb[j2] * ar[i][j1];
+                if (std::abs(t[i2] * r[i1][j] - t[i1] * r[i2][j]) > ra + rb) return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief 상자가 절두체와 겹칠 수 있으면 참을 리턴합니다. 모서리 부근에서는 실제로 겹치지 않아도 참일 수 있습니다(보수적 판정).
+    inline bool intersects(const Frustum& f, const AABB& a) {
+        const vec3 c = a.center(), e = a.extent();
+        for (const Plane& p : f.planes) {
+            const float r = std::abs(p.normal[0]) * e[0] + std::abs(p.normal[1]) * e[1] + std::abs(p.normal[2]) * e[2];
+            if (p.distance(c) < -r) return false;
+        }
+        return true;
+    }
+
+    /// @brief 구가 절두체와 겹칠 수 있으면 참을 리턴합니다. 모서리 부근에서는 실제로 겹치지 않아도 참일 수 있습니다(보수적 판정).
+    inline bool intersects(const Frustum& f, const Sphere& s) {
+        for (const Plane& p : f.planes) { if (p.distance(s.center) < -s.radius) return false; }
+        return true;
+    }
+
+    /// @brief 방향 있는 상자가 절두체와 겹칠 수 있으면 참을 리턴합니다. 모서리 부근에서는 실제로 겹치지 않아도 참일 수 있습니다(보수적 판정).
+    inline bool intersects(const Frustum& f, const OBB& o) {
+        for (const Plane& p : f.planes) {
+            const float r = std::abs(p.normal.dot(o.axis[0])) * o.extent[0] + std::abs(p.normal.dot(o.axis[1])) * o.extent[1] + std::abs(p.normal.dot(o.axis[2])) * o.extent[2];
+            if (p.distance(o.center) < -r) return false;
+        }
+        return true;
+    }
+
+    /// @brief 반직선과 상자의 교차를 검사합니다. 시작점이 상자 안에 있으면 t = 0입니다.
+    /// @param t 교차하는 경우 처음 만나는 지점의 매개변수를 받습니다.
+    inline bool raycast(const Ray& ray, const AABB& a, float& t) {
+        const vec3 inv = ray.inverseDirection();
+        float tn = 0, tf = std::numeric_limits<float>::infinity();
+        for (int i = 0; i < 3; i++) {
+            const float t1 = (a.min[i] - ray.origin[i]) * inv[i], t2 = (a.max[i] - ray.origin[i]) * inv[i];
+            tn = std::max(tn, std::min(t1, t2));
+            tf = std::min(tf, std::max(t1, t2));
+        }
+        if (tn > tf) return false;
+        t = tn;
+        return true;
+    }
+
+    /// @brief 반직선과 구의 교차를 검사합니다. 시작점이 구 안에 있으면 t = 0입니다.
+    /// @param t 교차하는 경우 처음 만나는 지점의 매개변수를 받습니다.
+    inline bool raycast(const Ray& ray, const Sphere& s, float& t) {
+        const vec3 m = ray.origin - s.center;
+        const float c = m.length2() - s.radius * s.radius;
+        if (c <= 0) { t = 0; return true; }
+        const float a = ray.direction.length2(), b = m.dot(ray.direction);
+        if (b > 0) return false;
+        const float disc = b * b - a * c;
+        if (disc < 0) return false;
+        t = (-b - std::sqrt(disc)) / a;
+        return true;
+    }
+
+    /// @brief 반직선과 평면의 교차를 검사합니다. 평면과 평행하면 거짓입니다.
+    /// @param t 교차하는 경우 그 지점의 매개변수를 받습니다.
+    inline bool raycast(const Ray& ray, const Plane& p, float& t) {
+        const float dn = p.normal.dot(ray.direction);
+        if (dn == 0) return false;
+        const float tt = -p.distance(ray.origin) / dn;
+        if (tt < 0) return false;
+        t = tt;
+        return true;
+    }
+
+    /// @brief 반직선과 방향 있는 상자의 교차를 검사합니다. 시작점이 상자 안에 있으면 t = 0입니다.
+    /// @param t 교차하는 경우 처음 만나는 지점의 매개변수를 받습니다.
+    inline bool raycast(const Ray& ray, const OBB& o, float& t) {
+        const vec3 rel = ray.origin - o.center;
+        const Ray local(vec3(rel.dot(o.axis[0]), rel.dot(o.axis[1]), rel.dot(o.axis[2])),
+            vec3(ray.direction.dot(o.axis[0]), ray.direction.dot(o.axis[1]), ray.direction.dot(o.axis[2])));
+        return raycast(local, AABB(-o.extent, o.extent), t);
+    }
+
+    /// @brief 여러 개의 축 정렬 상자를 성분별 배열(SoA)로 가리킵니다. 일괄 교차 검사 함수에서 사용합니다.
+    struct AABBSoA { vec3SoA min; vec3SoA max; };
+
+    /// @brief 여러 개의 구를 성분별 배열(SoA)로 가리킵니다. 일괄 교차 검사 함수에서 사용합니다.
+    struct SphereSoA { vec3SoA center; float* radius; };
+
+#ifdef YR_USING_AVX2
+    namespace avx2 {
+        /// @brief 절두체-상자 일괄 검사의 AVX2/FMA 구현입니다. 처리한 원소 수(8의 배수)를 리턴합니다.
+        YR_TARGET_AVX2 inline size_t intersectsAll(const Frustum& f, const AABBSoA& boxes, uint8_t* result, size_t count, size_t& hits) {
+            __m256 pn[6][4], pa[6][3];
+            for (int p = 0; p < 6; p++) {
+                for (int k = 0; k < 3; k++) {
+                    pn[p][k] = _mm256_set1_ps(f.planes[p].normal[k]);
+                    pa[p][k] = _mm256_set1_ps(std::abs(f.planes[p].normal[k]));
+                }
+                pn[p][3] = _mm256_set1_ps(f.planes[p].d);
+            }
+            const __m256 half = _mm256_set1_ps(0.5f), zero = _mm256_setzero_ps();
+            const size_t end = count - count % 8;
+            for (size_t i = 0; i < end; i += 8) {
+                const __m256 mnx = _mm256_loadu_ps(boxes.min.x + i), mny = _mm256_loadu_ps(boxes.min.y + i), mnz = _mm256_loadu_ps(boxes.min.z + i);
+                const __m256 mxx = _mm256_loadu_ps(boxes.max.x + i), mxy = _mm256_loadu_ps(boxes.max.y + i), mxz = _mm256_loadu_ps(boxes.max.z + i);
+                const __m256 cx = _mm256_mul_ps(_mm256_add_ps(mnx, mxx), half), cy = _mm256_mul_ps(_mm256_add_ps(mny, mxy), half), cz = _mm256_mul_ps(_mm256_add_ps(mnz, mxz), half);
+                const __m256 ex = _mm256_mul_ps(_mm256_sub_ps(mxx, mnx), half), ey = _mm256_mul_ps(_mm256_sub_ps(mxy, mny), half), ez = _mm256_mul_ps(_mm256_sub_ps(mxz, mnz), half);
+                __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                for (int p = 0; p < 6; p++) {
+                    __m256 dist = _mm256_fmadd_ps(pn[p][0], cx, _mm256_fmadd_ps(pn[p][1], cy, _mm256_fmadd_ps(pn[p][2], cz, pn[p][3])));
+                    dist = _mm256_fmadd_ps(pa[p][0], ex, _mm256_fmadd_ps(pa[p][1], ey, _mm256_fmadd_ps(pa[p][2], ez, dist)));
+                    inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, zero, _CMP_GE_OQ));
+                }
+                const int bits = _mm256_movemask_ps(inside);
+                for (int k = 0; k < 8; k++) {
+                    result[i + k] = (uint8_t)((bits >> k) & 1);
+                    hits += result[i + k];
+                }
+            }
+            return end;
+        }
+
+        /// @brief 반직선-상자 일괄 검사의 AVX2/FMA 구현입니다. 처리한 원소 수(8의 배수)를 리턴합니다.
+        YR_TARGET_AVX2 inline size_t raycastAll(const Ray& ray, const AABBSoA& boxes, float* t, size_t count, size_t& hits) {
+            const vec3 inv = ray.inverseDirection();
+            const __m256 ix = _mm256_set1_ps(inv[0]), iy = _mm256_set1_ps(inv[1]), iz = _mm256_set1_ps(inv[2]);
+            const __m256 ox = _mm256_set1_ps(ray.origin[0]), oy = _mm256_set1_ps(ray.origin[1]), oz = _mm256_set1_ps(ray.origin[2]);
+            const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+            const size_t end = count - count % 8;
+            for (size_t i = 0; i < end; i += 8) {
+                const __m256 x1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.min.x + i), ox), ix), x2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.max.x + i), ox), ix);
+                const __m256 y1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.min.y + i), oy), iy), y2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.max.y + i), oy), iy);
+                const __m256 z1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.min.z + i), oz), iz), z2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(boxes.max.z + i), oz), iz);
+                const __m256 tn = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(x1, x2), _mm256_min_ps(y1, y2)), _mm256_max_ps(_mm256_min_ps(z1, z2), _mm256_setzero_ps()));
+                const __m256 tf = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(x1, x2), _mm256_max_ps(y1, y2)), _mm256_min_ps(_mm256_max_ps(z1, z2), inf));
+                const __m256 hit = _mm256_cmp_ps(tn, tf, _CMP_LE_OQ);
+                _mm256_storeu_ps(t + i, _mm256_blendv_ps(inf, tn, hit));
+                const int bits = _mm256_movemask_ps(hit);
+                for (int k = 0; k < 8; k++) { hits += (bits >> k) & 1; }
+            }
+            return end;
+        }
+    }
+#endif
+
+    /// @brief 절두체와 여러 상자의 겹침을 일괄 검사합니다. 4개(AVX2 사용 시 8개)씩 묶어 계산하며, intersects(const Frustum&, const AABB&)와 같은 판정을 합니다.
+    /// @param f 절두체
+    /// @param boxes 상자 배열
+    /// @param result 원소별로 겹치면 1, 아니면 0을 받을 배열
+    /// @param count 상자 수
+    /// @return 겹치는 상자 수
+    inline size_t intersectsAll(const Frustum& f, const AABBSoA& boxes, uint8_t* result, size_t count) {
+        size_t i = 0, hits = 0;
+#ifdef YR_USING_AVX2
+        if (avx2::ENABLED) { i = avx2::intersectsAll(f, boxes, result, count, hits); }
+#endif
+        float128 pn[6][4], pa[6][3];
+        for (int p = 0; p < 6; p++) {
+            for (int k = 0; k < 3; k++) {
+                pn[p][k] = load(f.planes[p].normal[k]);
+                pa[p][k] = load(std::abs(f.planes[p].normal[k]));
+            }
+            pn[p][3] = load(f.planes[p].d);
+        }
+        const float128 half = load(0.5f), zero = zerof128();
+        for (; i + 4 <= count; i += 4) {
+            const float128 mnx = loadu(boxes.min.x + i), mny = loadu(boxes.min.y + i), mnz = loadu(boxes.min.z + i);
+            const float128 mxx = loadu(boxes.max.x + i), mxy = loadu(boxes.max.y + i), mxz = loadu(boxes.max.z + i);
+            const float128 cx = mul(add(mnx, mxx), half), cy = mul(add(mny, mxy), half), cz = mul(add(mnz, mxz), half);
+            const float128 ex = mul(sub(mxx, mnx), half), ey = mul(sub(mxy, mny), half), ez = mul(sub(mxz, mnz), half);
+            float128 inside = cmple(zero, zero);
+            for (int p = 0; p < 6; p++) {
+                const float128 dist = add(add(add(mul(pn[p][0], cx), mul(pn[p][1], cy)), add(mul(pn[p][2], cz), pn[p][3])),
+                    add(add(mul(pa[p][0], ex), mul(pa[p][1], ey)), mul(pa[p][2], ez)));
+                inside = b_and(inside, cmple(zero, dist));
+            }
+            const int bits = movemask(inside);
+            for (int k = 0; k < 4; k++) {
+                result[i + k] = (uint8_t)((bits >> k) & 1);
+                hits += result[i + k];
+            }
+        }
+        for (; i < count; i++) {
+            result[i] = intersects(f, AABB(vec3(boxes.min.x[i], boxes.min.y[i], boxes.min.z[i]), vec3(boxes.max.x[i], boxes.max.y[i], boxes.max.z[i])));
+            hits += result[i];
+        }
+        return hits;
+    }
+
+    /// @brief 절두체와 여러 구의 겹침을 일괄 검사합니다. 4개씩 묶어 계산하며, intersects(const Frustum&, const Sphere&)와 같은 판정을 합니다.
+    /// @param f 절두체
+    /// @param spheres 구 배열
+    /// @param result 원소별로 겹치면 1, 아니면 0을 받을 배열
+    /// @param count 구 수
+    /// @return 겹치는 구 수
+    inline size_t intersectsAll(const Frustum& f, const SphereSoA& spheres, uint8_t* result, size_t count) {
+        size_t i = 0, hits = 0;
+        float128 pn[6][4];
+        for (int p = 0; p < 6; p++) {
+            for (int k = 0; k < 3; k++) { pn[p][k] = load(f.planes[p].normal[k]); }
+            pn[p][3] = load(f.planes[p].d);
+        }
+        for (; i + 4 <= count; i += 4) {
+            const float128 cx = loadu(spheres.center.x + i), cy = loadu(spheres.center.y + i), cz = loadu(spheres.center.z + i);
+            const float128 nr = neg(loadu(spheres.radius + i));
+            float128 inside = cmple(nr, nr);
+            for (int p = 0; p < 6; p++) {
+                const float128 dist = add(add(mul(pn[p][0], cx), mul(pn[p][1], cy)), add(mul(pn[p][2], cz), pn[p][3]));
+                inside = b_and(inside, cmple(nr, dist));
+            }
+            const int bits = movemask(inside);
+            for (int k = 0; k < 4; k++) {
+                result[i + k] = (uint8_t)((bits >> k) & 1);
+                hits += result[i + k];
+            }
+        }
+        for (; i < count; i++) {
+            result[i] = intersects(f, Sphere(vec3(spheres.center.x[i], spheres.center.y[i], spheres.center.z[i]), spheres.radius[i]));
+            hits += result[i];
+        }
+        return hits;
+    }
+
+    /// @brief 구 쌍 (a[i], b[i])들의 겹침을 일괄 검사합니다. 4개씩 묶어 계산하며, intersects(const Sphere&, const Sphere&)와 같은 판정을 합니다.
+    /// @param a 구 배열 1
+    /// @param b 구 배열 2
+    /// @param result 원소별로 겹치면 1, 아니면 0을 받을 배열
+    /// @param count 쌍의 수
+    /// @return 겹치는 쌍의 수
+    inline size_t intersectsAll(const SphereSoA& a, const SphereSoA& b, uint8_t* result, size_t count) {
+        size_t i = 0, hits = 0;
+        for (; i + 4 <= count; i += 4) {
+            const float128 dx = sub(loadu(a.center.x + i), loadu(b.center.x + i));
+            const float128 dy = sub(loadu(a.center.y + i), loadu(b.center.y + i));
+            const float128 dz = sub(loadu(a.center.z + i), loadu(b.center.z + i));
+            const float128 r = add(loadu(a.radius + i), loadu(b.radius + i));
+            const int bits = movemask(cmple(add(add(mul(dx, dx), mul(dy, dy)), mul(dz, dz)), mul(r, r)));
+            for (int k = 0; k < 4; k++) {
+                result[i + k] = (uint8_t)((bits >> k) & 1);
+                hits += result[i + k];
+            }
+        }
+        for (; i < count; i++) {
+            const float dx = a.center.x[i] - b.center.x[i], dy = a.center.y[i] - b.center.y[i], dz = a.center.z[i] - b.center.z[i];
+            const float r = a.radius[i] + b.radius[i];
+            result[i] = (dx * dx + dy * dy) + dz * dz <= r * r;
+            hits += result[i];
+        }
+        return hits;
+    }
+
+    /// @brief 반직선과 여러 상자의 교차를 일괄 검사합니다. 4개(AVX2 사용 시 8개)씩 묶어 계산하며, raycast(const Ray&, const AABB&, float&)와 같은 결과를 냅니다.
+    /// 가장 가까운 상자를 찾으려면 t의 최솟값을 찾으면 됩니다.
+    /// @param ray 반직선
+    /// @param boxes 상자 배열
+    /// @param t 원소별로 처음 만나는 지점의 매개변수를 받을 배열. 교차하지 않으면 양의 무한대입니다.
+    /// @param count 상자 수
+    /// @return 교차하는 상자 수
+    inline size_t raycastAll(const Ray& ray, const AABBSoA& boxes, float* t, size_t count) {
+        size_t i = 0, hits = 0;
+#ifdef YR_USING_AVX2
+        if (avx2::ENABLED) { i = avx2::raycastAll(ray, boxes, t, count, hits); }
+#endif
+        const vec3 inv = ray.inverseDirection();
+        const float128 ix = load(inv[0]), iy = load(inv[1]), iz = load(inv[2]);
+        const float128 ox = load(ray.origin[0]), oy = load(ray.origin[1]), oz = load(ray.origin[2]);
+        const float128 inf = load(std::numeric_limits<float>::infinity());
+        for (; i + 4 <= count; i += 4) {
+            const float128 x1 = mul(sub(loadu(boxes.min.x + i), ox), ix), x2 = mul(sub(loadu(boxes.max.x + i), ox), ix);
+            const float128 y1 = mul(sub(loadu(boxes.min.y + i), oy), iy), y2 = mul(sub(loadu(boxes.max.y + i), oy), iy);
+            const float128 z1 = mul(sub(loadu(boxes.min.z + i), oz), iz), z2 = mul(sub(loadu(boxes.max.z + i), oz), iz);
+            const float128 tn = max(max(min(x1, x2), min(y1, y2)), max(min(z1, z2), zerof128()));
+            const float128 tf = min(min(max(x1, x2), max(y1, y2)), min(max(z1, z2), inf));
+            const float128 hit = cmple(tn, tf);
+            storeu(select(hit, tn, inf), t + i);
+            const int bits = movemask(hit);
+            for (int k = 0; k < 4; k++) { hits += (bits >> k) & 1; }
+        }
+        for (; i < count; i++) {
+            if (raycast(ray, AABB(vec3(boxes.min.x[i], boxes.min.y[i], boxes.min.z[i]), vec3(boxes.max.x[i], boxes.max.y[i], boxes.max.z[i])), t[i])) { hits++; }
+            else { t[i] = std::numeric_limits<float>::infinity(); }
+        }
+        return hits;
+    }
+}
+
+#endif
@@ -27,6 +27,7 @@ namespace onart {
 }
 #elif defined(YR_USE_OPENGL)
 #include "yr_opengl.h"
+#define YR_HAS_STREAM_GEOMETRY // YRGraphics::allocateStreamGeometry 사용 가능
 namespace onart{
     using YRGraphics = GLMachine;
     using shader_t = unsigned;
@@ -45,6 +46,7 @@ namespace onart{
 }
 #elif defined(YR_USE_VULKAN)
 #include "yr_vulkan.h"
+#define YR_HAS_STREAM_GEOMETRY // YRGraphics::allocateStreamGeometry 사용 가능
 namespace onart{
     using YRGraphics = VkMachine;
     using shader_t = VkShaderModule;
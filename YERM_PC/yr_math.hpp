@@ -1611,9 +1611,12 @@ namespace onart{
         /// @param pitch pitch(Y축 방향 회전)
         /// @param yaw yaw(Z축 방향 회전)
         inline static Quaternion rotation(float roll, float pitch, float yaw) {
-            float cy = std::cos(yaw * 0.5f);	float sy = std::sin(yaw * 0.5f);
-            float cp = std::cos(pitch * 0.5f);	float sp = std::sin(pitch * 0.5f);
-            float cr = std::cos(roll * 0.5f);	float sr = std::sin(roll * 0.5f);
+            float128 s4, c4;
+            sincos(load(roll * 0.5f, pitch * 0.5f, yaw * 0.5f, 0.0f), s4, c4);
+            alignas(16) float s[4], c[4];
+            store(s4, s); store(c4, c);
+            const float sr = s[0], sp = s[1], sy = s[2];
+            const float cr = c[0], cp = c[1], cy = c[2];
             return Quaternion(cr * cp * cy + sr * sp * sy, sr * cp * cy - cr * sp * sy, cr * sp * cy + sr * cp * sy, cr * cp * sy - sr * sp * cy);
         }
 
@@ -1744,6 +1747,277 @@ namespace onart{
         Quaternion vq(vec4(dir, 0).wxyz().rg);
         return vec4(((q * vq) * q.conjugate()).rg).yzw();
     }
+
+    /// @brief 여러 개의 3차원 벡터를 성분별 배열(SoA)로 가리킵니다. 일괄 연산 함수에서 사용합니다.
+    struct vec3SoA { float* x; float* y; float* z; };
+
+    /// @brief 여러 개의 사원수를 성분별 배열(SoA)로 가리킵니다. 일괄 연산 함수에서 사용합니다.
+    struct QuaternionSoA { float* c1; float* ci; float* cj; float* ck; };
+
+#ifdef YR_USING_AVX2
+    namespace avx2 {
+        /// @brief 행렬 배열 곱의 AVX2/FMA 구현입니다. 두 행씩 8개 레인으로 계산합니다.
+        YR_TARGET_AVX2 inline void mulAll(const mat4* a, const mat4* b, mat4* out, size_t count) {
+            const __m256i idx[4] = {
+                _mm256_setr_epi32(0, 0, 0, 0, 4, 4, 4, 4), _mm256_setr_epi32(1, 1, 1, 1, 5, 5, 5, 5),
+                _mm256_setr_epi32(2, 2, 2, 2, 6, 6, 6, 6), _mm256_setr_epi32(3, 3, 3, 3, 7, 7, 7, 7)
+            };
+            for (size_t n = 0; n < count; n++) {
+                const float* r = b[n].a;
+                const __m256 r0 = _mm256_broadcast_ps((const __m128*)r);
+                const __m256 r1 = _mm256_broadcast_ps((const __m128*)(r + 4));
+                const __m256 r2 = _mm256_broadcast_ps((const __m128*)(r + 8));
+                const __m256 r3 = _mm256_broadcast_ps((const __m128*)(r + 12));
+                __m256 half[2];
+                for (int h = 0; h < 2; h++) {
+                    const __m256 l = _mm256_loadu_ps(a[n].a + 8 * h);
+                    __m256 acc = _mm256_mul_ps(_mm256_permutevar8x32_ps(l, idx[0]), r0);
+                    acc = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(l, idx[1]), r1, acc);
+                    acc = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(l, idx[2]), r2, acc);
+                    half[h] = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(l, idx[3]), r3, acc);
+                }
+                _mm256_storeu_ps(out[n].a, half[0]);
+                _mm256_storeu_ps(out[n].a + 8, half[1]);
+            }
+        }
+
+        /// @brief TRSAll의 AVX2/FMA 구현입니다. 처리한 개수(8의 배수)를 리턴합니다.
+        YR_TARGET_AVX2 inline size_t TRSAll(const vec3SoA& t, const QuaternionSoA& r, const vec3SoA& s, mat4* out, size_t count) {
+            const __m256 one = _mm256_set1_ps(1.0f), two = _mm256_set1_ps(2.0f);
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                const __m256 w = _mm256_loadu_ps(r.c1 + i), x = _mm256_loadu_ps(r.ci + i), y = _mm256_loadu_ps(r.cj + i), z = _mm256_loadu_ps(r.ck + i);
+                const __m256 sx = _mm256_loadu_ps(s.x + i), sy = _mm256_loadu_ps(s.y + i), sz = _mm256_loadu_ps(s.z + i);
+                const __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+                const __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+                const __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+                __m256 e[12];
+                e[0] = _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(yy, zz), one), sx);
+                e[1] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), sy);
+                e[2] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), sz);
+                e[3] = _mm256_loadu_ps(t.x + i);
+                e[4] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), sx);
+                e[5] = _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(xx, zz), one), sy);
+                e[6] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), sz);
+                e[7] = _mm256_loadu_ps(t.y + i);
+                e[8] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), sx);
+                e[9] = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), sy);
+                e[10] = _mm256_mul_ps(_mm256_fnmadd_ps(two, _mm256_add_ps(xx, yy), one), sz);
+                e[11] = _mm256_loadu_ps(t.z + i);
+                const float128 lastRow = load(0.0f, 0.0f, 0.0f, 1.0f);
+                for (int h = 0; h < 2; h++) {
+                    mat4* dst = out + i + 4 * h;
+                    for (int row = 0; row < 3; row++) {
+                        float128 c0 = h ? _mm256_extractf128_ps(e[row * 4], 1) : _mm256_castps256_ps128(e[row * 4]);
+                        float128 c1 = h ? _mm256_extractf128_ps(e[row * 4 + 1], 1) : _mm256_castps256_ps128(e[row * 4 + 1]);
+                        float128 c2 = h ? _mm256_extractf128_ps(e[row * 4 + 2], 1) : _mm256_castps256_ps128(e[row * 4 + 2]);
+                        float128 c3 = h ? _mm256_extractf128_ps(e[row * 4 + 3], 1) : _mm256_castps256_ps128(e[row * 4 + 3]);
+                        transpose4(c0, c1, c2, c3);
+                        storeu(c0, dst[0].a + row * 4); storeu(c1, dst[1].a + row * 4);
+                        storeu(c2, dst[2].a + row * 4); storeu(c3, dst[3].a + row * 4);
+                    }
+                    for (int k = 0; k < 4; k++) { storeu(lastRow, dst[k].a + 12); }
+                }
+            }
+            return i;
+        }
+
+        /// @brief slerpAll의 AVX2/FMA 구현입니다. 처리한 개수(8의 배수)를 리턴합니다.
+        YR_TARGET_AVX2 inline size_t slerpAll(const QuaternionSoA& q1, const QuaternionSoA& q2, const float* t, const QuaternionSoA& out, size_t count) {
+            const __m256 one = _mm256_set1_ps(1.0f), zero = _mm256_setzero_ps();
+            const __m256 eps = _mm256_set1_ps(std::numeric_limits<float>::epsilon());
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                const __m256 a1 = _mm256_loadu_ps(q1.c1 + i), ai = _mm256_loadu_ps(q1.ci + i), aj = _mm256_loadu_ps(q1.cj + i), ak = _mm256_loadu_ps(q1.ck + i);
+                const __m256 b1 = _mm256_loadu_ps(q2.c1 + i), bi = _mm256_loadu_ps(q2.ci + i), bj = _mm256_loadu_ps(q2.cj + i), bk = _mm256_loadu_ps(q2.ck + i);
+                const __m256 dot = _mm256_fmadd_ps(a1, b1, _mm256_fmadd_ps(ai, bi, _mm256_fmadd_ps(aj, bj, _mm256_mul_ps(ak, bk))));
+                const __m256 na = _mm256_fmadd_ps(a1, a1, _mm256_fmadd_ps(ai, ai, _mm256_fmadd_ps(aj, aj, _mm256_mul_ps(ak, ak))));
+                const __m256 nb = _mm256_fmadd_ps(b1, b1, _mm256_fmadd_ps(bi, bi, _mm256_fmadd_ps(bj, bj, _mm256_mul_ps(bk, bk))));
+                const __m256 costh = _mm256_max_ps(_mm256_min_ps(_mm256_div_ps(dot, _mm256_sqrt_ps(_mm256_mul_ps(na, nb))), one), _mm256_set1_ps(-1.0f));
+                const __m256 sn = _mm256_sqrt_ps(_mm256_max_ps(_mm256_fnmadd_ps(costh, costh, one), zero));
+                const __m256 theta = atan2(sn, costh);
+                const __m256 t8 = _mm256_loadu_ps(t + i);
+                const __m256 degenerate = _mm256_cmp_ps(sn, eps, _CMP_LE_OQ);
+                const __m256 wa = _mm256_blendv_ps(_mm256_div_ps(sin(_mm256_mul_ps(_mm256_sub_ps(one, t8), theta)), sn), one, degenerate);
+                const __m256 wb = _mm256_blendv_ps(_mm256_div_ps(sin(_mm256_mul_ps(t8, theta)), sn), zero, degenerate);
+                const __m256 r1 = _mm256_fmadd_ps(a1, wa, _mm256_mul_ps(b1, wb)), ri = _mm256_fmadd_ps(ai, wa, _mm256_mul_ps(bi, wb));
+                const __m256 rj = _mm256_fmadd_ps(aj, wa, _mm256_mul_ps(bj, wb)), rk = _mm256_fmadd_ps(ak, wa, _mm256_mul_ps(bk, wb));
+                const __m256 len2 = _mm256_fmadd_ps(r1, r1, _mm256_fmadd_ps(ri, ri, _mm256_fmadd_ps(rj, rj, _mm256_mul_ps(rk, rk))));
+                const __m256 inv = _mm256_div_ps(one, _mm256_sqrt_ps(len2));
+                _mm256_storeu_ps(out.c1 + i, _mm256_mul_ps(r1, inv));
+                _mm256_storeu_ps(out.ci + i, _mm256_mul_ps(ri, inv));
+                _mm256_storeu_ps(out.cj + i, _mm256_mul_ps(rj, inv));
+                _mm256_storeu_ps(out.ck + i, _mm256_mul_ps(rk, inv));
+            }
+            return i;
+        }
+
+        /// @brief transformPointsAll의 AVX2/FMA 구현입니다. 처리한 개수(8의 배수)를 리턴합니다.
+        YR_TARGET_AVX2 inline size_t transformPointsAll(const mat4& m, const vec3SoA& in, const vec3SoA& out, size_t count) {
+            __m256 e[12];
+            for (int k = 0; k < 12; k++) { e[k] = _mm256_set1_ps(m[k]); }
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                const __m256 x = _mm256_loadu_ps(in.x + i), y = _mm256_loadu_ps(in.y + i), z = _mm256_loadu_ps(in.z + i);
+                const __m256 ox = _mm256_fmadd_ps(e[0], x, _mm256_fmadd_ps(e[1], y, _mm256_fmadd_ps(e[2], z, e[3])));
+                const __m256 oy = _mm256_fmadd_ps(e[4], x, _mm256_fmadd_ps(e[5], y, _mm256_fmadd_ps(e[6], z, e[7])));
+                const __m256 oz = _mm256_fmadd_ps(e[8], x, _mm256_fmadd_ps(e[9], y, _mm256_fmadd_ps(e[10], z, e[11])));
+                _mm256_storeu_ps(out.x + i, ox);
+                _mm256_storeu_ps(out.y + i, oy);
+                _mm256_storeu_ps(out.z + i, oz);
+            }
+            return i;
+        }
+    }
+#endif
+
+    /// @brief 행렬 배열을 원소별로 곱합니다. out[i] = a[i] * b[i]이며, out이 a나 b와 같은 배열이어도 됩니다.
+    /// 합의 순서가 operator*와 달라 마지막 자리 오차가 있을 수 있습니다.
+    /// @param a 왼쪽 행렬 배열
+    /// @param b 오른쪽 행렬 배열
+    /// @param out 결과를 받을 배열
+    /// @param count 행렬 수
+    inline void mulAll(const mat4* a, const mat4* b, mat4* out, size_t count) {
+#ifdef YR_USING_AVX2
+        if (avx2::ENABLED) { avx2::mulAll(a, b, out, count); return; }
+#endif
+        for (size_t n = 0; n < count; n++) {
+            const float* l = a[n].a;
+            const float* r = b[n].a;
+            const float128 r0 = loadu(r), r1 = loadu(r + 4), r2 = loadu(r + 8), r3 = loadu(r + 12);
+            float128 rows[4];
+            for (int k = 0; k < 4; k++) {
+                const float* lr = l + 4 * k;
+                float128 acc = mul(load(lr[0]), r0);
+                acc = add(acc, mul(load(lr[1]), r1));
+                acc = add(acc, mul(load(lr[2]), r2));
+                rows[k] = add(acc, mul(load(lr[3]), r3));
+            }
+            for (int k = 0; k < 4; k++) { storeu(rows[k], out[n].a + 4 * k); }
+        }
+    }
+
+    /// @brief 성분별 배열로 주어진 이동, 회전, 배율로 mat4::TRS를 일괄 계산합니다. 4개(AVX2 사용 시 8개)씩 묶어 계산합니다.
+    /// @param t 이동 배열
+    /// @param r 회전 사원수 배열 (단위 사원수여야 합니다.)
+    /// @param s 배율 배열
+    /// @param out 결과를 받을 배열
+    /// @param count 변환 수
+    inline void TRSAll(const vec3SoA& t, const QuaternionSoA& r, const vec3SoA& s, mat4* out, size_t count) {
+        size_t i = 0;
+#ifdef YR_USING_AVX2
+        if (avx2::ENABLED) { i = avx2::TRSAll(t, r, s, out, count); }
+#endif
+        const float128 one = load(1.0f), two = load(2.0f);
+        const float128 lastRow = load(0.0f, 0.0f, 0.0f, 1.0f);
+        for (; i + 4 <= count; i += 4) {
+            const float128 w = loadu(r.c1 + i), x = loadu(r.ci + i), y = loadu(r.cj + i), z = loadu(r.ck + i);
+            const float128 sx = loadu(s.x + i), sy = loadu(s.y + i), sz = loadu(s.z + i);
+            const float128 xx = mul(x, x), yy = mul(y, y), zz = mul(z, z);
+            const float128 xy = mul(x, y), xz = mul(x, z), yz = mul(y, z);
+            const float128 wx = mul(w, x), wy = mul(w, y), wz = mul(w, z);
+            float128 e[12];
+            e[0] = mul(sub(one, mul(two, add(yy, zz))), sx);
+            e[1] = mul(mul(two, sub(xy, wz)), sy);
+            e[2] = mul(mul(two, add(xz, wy)), sz);
+            e[3] = loadu(t.x + i);
+            e[4] = mul(mul(two, add(xy, wz)), sx);
+            e[5] = mul(sub(one, mul(two, add(xx, zz))), sy);
+            e[6] = mul(mul(two, sub(yz, wx)), sz);
+            e[7] = loadu(t.y + i);
+            e[8] = mul(mul(two, sub(xz, wy)), sx);
+            e[9] = mul(mul(two, add(yz, wx)), sy);
+            e[10] = mul(sub(one, mul(two, add(xx, yy))), sz);
+            e[11] = loadu(t.z + i);
+            for (int row = 0; row < 3; row++) {
+                float128* c = e + row * 4;
+                transpose4(c[0], c[1], c[2], c[3]);
+                for (int k = 0; k < 4; k++) { storeu(c[k], out[i + k].a + row * 4); }
+            }
+            for (int k = 0; k < 4; k++) { storeu(lastRow, out[i + k].a + 12); }
+        }
+        for (; i < count; i++) {
+            out[i] = mat4::TRS(vec3(t.x[i], t.y[i], t.z[i]), Quaternion(r.c1[i], r.ci[i], r.cj[i], r.ck[i]), vec3(s.x[i], s.y[i], s.z[i]));
+        }
+    }
+
+    /// @brief 성분별 배열로 주어진 점들에 아핀 변환을 일괄 적용합니다. (w=1로 간주하며 마지막 행은 무시합니다.) in과 out은 같은 배열이어도 됩니다.
+    /// @param m 변환 행렬
+    /// @param in 변환할 점 배열
+    /// @param out 결과를 받을 배열
+    /// @param count 점 수
+    inline void transformPointsAll(const mat4& m, const vec3SoA& in, const vec3SoA& out, size_t count) {
+        size_t i = 0;
+#ifdef YR_USING_AVX2
+        if (avx2::ENABLED) { i = avx2::transformPointsAll(m, in, out, count); }
+#endif
+        float128 e[12];
+        for (int k = 0; k < 12; k++) { e[k] = load(m[k]); }
+        for (; i + 4 <= count; i += 4) {
+            const float128 x = loadu(in.x + i), y = loadu(in.y + i), z = loadu(in.z + i);
+            storeu(add(add(mul(e[0], x), mul(e[1], y)), add(mul(e[2], z), e[3])), out.x + i);
+            storeu(add(add(mul(e[4], x), mul(e[5], y)), add(mul(e[6], z), e[7])), out.y + i);
+            storeu(add(add(mul(e[8], x), mul(e[9], y)), add(mul(e[10], z), e[11])), out.z + i);
+        }
+        for (; i < count; i++) {
+            const float x = in.x[i], y = in.y[i], z = in.z[i];
+            out.x[i] = m[0] * x + m[1] * y + m[2] * z + m[3];
+            out.y[i] = m[4] * x + m[5] * y + m[6] * z + m[7];
+            out.z[i] = m[8] * x + m[9] * y + m[10] * z + m[11];
+        }
+    }
+
+    /// @brief 성분별 배열로 주어진 사원수 쌍들의 구면 선형 보간을 일괄 계산합니다. 4개(AVX2 사용 시 8개)씩 묶어 계산합니다.
+    /// 두 사원수가 같거나 180도 차이인 경우 q1을 정규화한 값을 리턴합니다.
+    /// @param q1 보간 대상 1 배열
+    /// @param q2 보간 대상 2 배열
+    /// @param t 원소별 보간 값 배열
+    /// @param out 결과를 받을 배열 (q1, q2와 같은 배열이어도 됩니다.)
+    /// @param count 사원수 수
+    inline void slerpAll(const QuaternionSoA& q1, const QuaternionSoA& q2, const float* t, const QuaternionSoA& out, size_t count) {
+        auto block = [](const QuaternionSoA& q1, const QuaternionSoA& q2, const float* t, const QuaternionSoA& out, size_t i) {
+            const float128 a1 = loadu(q1.c1 + i), ai = loadu(q1.ci + i), aj = loadu(q1.cj + i), ak = loadu(q1.ck + i);
+            const float128 b1 = loadu(q2.c1 + i), bi = loadu(q2.ci + i), bj = loadu(q2.cj + i), bk = loadu(q2.ck + i);
+            const float128 one = load(1.0f);
+            const float128 dot = add(add(mul(a1, b1), mul(ai, bi)), add(mul(aj, bj), mul(ak, bk)));
+            const float128 na = add(add(mul(a1, a1), mul(ai, ai)), add(mul(aj, aj), mul(ak, ak)));
+            const float128 nb = add(add(mul(b1, b1), mul(bi, bi)), add(mul(bj, bj), mul(bk, bk)));
+            // 정밀도 오차로 인한 nan 방지
+            const float128 costh = max(min(div(dot, sqrt(mul(na, nb))), one), load(-1.0f));
+            const float128 sn = sqrt(max(sub(one, mul(costh, costh)), zerof128()));
+            const float128 theta = atan2(sn, costh);
+            const float128 t4 = loadu(t + i);
+            // q1=q2이거나 180도 차이인 경우 q1
+            const float128 degenerate = cmple(sn, load(std::numeric_limits<float>::epsilon()));
+            const float128 wa4 = select(degenerate, one, div(sin(mul(sub(one, t4), theta)), sn));
+            const float128 wb4 = select(degenerate, zerof128(), div(sin(mul(t4, theta)), sn));
+            const float128 r1 = add(mul(a1, wa4), mul(b1, wb4)), ri = add(mul(ai, wa4), mul(bi, wb4));
+            const float128 rj = add(mul(aj, wa4), mul(bj, wb4)), rk = add(mul(ak, wa4), mul(bk, wb4));
+            const float128 inv = div(one, sqrt(add(add(mul(r1, r1), mul(ri, ri)), add(mul(rj, rj), mul(rk, rk)))));
+            storeu(mul(r1, inv), out.c1 + i);
+            storeu(mul(ri, inv), out.ci + i);
+            storeu(mul(rj, inv), out.cj + i);
+            storeu(mul(rk, inv), out.ck + i);
+        };
+        size_t i = 0;
+#ifdef YR_USING_AVX2
+        if (avx2::ENABLED) { i = avx2::slerpAll(q1, q2, t, out, count); }
+#endif
+        for (; i + 4 <= count; i += 4) { block(q1, q2, t, out, i); }
+        if (i == count) { return; }
+        // 남은 원소는 단위 사원수로 채운 4개 묶음으로 계산
+        float pa[4][4] = { {1,1,1,1} }, pb[4][4] = { {1,1,1,1} }, pr[4][4], pt[4] = {};
+        const size_t rest = count - i;
+        for (size_t k = 0; k < rest; k++) {
+            pa[0][k] = q1.c1[i + k]; pa[1][k] = q1.ci[i + k]; pa[2][k] = q1.cj[i + k]; pa[3][k] = q1.ck[i + k];
+            pb[0][k] = q2.c1[i + k]; pb[1][k] = q2.ci[i + k]; pb[2][k] = q2.cj[i + k]; pb[3][k] = q2.ck[i + k];
+            pt[k] = t[i + k];
+        }
+        block({ pa[0], pa[1], pa[2], pa[3] }, { pb[0], pb[1], pb[2], pb[3] }, pt, { pr[0], pr[1], pr[2], pr[3] }, 0);
+        for (size_t k = 0; k < rest; k++) {
+            out.c1[i + k] = pr[0][k]; out.ci[i + k] = pr[1][k]; out.cj[i + k] = pr[2][k]; out.ck[i + k] = pr[3][k];
+        }
+    }
 }
 
 #endif
\ No newline at end of file
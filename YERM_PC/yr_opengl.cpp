@@ -270,6 +270,9 @@ namespace onart {
     }
 
     void GLMachine::free() {
+        if (stream.buffer) { glDeleteBuffers(1, &stream.buffer); }
+        stream.buffer = 0;
+        stream.data.reset();
         for (auto& sh : shaders) { glDeleteShader(sh.second); }
         for (auto& ws : windowSystems) { delete ws.second; }
 
@@ -286,6 +289,78 @@ namespace onart {
 
     void GLMachine::handle() {
         singleton->loadThread.handleCompleted();
+        singleton->advanceStream();
+    }
+
+    void GLMachine::advanceStream() {
+        if (!stream.buffer) return;
+        stream.frame++;
+        if (stream.used == 0 && stream.demand <= stream.capacity) return;
+        if (stream.demand > stream.capacity) {
+            uint64_t capacity = stream.capacity * 2;
+            while (capacity < stream.demand) { capacity *= 2; }
+            stream.data.reset(new uint8_t[capacity]);
+            stream.capacity = capacity;
+        }
+        // 새 저장소를 받아 이전 프레임의 그리기가 끝나기를 기다리지 않게 합니다.
+        glBindBuffer(GL_ARRAY_BUFFER, stream.buffer);
+        glBufferData(GL_ARRAY_BUFFER, stream.capacity, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        stream.used = 0;
+        stream.uploaded = 0;
+        stream.demand = 0;
+    }
+
+    void GLMachine::flushStream() {
+        if (stream.uploaded == stream.used) return;
+        glBindBuffer(GL_ARRAY_BUFFER, stream.buffer);
+        glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)stream.uploaded, (GLsizeiptr)(stream.used - stream.uploaded), stream.data.get() + stream.uploaded);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        stream.uploaded = stream.used;
+    }
+
+    GLMachine::StreamGeometry GLMachine::allocateStreamGeometry(uint32_t vertexCount, uint32_t singleVertexSize, uint32_t indexCount, uint32_t singleIndexSize) {
+        constexpr uint64_t DEFAULT_STREAM_CAPACITY = 4 << 20;
+        if (indexCount != 0 && singleIndexSize != 2 && singleIndexSize != 4) {
+            LOGWITH("Invalid isize");
+            return {};
+        }
+        if (vertexCount == 0 || singleVertexSize == 0) { return {}; }
+        auto& stream = singleton->stream;
+        if (!stream.buffer) {
+            glGenBuffers(1, &stream.buffer);
+            if (!stream.buffer) {
+                LOGWITH("Failed to create stream buffer");
+                return {};
+            }
+            stream.capacity = DEFAULT_STREAM_CAPACITY;
+            stream.data.reset(new uint8_t[stream.capacity]);
+            glBindBuffer(GL_ARRAY_BUFFER, stream.buffer);
+            glBufferData(GL_ARRAY_BUFFER, stream.capacity, nullptr, GL_STREAM_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        // 기준 정점 번호로 그리므로 정점 시작 위치는 정점 크기의 배수여야 합니다.
+        const uint64_t vertexBegin = (stream.used + singleVertexSize - 1) / singleVertexSize * singleVertexSize;
+        const uint64_t indexBegin = (vertexBegin + (uint64_t)vertexCount * singleVertexSize + 3) & ~(uint64_t)3;
+        const uint64_t end = indexBegin + (uint64_t)indexCount * singleIndexSize;
+        if (end > stream.capacity) {
+            if (stream.demand <= stream.capacity) { LOGWITH("Stream buffer is full in this frame; capacity will grow from the next frame"); }
+            stream.demand += end - stream.used;
+            return {};
+        }
+        stream.demand += end - stream.used;
+        stream.used = end;
+        StreamGeometry ret;
+        ret.vertices = stream.data.get() + vertexBegin;
+        ret.indices = indexCount ? stream.data.get() + indexBegin : nullptr;
+        ret.vertexCount = vertexCount;
+        ret.indexCount = indexCount;
+        ret.vertexSize = singleVertexSize;
+        ret.vertexOffset = vertexBegin;
+        ret.indexOffset = indexBegin;
+        ret.frame = stream.frame;
+        ret.use32 = singleIndexSize == 4;
+        return ret;
     }
 
     void GLMachine::post(std::function<variant8(void)> exec, std::function<void(variant8)> handler, uint8_t strand) {
@@ -1109,13 +1184,22 @@ namespace onart {
     GLMachine::pUniformBuffer GLMachine::createUniformBuffer(int32_t key, const UniformBufferCreationOptions& opts) {
         if (pUniformBuffer ret = getUniformBuffer(key)) { return ret; }
 
+        uint32_t individual = 0;
+        size_t length = opts.size;
+        if (opts.count > 1) {
+            GLint alignment = 256;
+            glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+            individual = (uint32_t)((opts.size + alignment - 1) / alignment * alignment);
+            length = (size_t)individual * opts.count;
+        }
+
         unsigned ubo;
         glGenBuffers(1, &ubo);
         glBindBuffer(GL_UNIFORM_BUFFER, ubo);
-        glBufferData(GL_UNIFORM_BUFFER, opts.size, nullptr, GL_DYNAMIC_DRAW);
+        glBufferData(GL_UNIFORM_BUFFER, length, nullptr, GL_DYNAMIC_DRAW);
         glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
-        pUniformBuffer ret = std::make_shared<shp_t<UniformBuffer>>(opts.size, ubo);
+        pUniformBuffer ret = std::make_shared<shp_t<UniformBuffer>>(length, ubo, individual);
         if (key == INT32_MIN) return ret;
         return singleton->uniformBuffers[key] = std::move(ret);
     }
@@ -1349,6 +1433,7 @@ namespace onart {
     GLMachine::Pipeline::Pipeline(unsigned program, vec4 clearColor, unsigned vstr, unsigned istr) :program(program), clearColor(clearColor), vertexSize(vstr), instanceAttrStride(istr) {}
     GLMachine::Pipeline::~Pipeline() {
         glDeleteProgram(program);
+        if (streamVao) { glDeleteVertexArrays(1, &streamVao); }
     }
 
     void GLMachine::Pipeline::drop(int32_t key) {
@@ -1360,6 +1445,7 @@ namespace onart {
         glDeleteBuffers(1, &vb);
         glDeleteBuffers(1, &ib);
         if (vao) { glDeleteVertexArrays(1, &vao); }
+        if (streamVao) { glDeleteVertexArrays(1, &streamVao); }
     }
 
     void GLMachine::Mesh::update(const void* input, uint32_t offset, uint32_t size){
@@ -1478,7 +1564,8 @@ namespace onart {
             LOGWITH("Invalid call: render pass not begun");
             return;
         }
-        glBindBufferRange(GL_UNIFORM_BUFFER, pos, ub->ubo, 0, ub->length);
+        if (ub->individual) { glBindBufferRange(GL_UNIFORM_BUFFER, pos, ub->ubo, (GLintptr)ub->individual * ubPos, ub->individual); }
+        else { glBindBufferRange(GL_UNIFORM_BUFFER, pos, ub->ubo, 0, ub->length); }
     }
 
     void GLMachine::RenderPass::bind(uint32_t pos, const pTexture& tx) {
@@ -1626,6 +1713,52 @@ namespace onart {
         bound = mesh.get();
     }
 
+    void GLMachine::RenderPass::invoke(const StreamGeometry& geometry, uint32_t start, uint32_t count){
+        if(currentPass == -1){
+            LOGWITH("Invalid call: render pass not begun");
+            return;
+        }
+        auto& stream = singleton->stream;
+        if (!geometry || geometry.frame != stream.frame) {
+            LOGWITH("Invalid call: stream geometry is empty or was allocated in another frame");
+            return;
+        }
+        const uint64_t total = geometry.indexCount ? geometry.indexCount : geometry.vertexCount;
+        if ((uint64_t)start + count > total) {
+            LOGWITH("Invalid call: this geometry has", total, geometry.indexCount ? "indices but" : "vertices but", start, "~", (uint64_t)start + count, "requested to be drawn");
+            return;
+        }
+        if (count == 0) { count = uint32_t(total - start); }
+        singleton->flushStream();
+        Pipeline* p = pipelines[currentPass];
+        if (!p->streamVao) {
+            glCreateVertexArrays(1, &p->streamVao);
+            if (p->streamVao == 0) {
+                LOGWITH("Failed to create vertex array object");
+                return;
+            }
+            glBindVertexArray(p->streamVao);
+            glBindBuffer(GL_ARRAY_BUFFER, stream.buffer);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, stream.buffer);
+            for (uint32_t location = 0; location < p->vspec.size(); location++) {
+                enableAttribute(p->vertexSize, p->vspec[location]);
+            }
+            glBindVertexArray(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+        glBindVertexArray(p->streamVao);
+        const GLint baseVertex = (GLint)(geometry.vertexOffset / geometry.vertexSize);
+        if (geometry.indexCount) {
+            const uint32_t isize = geometry.use32 ? 4 : 2;
+            glDrawElementsBaseVertex(GL_TRIANGLES, count, geometry.use32 ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, (void*)(uintptr_t)(geometry.indexOffset + (uint64_t)start * isize), baseVertex);
+        }
+        else {
+            glDrawArrays(GL_TRIANGLES, baseVertex + start, count);
+        }
+        bound = nullptr;
+    }
+
     void GLMachine::RenderPass::invoke(const pMesh& mesh, const pMesh& instanceInfo, uint32_t instanceCount, uint32_t istart, uint32_t start, uint32_t count){
          if(currentPass == -1){
              LOGWITH("Invalid call: render pass not begun");
@@ -1668,7 +1801,7 @@ namespace onart {
              if(count == 0){
                  count = uint32_t(mesh->icount - start);
              }
-             glDrawElementsInstanced(GL_TRIANGLES, mesh->icount, mesh->idxType, mesh->idxType == GL_UNSIGNED_INT ? (void*)((uint32_t*)0 + start) : (void*)((uint16_t*)0 + start), instanceCount);
+             glDrawElementsInstancedBaseInstance(GL_TRIANGLES, count, mesh->idxType, mesh->idxType == GL_UNSIGNED_INT ? (void*)((uint32_t*)0 + start) : (void*)((uint16_t*)0 + start), instanceCount, istart);
          }
          else {
              if((uint64_t)start + count > mesh->vcount){
@@ -1679,11 +1812,65 @@ namespace onart {
              if(count == 0){
                  count = mesh->vcount - start;
              }
-             glDrawArraysInstanced(GL_TRIANGLES, start, count, instanceCount);
+             glDrawArraysInstancedBaseInstance(GL_TRIANGLES, start, count, instanceCount, istart);
          }
          bound = nullptr;
     }
 
+    void GLMachine::RenderPass::invoke(const pMesh& mesh, const StreamGeometry& instanceInfo, uint32_t instanceCount, uint32_t istart){
+        if(currentPass == -1){
+            LOGWITH("Invalid call: render pass not begun");
+            return;
+        }
+        auto& stream = singleton->stream;
+        if (!instanceInfo || instanceInfo.frame != stream.frame) {
+            LOGWITH("Invalid call: stream geometry is empty or was allocated in another frame");
+            return;
+        }
+        if ((uint64_t)istart + instanceCount > instanceInfo.vertexCount) {
+            LOGWITH("Invalid call: this geometry has", instanceInfo.vertexCount, "instances but", istart, "~", (uint64_t)istart + instanceCount, "requested to be drawn");
+            return;
+        }
+        Pipeline* p = pipelines[currentPass];
+        if (instanceInfo.vertexSize != p->instanceAttrStride) {
+            LOGWITH("Invalid call: instance size of the geometry does not match the pipeline");
+            return;
+        }
+        singleton->flushStream();
+        if (!mesh->streamVao) {
+            // 스트리밍 버퍼는 프레임마다 저장소만 바뀌고 이름은 유지되므로 VAO는 한 번만 만들고, 위치는 기준 인스턴스로 맞춥니다.
+            glCreateVertexArrays(1, &mesh->streamVao);
+            if (mesh->streamVao == 0) {
+                LOGWITH("Failed to create vertex array object");
+                return;
+            }
+            glBindVertexArray(mesh->streamVao);
+            glBindBuffer(GL_ARRAY_BUFFER, mesh->vb);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->ib);
+            uint32_t location = 0;
+            for (; location < p->vspec.size(); location++) {
+                enableAttribute(p->vertexSize, p->vspec[location]);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, stream.buffer);
+            for (uint32_t iloc = 0; iloc < p->ispec.size(); iloc++, location++) {
+                enableAttribute(p->instanceAttrStride, p->ispec[iloc]);
+                glVertexAttribDivisor(location, 1);
+            }
+            glBindVertexArray(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+        glBindVertexArray(mesh->streamVao);
+        const GLuint baseInstance = (GLuint)(instanceInfo.vertexOffset / instanceInfo.vertexSize) + istart;
+        if (mesh->icount) {
+            glDrawElementsInstancedBaseInstance(GL_TRIANGLES, (GLsizei)mesh->icount, mesh->idxType, nullptr, instanceCount, baseInstance);
+        }
+        else {
+            glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, (GLsizei)mesh->vcount, instanceCount, baseInstance);
+        }
+        bound = nullptr;
+    }
+
     void GLMachine::RenderPass::execute(...){
         if(currentPass != pipelines.size() - 1){
             LOGWITH("Renderpass not started. This message can be ignored safely if the rendering goes fine after now");
@@ -2201,8 +2388,13 @@ namespace onart {
     }
 
     void GLMachine::UniformBuffer::update(const void* input, uint32_t index, uint32_t offset, uint32_t size){
+        uint64_t begin = (uint64_t)individual * index + offset;
+        if (begin + size > length) {
+            LOGWITH("Requested buffer update range is invalid");
+            return;
+        }
         glBindBuffer(GL_UNIFORM_BUFFER, ubo);
-        glBufferSubData(GL_UNIFORM_BUFFER, offset, size, input);
+        glBufferSubData(GL_UNIFORM_BUFFER, (GLintptr)begin, size, input);
         glBindBuffer(GL_UNIFORM_BUFFER, 0);
     }
 
@@ -2212,7 +2404,7 @@ namespace onart {
 
     void GLMachine::UniformBuffer::resize(uint32_t size) {    }
 
-    GLMachine::UniformBuffer::UniformBuffer(uint32_t length, unsigned ubo) :length(length), ubo(ubo) {}
+    GLMachine::UniformBuffer::UniformBuffer(uint32_t length, unsigned ubo, uint32_t individual) :length(length), ubo(ubo), individual(individual) {}
 
     GLMachine::UniformBuffer::~UniformBuffer(){
         glDeleteBuffers(1, &ubo);
@@ -210,6 +210,23 @@ namespace onart {
             /// @param vcount 정점의 수
             /// @param name 프로그램 내에서 사용할 이름입니다.
             static pMesh createNullMesh(int32_t key, size_t vcount);
+            /// @brief 이번 프레임에만 쓸 정점/인덱스 공간입니다. 스프라이트, 글자, 디버그 선처럼 매 프레임 CPU에서 새로 만드는 기하에 사용합니다.
+            /// 다음 @ref handle 호출 이후에는 사용할 수 없습니다.
+            struct StreamGeometry {
+                void* vertices = nullptr; // 정점 데이터를 쓸 곳입니다. 그리기 전에 모두 써야 합니다.
+                void* indices = nullptr; // 인덱스 데이터를 쓸 곳입니다. 인덱스를 요청하지 않았으면 nullptr입니다.
+                uint32_t vertexCount = 0, indexCount = 0;
+                uint32_t vertexSize = 0;
+                uint64_t vertexOffset = 0, indexOffset = 0; // 스트리밍 버퍼 안의 위치(바이트)
+                uint32_t frame = 0;
+                bool use32 = false;
+                inline operator bool() const { return vertices != nullptr; }
+            };
+            /// @brief 프레임마다 비워지는 스트리밍 버퍼에서 정점/인덱스 공간을 할당합니다. 메시 생성 없이 바로 쓰고 RenderPass::invoke(const StreamGeometry&)로 그릴 수 있습니다.
+            /// 내용은 그릴 때 아직 올리지 않은 부분만 한 번에 올리며, 버퍼는 프레임마다 새 저장소로 교체(orphaning)되므로 이전 프레임의 그리기를 기다리지 않습니다.
+            /// 프레임당 용량을 넘으면 빈 객체를 리턴하며, 다음 프레임부터 그만큼 용량이 늘어납니다.
+            /// @param singleIndexSize 2 또는 4
+            static StreamGeometry allocateStreamGeometry(uint32_t vertexCount, uint32_t singleVertexSize, uint32_t indexCount = 0, uint32_t singleIndexSize = 2);
             /// @brief 만들어 둔 렌더패스를 리턴합니다. 없으면 nullptr를 리턴합니다.
             static pRenderPass2Screen getRenderPass2Screen(int32_t key);
             /// @brief 만들어 둔 렌더패스를 리턴합니다. 없으면 nullptr를 리턴합니다.
@@ -273,6 +290,10 @@ namespace onart {
             static RenderTarget* createRenderTarget2D(int width, int height, RenderTargetType type, bool useDepthInput, bool linear);
             /// @brief vulkan 객체를 없앱니다.
             void free();
+            /// @brief 스트리밍 버퍼의 다음 프레임으로 넘어갑니다.
+            void advanceStream();
+            /// @brief 스트리밍 버퍼에서 아직 올리지 않은 부분을 올립니다.
+            void flushStream();
             ~GLMachine();
             /// @brief 이 클래스 객체는 Game 밖에서는 생성, 소멸 호출이 불가능합니다.
             inline void operator delete(void* p){::operator delete(p);}
@@ -291,6 +312,15 @@ namespace onart {
             std::map<int32_t, pTextureSet> textureSets;
             std::map<int32_t, WindowSystem*> windowSystems;
             bool vsync = true;
+            struct {
+                unsigned buffer = 0;
+                std::unique_ptr<uint8_t[]> data; // 이번 프레임 내용. 할당한 포인터가 유지되도록 프레임 중에는 크기를 바꾸지 않습니다.
+                uint64_t capacity = 0;
+                uint64_t used = 0;
+                uint64_t uploaded = 0;
+                uint64_t demand = 0; // 이번 프레임에 요청된 양. 할당에 실패한 것도 포함
+                uint32_t frame = 0;
+            } stream;
 
             std::mutex textureGuard;
 
@@ -391,6 +421,14 @@ namespace onart {
             /// @param start 정점 시작 위치 (주어진 메시에 인덱스 버퍼가 있는 경우 그것을 기준으로 합니다.)
             /// @param count 정점 수. 0이 주어진 경우 주어진 start부터 끝까지 그립니다.
             void invoke(const pMesh& mesh, const pMesh& instanceInfo, uint32_t instanceCount, uint32_t istart = 0, uint32_t start = 0, uint32_t count = 0);
+            /// @brief allocateStreamGeometry()로 할당하여 채운 기하를 그립니다. 정점 사양은 파이프라인과 맞아야 하며, 할당한 프레임에만 사용할 수 있습니다.
+            /// @param start 정점 시작 위치 (인덱스를 할당한 경우 그것을 기준으로 합니다.)
+            /// @param count 정점 수. 0이 주어진 경우 주어진 start부터 끝까지 그립니다.
+            void invoke(const StreamGeometry& geometry, uint32_t start = 0, uint32_t count = 0);
+            /// @brief 인스턴스 속성을 allocateStreamGeometry()로 할당한 기하에서 읽어 메시를 그립니다. 매 프레임 CPU에서 새로 만드는 인스턴스 데이터를 메시 갱신 없이 그리는 데 사용합니다.
+            /// @param instanceInfo 인스턴스 속성만 담은 기하. 인덱스는 사용하지 않으며, 할당한 프레임에만 사용할 수 있습니다.
+            /// @param istart instanceInfo 안의 인스턴스 시작 위치
+            void invoke(const pMesh& mesh, const StreamGeometry& instanceInfo, uint32_t instanceCount, uint32_t istart = 0);
             /// @brief 현재 서브패스의 타겟을 클리어합니다.
             /// @param toClear 실제로 클리어할 타겟을 명시합니다.
             /// @param colors 초기화할 색상을 앞에서부터 차례대로 (r, g, b, a) 명시합니다. depth/stencil 타겟은 각각 고정 1 / 0으로 클리어됩니다.
@@ -595,6 +633,7 @@ namespace onart {
             AlphaBlend blendOperation[3];
             Culling cullMode;
             float blendConstant[4];
+            unsigned streamVao = 0; // 스트리밍 버퍼를 이 파이프라인의 정점 사양으로 읽는 VAO
     };
 
     class GLMachine::Mesh{
@@ -619,6 +658,7 @@ namespace onart {
             Mesh(unsigned vb, unsigned ib, size_t vcount, size_t icount, bool use32);
             ~Mesh();
             unsigned vb, ib, vao{};
+            unsigned streamVao{}; // 인스턴스 속성을 스트리밍 버퍼에서 읽는 VAO
             size_t vcount, icount;
             unsigned idxType;
     };
@@ -632,10 +672,12 @@ namespace onart {
             void resize(uint32_t size);
             /// @brief 유니폼 버퍼의 내용을 갱신합니다. 넘치게 데이터를 줘도 추가 할당은 하지 않으므로 주의하세요.
             /// @param input 입력 데이터
-            /// @param index 사용되지 않습니다.
-            /// @param offset 데이터 내에서 몇 바이트째부터 수정할지
-            /// @param size 덮어쓸 양
+            /// @param index 동적 유니폼 버퍼인 경우 갱신할 항목 번호입니다. 동적 유니폼 버퍼가 아니면 사용되지 않습니다.
+            /// @param offset 데이터 내에서 몇 바이트째부터 수정할지 (index번째 항목의 시작 기준)
+            /// @param size 덮어쓸 양. 여러 항목에 걸쳐도 되므로 여러 항목을 한 번에 갱신할 수 있습니다.
             void update(const void* input, uint32_t index, uint32_t offset, uint32_t size);
+            /// @brief 동적 유니폼 버퍼의 항목 간격(바이트)을 리턴합니다. 동적 유니폼 버퍼가 아니면 0을 리턴합니다.
+            inline uint32_t getStride() const { return individual; }
             /// @brief 0을 리턴합니다.
             uint16_t getIndex();
             /// @brief 0을 리턴합니다.
@@ -643,12 +685,13 @@ namespace onart {
             /// @brief 128바이트 크기의 고정 유니폼버퍼를 업데이트합니다. 이것은 모든 파이프라인이 공유하며, 셰이더의 바인딩 11번으로 접근할 수 있습니다.
             static void updatePush(const void* input, uint32_t offset, uint32_t size);
         protected:
-            UniformBuffer(uint32_t length, unsigned ubo);
+            UniformBuffer(uint32_t length, unsigned ubo, uint32_t individual = 0);
             ~UniformBuffer();
         private:
             unsigned ubo;
             bool shouldSync = false;
             uint32_t length;
+            uint32_t individual; // 동적 유니폼 버퍼 항목 간격 (동적이 아니면 0)
     };
 
     template<class FATTR, class... ATTR>
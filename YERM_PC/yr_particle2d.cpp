@@ -0,0 +1,152 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "yr_particle2d.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace onart {
+
+    ParticleSystem2D::ParticleSystem2D(uint32_t capacity): capacity(capacity) {
+        // SIMD 경로가 끝부분도 4개 단위로 읽고 쓰도록 4의 배수로 올려 둡니다.
+        const size_t lanes = ((size_t)capacity + 3) & ~(size_t)3;
+        storage.reset(new float[lanes * 10]());
+        float* p = storage.get();
+        float** arrays[] = { &px, &py, &vx, &vy, &angle, &spin, &age, &invLife, &size0, &size1 };
+        for (float** a : arrays) {
+            *a = p;
+            p += lanes;
+        }
+        instances.resize(lanes);
+    }
+
+    bool ParticleSystem2D::emit(const Particle2DParams& params) {
+        if (count >= capacity) return false;
+        const uint32_t i = count++;
+        px[i] = params.position[0];
+        py[i] = params.position[1];
+        vx[i] = params.velocity[0];
+        vy[i] = params.velocity[1];
+        angle[i] = params.angle;
+        spin[i] = params.spin;
+        age[i] = 0;
+        invLife[i] = params.life > 0 ? 1.0f / params.life : FLT_MAX;
+        size0[i] = params.startSize;
+        size1[i] = params.endSize;
+        return true;
+    }
+
+    void ParticleSystem2D::setTexture(const YRGraphics::pTexture& texture, uint32_t columns, uint32_t rows, uint32_t frameCount) {
+        this->texture = texture;
+        this->columns = columns ? columns : 1;
+        this->rows = rows ? rows : 1;
+        this->frameCount = frameCount ? (frameCount > this->columns * this->rows ? this->columns * this->rows : frameCount) : 1;
+    }
+
+    void ParticleSystem2D::clear() {
+        count = 0;
+        updatedCount = 0;
+    }
+
+    void ParticleSystem2D::compact() {
+        for (uint32_t i = 0; i < count;) {
+            if (age[i] * invLife[i] < 1.0f) {
+                i++;
+                continue;
+            }
+            const uint32_t last = --count;
+            px[i] = px[last]; py[i] = py[last];
+            vx[i] = vx[last]; vy[i] = vy[last];
+            angle[i] = angle[last]; spin[i] = spin[last];
+            age[i] = age[last]; invLife[i] = invLife[last];
+            size0[i] = size0[last]; size1[i] = size1[last];
+        }
+    }
+
+    void ParticleSystem2D::updateRange(uint32_t begin, uint32_t end, float dt, float damping) {
+        const float128 vdt = load(dt), vdamp = load(damping);
+        const float128 gx = load(gravity[0] * dt), gy = load(gravity[1] * dt);
+        const float128 zero = zerof128(), one = load(1.0f);
+        const float iw = 1.0f / columns, ih = 1.0f / rows;
+        alignas(16) float t4[4];
+        for (uint32_t i = begin; i < end; i += 4) {
+            const float128 x = mul(add(loadu(vx + i), gx), vdamp);
+            const float128 y = mul(add(loadu(vy + i), gy), vdamp);
+            const float128 posX = add(loadu(px + i), mul(x, vdt));
+            const float128 posY = add(loadu(py + i), mul(y, vdt));
+            const float128 rot = add(loadu(angle + i), mul(loadu(spin + i), vdt));
+            const float128 a = add(loadu(age + i), vdt);
+            storeu(x, vx + i);
+            storeu(y, vy + i);
+            storeu(posX, px + i);
+            storeu(posY, py + i);
+            storeu(rot, angle + i);
+            storeu(a, age + i);
+
+            // 수명이 다한 파티클은 크기 0으로 그리고 다음 update()에서 지웁니다.
+            const float128 rawT = mul(a, loadu(invLife + i));
+            const float128 t = min(rawT, one);
+            const float128 s0 = loadu(size0 + i);
+            const float128 size = select(cmplt(rawT, one), add(s0, mul(sub(loadu(size1 + i), s0), t)), zero);
+            float128 sn, cs;
+            sincos(rot, sn, cs);
+
+            // 성분별 벡터를 전치하여 파티클별 모델 행렬 행으로 만듭니다.
+            float128 r00 = mul(cs, size), r01 = neg(mul(sn, size)), r02 = zero, r03 = posX;
+            float128 r10 = mul(sn, size), r11 = mul(cs, size), r12 = zero, r13 = posY;
+            transpose4(r00, r01, r02, r03);
+            transpose4(r10, r11, r12, r13);
+            const float128 row0[4] = { r00, r01, r02, r03 };
+            const float128 row1[4] = { r10, r11, r12, r13 };
+            store(t, t4);
+            const uint32_t lanes = end - i < 4 ? end - i : 4;
+            for (uint32_t k = 0; k < lanes; k++) {
+                SpriteInstance& inst = instances[i + k];
+                storeu(row0[k], inst.model);
+                storeu(row1[k], inst.model + 4);
+                inst.model[8] = 0; inst.model[9] = 0; inst.model[10] = 1; inst.model[11] = 0;
+                uint32_t frame = (uint32_t)(t4[k] * frameCount);
+                if (frame >= frameCount) { frame = frameCount - 1; }
+                inst.texrect[0] = iw;
+                inst.texrect[1] = ih;
+                inst.texrect[2] = (frame % columns) * iw;
+                inst.texrect[3] = (frame / columns) * ih;
+            }
+        }
+    }
+
+    void ParticleSystem2D::update(float dt) {
+        compact();
+        updateRange(0, (count + 3) & ~3u, dt, std::exp(-drag * dt));
+        updatedCount = count;
+    }
+
+    void ParticleSystem2D::update(float dt, ThreadPool& pool, uint32_t grain) {
+        compact();
+        grain = (grain + 3) & ~3u;
+        if (grain == 0) { grain = 4; }
+        const uint32_t end = (count + 3) & ~3u;
+        const float damping = std::exp(-drag * dt);
+        updatedCount = count;
+        // 조각 경계가 grain의 배수이므로 4개 단위 SIMD 처리가 조각 사이에 걸치지 않습니다.
+        pool.parallelFor(0, end, grain, [this, dt, damping](uint32_t cb, uint32_t ce) { updateRange(cb, ce, dt, damping); });
+    }
+
+    void ParticleSystem2D::draw(SpriteBatch& batch) const {
+        if (updatedCount == 0 || !texture) return;
+        SpriteInstance* dst = batch.allocate(updatedCount, texture, color);
+        std::memcpy(dst, instances.data(), sizeof(SpriteInstance) * updatedCount);
+    }
+}
@@ -0,0 +1,85 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef __YR_PARTICLE2D_H__
+#define __YR_PARTICLE2D_H__
+
+#include "yr_2d.h"
+#include "yr_threadpool.hpp"
+
+#include <memory>
+
+namespace onart {
+
+    /// @brief 파티클 1개의 초기 상태입니다.
+    struct Particle2DParams {
+        vec2 position;
+        vec2 velocity;
+        float life = 1; // 수명(초)
+        float startSize = 1; // 생성 시 반 길이. 기본 사각형(-1~1)에 곱해집니다.
+        float endSize = 1; // 수명이 다할 때의 반 길이
+        float angle = 0; // 회전(라디안)
+        float spin = 0; // 초당 회전(라디안)
+    };
+
+    /// @brief 2D 파티클을 성분별 배열(SoA)로 보관하고 4개씩 SIMD로 갱신합니다. 갱신과 함께 get2DInstancedPipeline()의 인스턴스 속성(SpriteInstance)을 만들어 두므로
+    /// 그릴 때는 SpriteBatch에 복사만 하며, 시스템 하나가 인스턴스 드로우 1회로 그려집니다. 파티클마다 Transform이나 VisualElement를 만들지 않습니다.
+    class ParticleSystem2D {
+        public:
+            /// @param capacity 최대 파티클 수
+            ParticleSystem2D(uint32_t capacity);
+            /// @brief 파티클을 하나 추가합니다. 최대 수에 도달했으면 false를 리턴합니다.
+            bool emit(const Particle2DParams& params);
+            /// @brief 수명이 다한 파티클을 지우고 남은 파티클을 dt초만큼 진행시킵니다.
+            void update(float dt);
+            /// @brief update(float)와 같은 결과를 스레드 풀을 이용하여 계산합니다. 파티클을 grain개씩 나누어 ThreadPool::parallelFor()로 처리하고 모두 끝나기를 기다립니다.
+            /// 파티클 수가 grain 이하이면 호출 스레드에서 바로 처리합니다.
+            /// @param grain 작업 하나가 맡는 파티클 수. 4의 배수로 올림됩니다.
+            void update(float dt, ThreadPool& pool, uint32_t grain = 4096);
+            /// @brief 마지막 update() 결과를 배치에 추가합니다.
+            void draw(SpriteBatch& batch) const;
+            /// @brief 모든 파티클을 지웁니다.
+            void clear();
+            /// @brief 초당 가속도를 설정합니다.
+            inline void setGravity(const vec2& g) { gravity = g; }
+            /// @brief 감쇠 계수를 설정합니다. 속도가 매초 exp(-drag)배가 됩니다.
+            inline void setDrag(float drag) { this->drag = drag; }
+            /// @brief 텍스처와 플립북 구성을 설정합니다. 플립북은 columns x rows 격자의 앞 frameCount칸을 수명에 걸쳐 차례로 보여 줍니다.
+            void setTexture(const YRGraphics::pTexture& texture, uint32_t columns = 1, uint32_t rows = 1, uint32_t frameCount = 1);
+            /// @brief 텍스처에 곱할 색을 설정합니다. 시스템 전체에 공통입니다.
+            inline void setColor(const vec4& color) { this->color = color; }
+            inline size_t size() const { return count; }
+            inline size_t getCapacity() const { return capacity; }
+        private:
+            /// @brief [begin, end) 범위의 파티클을 진행시키고 인스턴스 속성을 씁니다. begin은 4의 배수여야 합니다.
+            void updateRange(uint32_t begin, uint32_t end, float dt, float damping);
+            /// @brief 수명이 다한 파티클을 마지막 파티클로 덮어 지웁니다.
+            void compact();
+            std::unique_ptr<float[]> storage; // 아래 성분 배열들이 나누어 씁니다.
+            float* px; float* py;
+            float* vx; float* vy;
+            float* angle; float* spin;
+            float* age; float* invLife;
+            float* size0; float* size1;
+            std::vector<SpriteInstance> instances;
+            YRGraphics::pTexture texture;
+            vec4 color = vec4(1);
+            vec2 gravity;
+            float drag = 0;
+            uint32_t columns = 1, rows = 1, frameCount = 1;
+            uint32_t count = 0, capacity;
+            uint32_t updatedCount = 0; // 마지막 update()에서 인스턴스 속성을 쓴 파티클 수
+    };
+}
+
+#endif
@@ -0,0 +1,152 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef __YR_RECTPACK_HPP__
+#define __YR_RECTPACK_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace onart {
+
+    /// @brief 직사각형 영역 하나에 작은 직사각형들을 겹치지 않게 배치합니다. (MaxRects, 짧은 변 기준 최적 배치)
+    /// 그래픽스와 무관하므로 런타임 아틀라스와 오프라인 도구에서 모두 사용할 수 있습니다.
+    class RectPacker {
+    public:
+        struct Rect {
+            uint32_t x, y, width, height;
+        };
+        inline RectPacker(uint32_t width = 0, uint32_t height = 0) { reset(width, height); }
+        /// @brief 모든 배치를 지우고 주어진 크기의 빈 영역으로 만듭니다.
+        inline void reset(uint32_t width, uint32_t height) {
+            this->width = width;
+            this->height = height;
+            used = 0;
+            freeRects.clear();
+            if (width && height) { freeRects.push_back({ 0, 0, width, height }); }
+        }
+        /// @brief 주어진 크기의 영역을 배치합니다. 자리가 없으면 false를 리턴하며 아무것도 바뀌지 않습니다.
+        /// @param out 배치된 위치
+        inline bool insert(uint32_t w, uint32_t h, Rect& out) {
+            if (w == 0 || h == 0) return false;
+            size_t best = freeRects.size();
+            uint32_t bestShort = UINT32_MAX, bestLong = UINT32_MAX;
+            for (size_t i = 0; i < freeRects.size(); i++) {
+                const Rect& f = freeRects[i];
+                if (f.width < w || f.height < h) continue;
+                uint32_t dw = f.width - w, dh = f.height - h;
+                uint32_t s = dw < dh ? dw : dh, l = dw < dh ? dh : dw;
+                if (s < bestShort || (s == bestShort && l < bestLong)) {
+                    best = i;
+                    bestShort = s;
+                    bestLong = l;
+                }
+            }
+            if (best == freeRects.size()) return false;
+            out = { freeRects[best].x, freeRects[best].y, w, h };
+            place(out);
+            return true;
+        }
+        /// @brief 주어진 위치를 그대로 배치합니다. 빈 영역 하나에 완전히 들어가지 않으면 false를 리턴하며 아무것도 바뀌지 않습니다. 이전 배치를 복원할 때 사용합니다.
+        inline bool occupy(const Rect& r) {
+            if (r.width == 0 || r.height == 0) return false;
+            for (const Rect& f : freeRects) {
+                if (contains(f, r)) {
+                    place(r);
+                    return true;
+                }
+            }
+            return false;
+        }
+        /// @brief 배치했던 영역을 다시 비웁니다. 인접한 빈 영역과 변 전체가 맞닿으면 합칩니다.
+        inline void remove(const Rect& r) {
+            used -= (uint64_t)r.width * r.height;
+            Rect merged = r;
+            for (bool changed = true; changed;) {
+                changed = false;
+                for (size_t i = 0; i < freeRects.size(); i++) {
+                    const Rect& f = freeRects[i];
+                    bool horizontal = f.y == merged.y && f.height == merged.height && (f.x + f.width == merged.x || merged.x + merged.width == f.x);
+                    bool vertical = f.x == merged.x && f.width == merged.width && (f.y + f.height == merged.y || merged.y + merged.height == f.y);
+                    if (horizontal) {
+                        merged.x = f.x < merged.x ? f.x : merged.x;
+                        merged.width += f.width;
+                    }
+                    else if (vertical) {
+                        merged.y = f.y < merged.y ? f.y : merged.y;
+                        merged.height += f.height;
+                    }
+                    else continue;
+                    freeRects[i] = freeRects.back();
+                    freeRects.pop_back();
+                    changed = true;
+                    break;
+                }
+            }
+            freeRects.push_back(merged);
+            prune(freeRects.size() - 1);
+        }
+        /// @brief 전체 면적 중 배치된 면적의 비율을 리턴합니다.
+        inline float occupancy() const { return width && height ? (float)((double)used / ((double)width * height)) : 0.0f; }
+        inline uint32_t getWidth() const { return width; }
+        inline uint32_t getHeight() const { return height; }
+        inline bool empty() const { return used == 0; }
+    private:
+        /// @brief r을 배치된 영역으로 표시하고, 그와 겹치는 빈 영역을 최대 4개의 빈 영역으로 나눕니다.
+        inline void place(const Rect& r) {
+            used += (uint64_t)r.width * r.height;
+            const size_t count = freeRects.size();
+            for (size_t i = 0; i < count; i++) {
+                Rect f = freeRects[i];
+                if (r.x >= f.x + f.width || r.x + r.width <= f.x || r.y >= f.y + f.height || r.y + r.height <= f.y) continue;
+                if (r.x > f.x) { freeRects.push_back({ f.x, f.y, r.x - f.x, f.height }); }
+                if (r.x + r.width < f.x + f.width) { freeRects.push_back({ r.x + r.width, f.y, f.x + f.width - (r.x + r.width), f.height }); }
+                if (r.y > f.y) { freeRects.push_back({ f.x, f.y, f.width, r.y - f.y }); }
+                if (r.y + r.height < f.y + f.height) { freeRects.push_back({ f.x, r.y + r.height, f.width, f.y + f.height - (r.y + r.height) }); }
+                freeRects[i].width = 0; // 아래 prune에서 지워짐
+            }
+            prune(count);
+        }
+        /// @brief 크기가 0이거나 다른 빈 영역에 완전히 포함되는 빈 영역을 지웁니다. firstNew 이전의 영역끼리는 이미 서로 포함하지 않으므로 새 영역이 관련된 쌍만 비교합니다.
+        inline void prune(size_t firstNew) {
+            const size_t count = freeRects.size();
+            for (size_t i = firstNew; i < count; i++) {
+                Rect& r = freeRects[i];
+                if (r.width == 0 || r.height == 0) continue;
+                for (size_t j = 0; j < count; j++) {
+                    Rect& other = freeRects[j];
+                    if (i == j || other.width == 0 || other.height == 0) continue;
+                    if (contains(other, r)) {
+                        r.width = 0;
+                        break;
+                    }
+                    if (j < firstNew && contains(r, other)) { other.width = 0; }
+                }
+            }
+            size_t n = 0;
+            for (size_t i = 0; i < count; i++) {
+                if (freeRects[i].width && freeRects[i].height) { freeRects[n++] = freeRects[i]; }
+            }
+            freeRects.resize(n);
+        }
+        inline static bool contains(const Rect& outer, const Rect& inner) {
+            return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.width <= outer.x + outer.width && inner.y + inner.height <= outer.y + outer.height;
+        }
+        std::vector<Rect> freeRects;
+        uint64_t used;
+        uint32_t width, height;
+    };
+}
+
+#endif
@@ -1,56 +1,174 @@
 #include "yr_scene.h"
+#include "logger.hpp"
 #include <cfloat>
+#include <algorithm>
+#include <mutex>
 
 namespace onart {
 
+    /// @brief Transform 전용 슬랩 할당기입니다. 블록을 BLOCK_SIZE 단위로 정렬해 두어 포인터만으로 소속 블록을 찾을 수 있습니다.
+    class TransformSlab {
+    public:
+        static constexpr size_t BLOCK_SIZE = 64 * 1024;
+        static constexpr size_t HEADER_SIZE = 64;
+        static constexpr size_t SLOT_SIZE = (sizeof(Transform) + 15) & ~(size_t)15;
+        static constexpr size_t SLOTS_PER_BLOCK = (BLOCK_SIZE - HEADER_SIZE) / SLOT_SIZE;
+        inline void* allocate(const void* near) {
+            std::unique_lock<std::mutex> _(guard);
+            Block* block = near ? blockOf(near) : nullptr;
+            if (!block || !block->free) {
+                while (!available.empty() && !available.back()->free) {
+                    available.back()->inAvailable = false;
+                    available.pop_back();
+                }
+                if (available.empty()) {
+                    Block* fresh = newBlock();
+                    fresh->inAvailable = true;
+                    available.push_back(fresh);
+                }
+                block = available.back();
+            }
+            FreeSlot* slot = block->free;
+            block->free = slot->next;
+            return slot;
+        }
+        inline void deallocate(void* p) {
+            std::unique_lock<std::mutex> _(guard);
+            Block* block = blockOf(p);
+            if (!block->inAvailable) {
+                block->inAvailable = true;
+                available.push_back(block);
+            }
+            FreeSlot* slot = reinterpret_cast<FreeSlot*>(p);
+            slot->next = block->free;
+            block->free = slot;
+        }
+        inline ~TransformSlab() {
+            for (Block* block : blocks) { aligned_free(block); }
+        }
+    private:
+        struct FreeSlot { FreeSlot* next; };
+        struct Block {
+            FreeSlot* free;
+            bool inAvailable; // available에 들어 있는지 여부. 같은 블록이 여러 번 들어가지 않도록 함
+        };
+        static inline Block* blockOf(const void* p) { return reinterpret_cast<Block*>((uintptr_t)p & ~(uintptr_t)(BLOCK_SIZE - 1)); }
+        inline Block* newBlock() {
+            Block* block = reinterpret_cast<Block*>(aligned_malloc(BLOCK_SIZE, BLOCK_SIZE));
+            uint8_t* first = reinterpret_cast<uint8_t*>(block) + HEADER_SIZE;
+            // 앞쪽 슬롯부터 나가도록 역순으로 연결
+            block->free = nullptr;
+            block->inAvailable = false;
+            for (size_t i = SLOTS_PER_BLOCK; i > 0; i--) {
+                FreeSlot* slot = reinterpret_cast<FreeSlot*>(first + (i - 1) * SLOT_SIZE);
+                slot->next = block->free;
+                block->free = slot;
+            }
+            blocks.push_back(block);
+            return block;
+        }
+        std::vector<Block*> blocks;
+        std::vector<Block*> available; // 빈 슬롯이 있을 수 있는 블록
+        std::mutex guard;
+    };
+
+    static TransformSlab& transformSlab() {
+        static TransformSlab slab;
+        return slab;
+    }
+
+    void* Transform::operator new(size_t size, Transform* near) {
+        if (size != sizeof(Transform)) { return ::operator new(size); }
+        return transformSlab().allocate(near);
+    }
+
+    void Transform::operator delete(void* p, size_t size) {
+        if (!p) return;
+        if (size != sizeof(Transform)) { ::operator delete(p); return; }
+        transformSlab().deallocate(p);
+    }
+
+    void Transform::link(Transform* p) {
+        parent = p;
+        nextSibling = nullptr;
+        prevSibling = p->lastChild;
+        if (prevSibling) { prevSibling->nextSibling = this; }
+        else { p->firstChild = this; }
+        p->lastChild = this;
+    }
+
+    void Transform::unlink() {
+        if (prevSibling) { prevSibling->nextSibling = nextSibling; }
+        else if (parent) { parent->firstChild = nextSibling; }
+        if (nextSibling) { nextSibling->prevSibling = prevSibling; }
+        else if (parent) { parent->lastChild = prevSibling; }
+        prevSibling = nextSibling = nullptr;
+        parent = nullptr;
+    }
+
     void Transform::setLocalDirty() {
         dirty = true;
-        setGlobalDirty();
+        globalDirty = true;
+        root->epoch++;
     }
 
-    void Transform::setGlobalDirty() {
-        if (!globalDirty) {
-            globalDirty = true;
-            for (Transform* child : children) {
-                child->setGlobalDirty();
-            }
+    void Transform::setRoot(Transform* r) {
+        // 재귀 없이 하위 트리를 전위 순회
+        Transform* node = this;
+        while (node) {
+            node->root = r;
+            node->validEpoch = 0;
+            if (node->firstChild) { node = node->firstChild; continue; }
+            while (node != this && !node->nextSibling) { node = node->parent; }
+            node = node == this ? nullptr : node->nextSibling;
         }
     }
 
     Transform* Transform::create(Transform* parent) {
-        Transform* newTr = new Transform;
-        if (!parent) { return newTr; }
-        newTr->parent = parent;
-        newTr->bro = parent->children.size();
-        parent->children.push_back(newTr);
+        Transform* newTr = new (parent) Transform;
+        if (parent) {
+            newTr->link(parent);
+            newTr->root = parent->root;
+        }
         return newTr;
     }
 
     Transform::~Transform() {
-        if (parent) {
-            parent->children.back()->bro = bro;
-            parent->children[bro] = parent->children.back();
-            parent->children.pop_back();
-        }
-        for (Transform* child : children) {
+        if (parent) { unlink(); }
+        while (firstChild) {
+            Transform* child = firstChild;
+            firstChild = child->nextSibling;
             child->parent = nullptr;
             delete child;
         }
     }
 
     const mat4& Transform::getGlobalTransform() {
-        if (!parent) return getLocalTransform();
-        if (globalDirty) {
-            globalTransform = parent->getGlobalTransform() * getLocalTransform();
+        if (!parent) {
+            if (globalDirty) {
+                globalDirty = false;
+                version++;
+            }
+            validEpoch = epoch;
+            return getLocalTransform();
+        }
+        if (validEpoch == root->epoch) return globalTransform;
+        const mat4& parentTransform = parent->getGlobalTransform();
+        if (globalDirty || parentVersion != parent->version) {
+            globalTransform = parentTransform * getLocalTransform();
+            parentVersion = parent->version;
             globalDirty = false;
+            version++;
         }
+        validEpoch = root->epoch;
         return globalTransform;
     }
 
     void Transform::setGlobalPosition(const vec3& pos) {
         if (!parent) return setPosition(pos);
-        setGlobalDirty();
         getGlobalTransform();
+        version++;
+        root->epoch++;
         globalTransform._14 = pos.x;
         globalTransform._24 = pos.y;
         globalTransform._34 = pos.z;
@@ -72,8 +190,7 @@ namespace onart {
     }
 
     vec3 Transform::getGlobalPosition() {
-        getGlobalTransform();
-        return globalTransform.col(3).xyz();
+        return getGlobalTransform().col(3).xyz();
     }
 
     Quaternion Transform::getGlobalRotation() {
@@ -85,22 +202,20 @@ namespace onart {
         if (p == this) p = nullptr;
         else if (parent == p) return;
 
-        setGlobalDirty();
-        getGlobalTransform();
-        parent->children.back()->bro = bro;
-        parent->children[bro] = parent->children.back();
-        parent->children.pop_back();
+        const mat4 global = getGlobalTransform();
+        if (parent) { unlink(); }
+        globalDirty = true;
+        // 옮겨진 하위 트리의 검증 결과는 새 루트의 세대와 무관하므로 모두 지움
+        setRoot(p ? p->root : this);
+        root->epoch++;
 
-        parent = p;
-        if (parent) { 
-            bro = parent->children.size();
-            parent->children.push_back(this);
+        if (p) { 
+            link(p);
             const mat4& parentTransform = parent->getGlobalTransform();
-            localTransform = parentTransform.affineInverse() * globalTransform;
+            localTransform = parentTransform.affineInverse() * global;
         }
         else { 
-            bro = 0;
-            localTransform = globalTransform;
+            localTransform = global;
         }
 
         mat2prs();
@@ -133,4 +248,180 @@ namespace onart {
             localRotation.c1 = sqrtf(cos2);
         }
     }
+
+    TransformHandle TransformHierarchy::create(TransformHandle p) {
+        uint32_t slot;
+        if (freeSlots.empty()) {
+            slot = (uint32_t)slots.size();
+            slots.emplace_back();
+        }
+        else {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        const uint32_t dense = (uint32_t)parent.size();
+        int32_t parentDense = isValid(p) ? (int32_t)slots[p.index].dense : -1;
+        uint32_t d = parentDense >= 0 ? depth[parentDense] + 1 : 0;
+        if (dense && depth.back() > d) { orderDirty = true; }
+        else if (d + 1 < levelBegin.size()) { levelBegin.back()++; }
+        else { levelBegin.push_back(levelBegin.back() + 1); }
+        slots[slot].dense = dense;
+        position.emplace_back(0.0f);
+        rotation.emplace_back();
+        scale.emplace_back(1.0f);
+        local.emplace_back();
+        global.emplace_back();
+        parent.push_back(parentDense);
+        depth.push_back(d);
+        slotOf.push_back(slot);
+        flags.push_back(LOCAL_DIRTY);
+        return { slot, slots[slot].generation };
+    }
+
+    void TransformHierarchy::kill(uint32_t dense) {
+        flags[dense] = DEAD;
+        Slot& slot = slots[slotOf[dense]];
+        slot.dense = UINT32_MAX;
+        slot.generation++;
+        freeSlots.push_back(slotOf[dense]);
+        deadCount++;
+    }
+
+    void TransformHierarchy::destroy(TransformHandle node) {
+        if (!isValid(node)) { return; }
+        kill(slots[node.index].dense);
+    }
+
+    bool TransformHierarchy::setParent(TransformHandle node, TransformHandle p) {
+        if (!isValid(node)) { return false; }
+        const int32_t dense = (int32_t)slots[node.index].dense;
+        int32_t parentDense = isValid(p) ? (int32_t)slots[p.index].dense : -1;
+        for (int32_t i = parentDense; i >= 0; i = parent[i]) {
+            if (i == dense) {
+                LOGWITH("Invalid call: the given parent is a descendant of the node");
+                return false;
+            }
+        }
+        parent[dense] = parentDense;
+        flags[dense] |= LOCAL_DIRTY;
+        orderDirty = true;
+        return true;
+    }
+
+    TransformHandle TransformHierarchy::getParent(TransformHandle node) const {
+        if (!isValid(node)) { return {}; }
+        int32_t p = parent[slots[node.index].dense];
+        if (p < 0) { return {}; }
+        return { slotOf[p], slots[slotOf[p]].generation };
+    }
+
+    void TransformHierarchy::rebuild() {
+        const uint32_t count = (uint32_t)parent.size();
+        // 부모가 뒤에 있을 수 있으므로 깊이를 위로 거슬러 올라가며 계산. 죽은 노드의 하위 노드는 함께 죽음
+        constexpr uint32_t UNKNOWN = UINT32_MAX;
+        std::vector<uint32_t> newDepth(count, UNKNOWN);
+        std::vector<uint32_t> chain;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t cur = i;
+            while (newDepth[cur] == UNKNOWN && !(flags[cur] & DEAD) && parent[cur] >= 0) {
+                chain.push_back(cur);
+                cur = (uint32_t)parent[cur];
+            }
+            bool dead = flags[cur] & DEAD;
+            uint32_t d = dead ? 0 : (newDepth[cur] == UNKNOWN ? (newDepth[cur] = 0) : newDepth[cur]);
+            while (!chain.empty()) {
+                uint32_t c = chain.back();
+                chain.pop_back();
+                if (dead) { kill(c); }
+                else { newDepth[c] = ++d; }
+            }
+        }
+
+        // 깊이 기준 계수 정렬
+        uint32_t maxDepth = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            if (!(flags[i] & DEAD)) { maxDepth = std::max(maxDepth, newDepth[i]); }
+        }
+        levelBegin.assign(maxDepth + 2, 0);
+        for (uint32_t i = 0; i < count; i++) {
+            if (!(flags[i] & DEAD)) { levelBegin[newDepth[i] + 1]++; }
+        }
+        for (uint32_t d = 1; d < levelBegin.size(); d++) { levelBegin[d] += levelBegin[d - 1]; }
+        std::vector<uint32_t> cursor(levelBegin.begin(), levelBegin.end() - 1);
+        std::vector<uint32_t> newIndex(count, UINT32_MAX);
+        for (uint32_t i = 0; i < count; i++) {
+            if (!(flags[i] & DEAD)) { newIndex[i] = cursor[newDepth[i]]++; }
+        }
+
+        const uint32_t alive = levelBegin.back();
+        std::vector<vec3> nPosition(alive), nScale(alive);
+        std::vector<Quaternion> nRotation(alive);
+        std::vector<mat4> nLocal(alive), nGlobal(alive);
+        std::vector<int32_t> nParent(alive);
+        std::vector<uint32_t> nDepth(alive), nSlotOf(alive);
+        std::vector<uint8_t> nFlags(alive);
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t n = newIndex[i];
+            if (n == UINT32_MAX) { continue; }
+            nPosition[n] = position[i];
+            nRotation[n] = rotation[i];
+            nScale[n] = scale[i];
+            nLocal[n] = local[i];
+            nGlobal[n] = global[i];
+            nParent[n] = parent[i] >= 0 ? (int32_t)newIndex[parent[i]] : -1;
+            nDepth[n] = newDepth[i];
+            nSlotOf[n] = slotOf[i];
+            nFlags[n] = flags[i];
+            slots[slotOf[i]].dense = n;
+        }
+        position.swap(nPosition);
+        rotation.swap(nRotation);
+        scale.swap(nScale);
+        local.swap(nLocal);
+        global.swap(nGlobal);
+        parent.swap(nParent);
+        depth.swap(nDepth);
+        slotOf.swap(nSlotOf);
+        flags.swap(nFlags);
+        deadCount = 0;
+        orderDirty = false;
+    }
+
+    void TransformHierarchy::update() {
+        if (orderDirty || deadCount * 4 > parent.size()) { rebuild(); }
+        const uint32_t count = (uint32_t)parent.size();
+        for (uint32_t i = 0; i < count; i++) {
+            uint8_t f = flags[i];
+            if (f & DEAD) { continue; }
+            const int32_t p = parent[i];
+            if (p >= 0 && (flags[p] & DEAD)) {
+                kill(i);
+                continue;
+            }
+            updateNode(i, p);
+        }
+    }
+
+    void TransformHierarchy::updateRange(uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) { updateNode(i, parent[i]); }
+    }
+
+    void TransformHierarchy::update(ThreadPool& pool, uint32_t grain) {
+        // 병렬 구간에서 노드를 죽이지 않도록 미리 정리
+        if (orderDirty || deadCount) { rebuild(); }
+        if (grain == 0) { grain = 1; }
+        // 노드가 적으면 작업을 나누고 기다리는 비용이 계산보다 크므로 그대로 처리
+        if (parent.size() < (size_t)grain * PARALLEL_MIN_CHUNKS) {
+            updateRange(0, (uint32_t)parent.size());
+            return;
+        }
+        for (size_t d = 0; d + 1 < levelBegin.size(); d++) {
+            const uint32_t begin = levelBegin[d], end = levelBegin[d + 1];
+            if (end - begin < grain * PARALLEL_MIN_CHUNKS) {
+                updateRange(begin, end);
+                continue;
+            }
+            pool.parallelFor(begin, end, grain, [this](uint32_t cb, uint32_t ce) { updateRange(cb, ce); });
+        }
+    }
 }
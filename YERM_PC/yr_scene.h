@@ -2,6 +2,7 @@
 #define __YR_SCENE_H__
 
 #include "yr_math.hpp"
+#include "yr_threadpool.hpp"
 #include <vector>
 
 namespace onart{
@@ -48,10 +49,21 @@ namespace onart{
         void setGlobalPosition(const vec3& pos);
         void setGlobalRotation(const Quaternion& r);
         
+        /// @brief Transform 전용 슬랩에서 메모리를 할당합니다. 가능하면 near와 같은 블록에 배치하여 형제/부모 노드가 메모리상 가깝게 놓이도록 합니다. 여러 스레드에서 호출해도 안전합니다.
+        /// size가 Transform 크기와 다르면 슬롯에 들어가지 않으므로 전역 operator new로 넘깁니다.
+        static void* operator new(size_t size, Transform* near);
+        static void* operator new(size_t size) { return operator new(size, nullptr); }
+        static void operator delete(void* p, size_t size);
+        static void operator delete(void* p, Transform*) { operator delete(p, sizeof(Transform)); }
     private:
         Transform() = default;
+        /// @brief 부모의 자식 목록 맨 뒤에 자신을 넣습니다. 형제 순서는 생성/연결 순서를 따릅니다.
+        void link(Transform* parent);
+        /// @brief 부모의 자식 목록에서 자신을 뺍니다.
+        void unlink();
         void setLocalDirty();
-        void setGlobalDirty();
+        /// @brief 자신과 하위 트리 전체의 루트를 r로 바꾸고 검증 결과를 지웁니다.
+        void setRoot(Transform* r);
         inline void updateLocalMatrix() { if (!dirty) return; localTransform = mat4::TRS(localPosition, localRotation, localScale); dirty = false; }
         void mat2prs();
         vec3 localPosition = vec3(0.0f);
@@ -59,11 +71,117 @@ namespace onart{
         vec3 localScale = vec3(1.0f);
         mat4 localTransform;
         mat4 globalTransform;
+        /// @brief 전역 변환이 바뀔 때마다 증가합니다. 자식은 이 값을 parentVersion과 비교하여 다시 계산할지 정합니다.
+        uint32_t version = 0;
+        /// @brief globalTransform을 계산할 때 사용한 부모의 version입니다.
+        uint32_t parentVersion = 0;
+        /// @brief 루트에서만 의미가 있으며, 그 계층의 Transform이 바뀔 때마다 증가하는 세대 번호입니다. 64비트이므로 사실상 돌아오지 않습니다.
+        uint64_t epoch = 1;
+        /// @brief 이 값이 루트의 현재 세대와 같으면 마지막 변경 이후 이미 검증된 것이므로 조상을 확인하지 않습니다.
+        uint64_t validEpoch = 0;
         bool dirty = true;
         bool globalDirty = true;
-        int bro = 0;
-        std::vector<Transform*> children;
         Transform* parent = {};
+        /// @brief 계층의 루트입니다. 서로 다른 계층은 세대 번호를 공유하지 않으므로 각각 다른 스레드에서 수정할 수 있습니다.
+        Transform* root = this;
+        Transform* firstChild = {};
+        Transform* lastChild = {};
+        Transform* nextSibling = {};
+        Transform* prevSibling = {};
+    };
+
+    /// @brief TransformHierarchy의 노드를 가리키는 세대 핸들입니다.
+    struct TransformHandle {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+        inline bool operator==(const TransformHandle& other) const { return index == other.index && generation == other.generation; }
+        inline bool operator!=(const TransformHandle& other) const { return !operator==(other); }
+    };
+
+    /// @brief 많은 수의 변환 노드를 구조체 배열(SoA)로 저장하고 한 번의 선형 순회로 갱신하는 변환 계층입니다.
+    /// 노드는 깊이 순으로 정렬된 연속 배열에 저장되므로 부모는 항상 자식보다 앞에 있습니다. Transform과 달리 전역 변환은 update() 호출 시에 한꺼번에 계산됩니다.
+    class TransformHierarchy {
+    public:
+        /// @brief 노드를 생성합니다. 부모가 주어지지 않거나 유효하지 않으면 루트 노드가 됩니다.
+        TransformHandle create(TransformHandle parent = {});
+        /// @brief 노드와 그 모든 하위 노드를 제거합니다. 하위 노드의 핸들은 다음 update() 호출 시 무효가 됩니다.
+        void destroy(TransformHandle node);
+        /// @brief 핸들이 가리키는 노드가 살아 있는지 확인합니다.
+        inline bool isValid(TransformHandle node) const { return node.index < slots.size() && slots[node.index].generation == node.generation && slots[node.index].dense != UINT32_MAX; }
+        /// @brief 부모를 바꿉니다. 지역 변환이 유지되므로 전역 변환은 바뀔 수 있습니다. 자신의 하위 노드를 부모로 주면 실패하고 false를 리턴합니다.
+        bool setParent(TransformHandle node, TransformHandle parent = {});
+        /// @brief 부모 노드를 리턴합니다. 루트 노드이면 무효한 핸들을 리턴합니다.
+        TransformHandle getParent(TransformHandle node) const;
+
+        /// @brief 지역 위치/회전/배율을 바꿉니다. 무효한 핸들이면 아무 일도 일어나지 않습니다.
+        inline void setPosition(TransformHandle node, const vec3& p) { if (!isValid(node)) return; uint32_t i = slots[node.index].dense; position[i] = p; flags[i] |= LOCAL_DIRTY; }
+        inline void setRotation(TransformHandle node, const Quaternion& r) { if (!isValid(node)) return; uint32_t i = slots[node.index].dense; rotation[i] = r; flags[i] |= LOCAL_DIRTY; }
+        inline void setScale(TransformHandle node, const vec3& s) { if (!isValid(node)) return; uint32_t i = slots[node.index].dense; scale[i] = s; flags[i] |= LOCAL_DIRTY; }
+        /// @brief 지역 위치/회전/배율을 리턴합니다. 무효한 핸들이면 항등 변환의 값(0, 단위 사원수, 1)을 리턴합니다.
+        inline const vec3& getLocalPosition(TransformHandle node) const { return isValid(node) ? position[slots[node.index].dense] : INVALID_POSITION; }
+        inline const Quaternion& getLocalRotation(TransformHandle node) const { return isValid(node) ? rotation[slots[node.index].dense] : INVALID_ROTATION; }
+        inline const vec3& getLocalScale(TransformHandle node) const { return isValid(node) ? scale[slots[node.index].dense] : INVALID_SCALE; }
+        /// @brief 지역 변환 행렬을 리턴합니다. 마지막 update() 시점의 값입니다. 무효한 핸들이면 단위 행렬을 리턴합니다.
+        inline const mat4& getLocalTransform(TransformHandle node) const { return isValid(node) ? local[slots[node.index].dense] : INVALID_TRANSFORM; }
+        /// @brief 전역 변환 행렬을 리턴합니다. 마지막 update() 시점의 값입니다. 무효한 핸들이면 단위 행렬을 리턴합니다.
+        inline const mat4& getGlobalTransform(TransformHandle node) const { return isValid(node) ? global[slots[node.index].dense] : INVALID_TRANSFORM; }
+
+        /// @brief 바뀐 지역 변환 행렬과 그 영향을 받는 전역 변환 행렬을 모두 계산합니다.
+        void update();
+        /// @brief update()와 같은 결과를 스레드 풀을 이용하여 계산합니다. 같은 깊이의 노드들을 grain개씩 나누어 ThreadPool::parallelFor()로 처리하고, 다음 깊이로 넘어가기 전에 모두 끝나기를 기다립니다.
+        /// 노드별 연산은 update()와 같으므로 결과는 비트 단위로 동일합니다. 전체 노드 수나 한 깊이의 노드 수가 grain * PARALLEL_MIN_CHUNKS보다 적으면 나누지 않고 호출 스레드에서 바로 처리합니다.
+        /// @param pool 작업을 맡길 스레드 풀. 다른 작업이 쌓여 있으면 그만큼 늦게 리턴합니다.
+        /// @param grain 작업 하나가 맡는 노드 수
+        void update(ThreadPool& pool, uint32_t grain = 1024);
+        /// @brief update(ThreadPool&, uint32_t)에서 나누어 처리하기 위한 최소 조각 수입니다.
+        constexpr static uint32_t PARALLEL_MIN_CHUNKS = 4;
+        /// @brief 살아 있는 노드 수를 리턴합니다.
+        inline size_t size() const { return parent.size() - deadCount; }
+    private:
+        enum : uint8_t { LOCAL_DIRTY = 1, CHANGED = 2, DEAD = 4 };
+        /// @brief 무효한 핸들로 조회했을 때 리턴하는 값입니다.
+        inline static const vec3 INVALID_POSITION = vec3(0.0f);
+        inline static const Quaternion INVALID_ROTATION = Quaternion();
+        inline static const vec3 INVALID_SCALE = vec3(1.0f);
+        inline static const mat4 INVALID_TRANSFORM = mat4();
+        struct Slot {
+            uint32_t dense = UINT32_MAX;
+            uint32_t generation = 0;
+        };
+        /// @brief 죽은 노드를 제거하고 깊이 순으로 다시 정렬합니다.
+        void rebuild();
+        void kill(uint32_t dense);
+        /// @brief 죽은 노드가 없다는 가정 하에 주어진 범위의 노드를 갱신합니다.
+        void updateRange(uint32_t begin, uint32_t end);
+        inline void updateNode(uint32_t i, int32_t p) {
+            bool changed = false;
+            if (flags[i] & LOCAL_DIRTY) {
+                local[i] = mat4::TRS(position[i], rotation[i], scale[i]);
+                changed = true;
+            }
+            if (p < 0) {
+                if (changed) { global[i] = local[i]; }
+            }
+            else if (changed || (flags[p] & CHANGED)) {
+                global[i] = global[p] * local[i];
+                changed = true;
+            }
+            flags[i] = changed ? CHANGED : 0;
+        }
+        std::vector<Slot> slots;
+        std::vector<uint32_t> freeSlots;
+        std::vector<vec3> position;
+        std::vector<Quaternion> rotation;
+        std::vector<vec3> scale;
+        std::vector<mat4> local;
+        std::vector<mat4> global;
+        std::vector<int32_t> parent; // 부모의 배열 내 위치. 루트는 -1
+        std::vector<uint32_t> depth;
+        std::vector<uint32_t> slotOf;
+        std::vector<uint8_t> flags;
+        std::vector<uint32_t> levelBegin{ 0 }; // 깊이별 시작 위치. 마지막 원소는 전체 크기
+        size_t deadCount = 0;
+        bool orderDirty = false;
     };
 }
 
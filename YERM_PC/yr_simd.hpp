@@ -21,6 +21,7 @@
 #include "../externals/boost/predef/hardware.h"
 #include <cstring>
 #include <cstdint>
+#include <cstdlib>
 #include <cmath>
 #include <cassert>
 
@@ -332,6 +333,18 @@ namespace onart{
 #endif
 #endif
 
+// x86에서는 AVX2/FMA 경로를 함께 컴파일해 두고 실행 시 CPUID로 선택합니다. YR_NO_AVX2를 정의하면 SSE 경로만 사용합니다.
+#if defined(YR_USING_SIMD) && !defined(YR_NO_AVX2) && BOOST_HW_SIMD_X86 >= BOOST_HW_SIMD_X86_SSE2_VERSION
+#define YR_USING_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define YR_TARGET_AVX2
+#else
+#define YR_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#endif
+
 #ifdef YR_USING_SIMD
 
     using float128 = __m128;
@@ -382,6 +395,248 @@ namespace onart{
     inline float128 sqrt(float128 a) { return _mm_sqrt_ps(a); }
     inline float128 rsqrt(float128 a) { return _mm_rsqrt_ps(a); }
     inline float128 rcp(float128 a) { return _mm_rcp_ps(a); }
+    inline float128 min(float128 a, float128 b) { return _mm_min_ps(a,b); }
+    inline float128 max(float128 a, float128 b) { return _mm_max_ps(a,b); }
+    /// @brief a < b인 성분은 모든 비트가 1, 아니면 0인 마스크를 리턴합니다.
+    inline float128 cmplt(float128 a, float128 b) { return _mm_cmplt_ps(a,b); }
+    /// @brief a <= b인 성분은 모든 비트가 1, 아니면 0인 마스크를 리턴합니다.
+    inline float128 cmple(float128 a, float128 b) { return _mm_cmple_ps(a,b); }
+    /// @brief 마스크 비트가 1인 성분은 a, 0인 성분은 b에서 가져옵니다.
+    inline float128 select(float128 mask, float128 a, float128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+    /// @brief 각 성분의 부호 비트를 모아 4비트 정수로 리턴합니다. 비교 마스크와 함께 사용합니다.
+    inline int movemask(float128 a) { return _mm_movemask_ps(a); }
+    /// @brief 4개 벡터를 4x4 행렬의 행으로 보고 전치합니다.
+    inline void transpose4(float128& r0, float128& r1, float128& r2, float128& r3) {
+        float128 t0 = _mm_unpacklo_ps(r0, r1), t1 = _mm_unpacklo_ps(r2, r3);
+        float128 t2 = _mm_unpackhi_ps(r0, r1), t3 = _mm_unpackhi_ps(r2, r3);
+        r0 = _mm_movelh_ps(t0, t1); r1 = _mm_movehl_ps(t1, t0);
+        r2 = _mm_movelh_ps(t2, t3); r3 = _mm_movehl_ps(t3, t2);
+    }
+
+    // 아래 초월함수 근사는 Cephes 라이브러리의 단정밀도 구현을 따릅니다. 오차는 float 전 범위 무작위 입력을 배정밀도 결과와 비교해 측정한 값입니다.
+
+    /// @brief 4개 float의 사인과 코사인을 함께 계산합니다. |x| <= 8192에서 최대 절대 오차는 약 8e-8입니다. 그보다 큰 값은 범위 축소 정밀도가 떨어집니다.
+    inline void sincos(float128 x, float128& s, float128& c) {
+        const float128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int32_t)0x80000000));
+        float128 sinSign = _mm_and_ps(x, signMask);
+        x = _mm_andnot_ps(signMask, x);
+        __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f))); // 4/pi
+        j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+        const float128 y = _mm_cvtepi32_ps(j);
+        sinSign = _mm_xor_ps(sinSign, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29)));
+        const float128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+        const float128 polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+        // 3단계 Cody-Waite 범위 축소: x - y * pi/4
+        x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-0.78515625f)));
+        x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-2.4187564849853515625e-4f)));
+        x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-3.77489497744594108e-8f)));
+        const float128 z = _mm_mul_ps(x, x);
+        float128 pc = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(-1.388731625493765e-3f));
+        pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(4.166664568298827e-2f));
+        pc = _mm_mul_ps(_mm_mul_ps(pc, z), z);
+        pc = _mm_add_ps(_mm_sub_ps(pc, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+        float128 ps = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f));
+        ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(-1.6666654611e-1f));
+        ps = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ps, z), x), x);
+        s = _mm_xor_ps(_mm_or_ps(_mm_and_ps(polyMask, ps), _mm_andnot_ps(polyMask, pc)), sinSign);
+        c = _mm_xor_ps(_mm_or_ps(_mm_and_ps(polyMask, pc), _mm_andnot_ps(polyMask, ps)), cosSign);
+    }
+
+    /// @brief 4개 float의 사인을 계산합니다. 오차는 sincos와 같습니다.
+    inline float128 sin(float128 x) { float128 s, c; sincos(x, s, c); return s; }
+    /// @brief 4개 float의 코사인을 계산합니다. 오차는 sincos와 같습니다.
+    inline float128 cos(float128 x) { float128 s, c; sincos(x, s, c); return c; }
+
+    /// @brief 4개 float의 자연지수를 계산합니다. 최대 상대 오차는 약 1e-7입니다. 입력은 [-88.37, 88.37]로 제한되므로 넘치는 경우 inf 대신 약 2.4e38, 모자라는 경우 0을 리턴합니다.
+    inline float128 exp(float128 x) {
+        x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-88.3762626647949f)), _mm_set1_ps(88.3762626647949f));
+        float128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)), _mm_set1_ps(0.5f));
+        // SSE2에 floor가 없으므로 버림 후 보정
+        const float128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+        fx = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, fx), _mm_set1_ps(1.0f)));
+        x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(0.693359375f)));
+        x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(-2.12194440e-4f)));
+        const float128 z = _mm_mul_ps(x, x);
+        float128 y = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(1.9875691500e-4f), x), _mm_set1_ps(1.3981999507e-3f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+        y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), _mm_set1_ps(1.0f));
+        const __m128i e = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(0x7f)), 23);
+        return _mm_mul_ps(y, _mm_castsi128_ps(e));
+    }
+
+    /// @brief 4개 float의 자연로그를 계산합니다. 양의 정규화 수에서 최대 상대 오차는 약 1e-7입니다. 0 이하 또는 NaN 입력에는 NaN을 리턴하며, 비정규화 수는 가장 작은 정규화 수로 취급합니다.
+    inline float128 log(float128 x) {
+        const float128 invalid = _mm_cmpngt_ps(x, _mm_setzero_ps());
+        x = _mm_max_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x00800000)));
+        __m128i ei = _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(x), 23), _mm_set1_epi32(0x7f));
+        x = _mm_or_ps(_mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(~0x7f800000))), _mm_set1_ps(0.5f));
+        float128 e = _mm_add_ps(_mm_cvtepi32_ps(ei), _mm_set1_ps(1.0f));
+        const float128 small = _mm_cmplt_ps(x, _mm_set1_ps(0.707106781186547524f));
+        const float128 t = _mm_and_ps(x, small);
+        x = _mm_add_ps(_mm_sub_ps(x, _mm_set1_ps(1.0f)), t);
+        e = _mm_sub_ps(e, _mm_and_ps(_mm_set1_ps(1.0f), small));
+        const float128 z = _mm_mul_ps(x, x);
+        float128 y = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(7.0376836292e-2f), x), _mm_set1_ps(-1.1514610310e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.1676998740e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.2420140846e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.4249322787e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.6668057665e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(2.0000714765e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-2.4999993993e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(3.3333331174e-1f));
+        y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+        y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+        y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+        x = _mm_add_ps(_mm_add_ps(x, y), _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+        return _mm_or_ps(x, invalid);
+    }
+
+    /// @brief 4개 float의 아크탄젠트를 계산합니다. 최대 절대 오차는 약 1.5e-7 라디안입니다.
+    inline float128 atan(float128 x) {
+        const float128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int32_t)0x80000000));
+        const float128 sign = _mm_and_ps(x, signMask);
+        x = _mm_andnot_ps(signMask, x);
+        const float128 big = _mm_cmpgt_ps(x, _mm_set1_ps(2.414213562373095f)); // tan(3pi/8)
+        const float128 mid = _mm_andnot_ps(big, _mm_cmpgt_ps(x, _mm_set1_ps(0.4142135623730950f))); // tan(pi/8)
+        const float128 xb = _mm_div_ps(_mm_set1_ps(-1.0f), x);
+        const float128 xm = _mm_div_ps(_mm_sub_ps(x, _mm_set1_ps(1.0f)), _mm_add_ps(x, _mm_set1_ps(1.0f)));
+        x = _mm_or_ps(_mm_and_ps(big, xb), _mm_andnot_ps(big, x));
+        x = _mm_or_ps(_mm_and_ps(mid, xm), _mm_andnot_ps(mid, x));
+        const float128 y0 = _mm_or_ps(_mm_and_ps(big, _mm_set1_ps(1.57079632679489661923f)), _mm_and_ps(mid, _mm_set1_ps(0.78539816339744830962f)));
+        const float128 z = _mm_mul_ps(x, x);
+        float128 y = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(8.05374449538e-2f), z), _mm_set1_ps(-1.38776856032e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, z), _mm_set1_ps(1.99777106478e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, z), _mm_set1_ps(-3.33329491539e-1f));
+        y = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(y, z), x), x);
+        return _mm_xor_ps(_mm_add_ps(y, y0), sign);
+    }
+
+    /// @brief 4개 쌍의 atan2(y, x)를 계산합니다. 최대 절대 오차는 약 3e-7 라디안입니다. x = y = 0이면 0을 리턴하며 부호 있는 0은 구분하지 않습니다.
+    inline float128 atan2(float128 y, float128 x) {
+        const float128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int32_t)0x80000000));
+        const float128 zero = _mm_setzero_ps();
+        float128 r = atan(_mm_div_ps(y, x));
+        const float128 offset = _mm_and_ps(_mm_cmplt_ps(x, zero), _mm_xor_ps(_mm_set1_ps(3.14159265358979323846f), _mm_and_ps(y, signMask)));
+        r = _mm_add_ps(r, offset);
+        return _mm_andnot_ps(_mm_and_ps(_mm_cmpeq_ps(x, zero), _mm_cmpeq_ps(y, zero)), r);
+    }
+
+    /// @brief 4개 float의 역제곱근을 rsqrt 근사 후 뉴턴법 1회로 보정하여 계산합니다. 양의 정규화 수에서 최대 상대 오차는 약 2.5e-7입니다. (rsqrt만 쓰면 약 3.7e-4)
+    inline float128 rsqrtNR(float128 x) {
+        const float128 y = _mm_rsqrt_ps(x);
+        const float128 yyx = _mm_mul_ps(_mm_mul_ps(y, y), x);
+        return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), y), _mm_sub_ps(_mm_set1_ps(3.0f), yyx));
+    }
+
+#ifdef YR_USING_AVX2
+    // 위 4레인 근사의 8레인 AVX2/FMA 판입니다. YR_TARGET_AVX2를 붙인 함수 안에서 avx2::ENABLED를 확인한 뒤에만 호출해야 합니다. 오차는 4레인 판과 같습니다.
+    namespace avx2 {
+        YR_TARGET_AVX2 inline void sincos(__m256 x, __m256& s, __m256& c) {
+            const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32((int32_t)0x80000000));
+            __m256 sinSign = _mm256_and_ps(x, signMask);
+            x = _mm256_andnot_ps(signMask, x);
+            __m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(1.27323954473516f)));
+            j = _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+            const __m256 y = _mm256_cvtepi32_ps(j);
+            sinSign = _mm256_xor_ps(sinSign, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, _mm256_set1_epi32(4)), 29)));
+            const __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+            const __m256 polyMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(2)), _mm256_setzero_si256()));
+            x = _mm256_fmadd_ps(y, _mm256_set1_ps(-0.78515625f), x);
+            x = _mm256_fmadd_ps(y, _mm256_set1_ps(-2.4187564849853515625e-4f), x);
+            x = _mm256_fmadd_ps(y, _mm256_set1_ps(-3.77489497744594108e-8f), x);
+            const __m256 z = _mm256_mul_ps(x, x);
+            __m256 pc = _mm256_fmadd_ps(_mm256_set1_ps(2.443315711809948e-5f), z, _mm256_set1_ps(-1.388731625493765e-3f));
+            pc = _mm256_fmadd_ps(pc, z, _mm256_set1_ps(4.166664568298827e-2f));
+            pc = _mm256_mul_ps(_mm256_mul_ps(pc, z), z);
+            pc = _mm256_add_ps(_mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), pc), _mm256_set1_ps(1.0f));
+            __m256 ps = _mm256_fmadd_ps(_mm256_set1_ps(-1.9515295891e-4f), z, _mm256_set1_ps(8.3321608736e-3f));
+            ps = _mm256_fmadd_ps(ps, z, _mm256_set1_ps(-1.6666654611e-1f));
+            ps = _mm256_fmadd_ps(_mm256_mul_ps(ps, z), x, x);
+            s = _mm256_xor_ps(_mm256_blendv_ps(pc, ps, polyMask), sinSign);
+            c = _mm256_xor_ps(_mm256_blendv_ps(ps, pc, polyMask), cosSign);
+        }
+
+        YR_TARGET_AVX2 inline __m256 sin(__m256 x) { __m256 s, c; sincos(x, s, c); return s; }
+        YR_TARGET_AVX2 inline __m256 cos(__m256 x) { __m256 s, c; sincos(x, s, c); return c; }
+
+        YR_TARGET_AVX2 inline __m256 exp(__m256 x) {
+            x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-88.3762626647949f)), _mm256_set1_ps(88.3762626647949f));
+            const __m256 fx = _mm256_floor_ps(_mm256_fmadd_ps(x, _mm256_set1_ps(1.44269504088896341f), _mm256_set1_ps(0.5f)));
+            x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(0.693359375f), x);
+            x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(-2.12194440e-4f), x);
+            const __m256 z = _mm256_mul_ps(x, x);
+            __m256 y = _mm256_fmadd_ps(_mm256_set1_ps(1.9875691500e-4f), x, _mm256_set1_ps(1.3981999507e-3f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(8.3334519073e-3f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(4.1665795894e-2f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.6666665459e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(5.0000001201e-1f));
+            y = _mm256_add_ps(_mm256_fmadd_ps(y, z, x), _mm256_set1_ps(1.0f));
+            const __m256i e = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(fx), _mm256_set1_epi32(0x7f)), 23);
+            return _mm256_mul_ps(y, _mm256_castsi256_ps(e));
+        }
+
+        YR_TARGET_AVX2 inline __m256 log(__m256 x) {
+            const __m256 invalid = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_NGT_UQ);
+            x = _mm256_max_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(0x00800000)));
+            __m256i ei = _mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(x), 23), _mm256_set1_epi32(0x7f));
+            x = _mm256_or_ps(_mm256_and_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(~0x7f800000))), _mm256_set1_ps(0.5f));
+            __m256 e = _mm256_add_ps(_mm256_cvtepi32_ps(ei), _mm256_set1_ps(1.0f));
+            const __m256 small = _mm256_cmp_ps(x, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+            x = _mm256_add_ps(_mm256_sub_ps(x, _mm256_set1_ps(1.0f)), _mm256_and_ps(x, small));
+            e = _mm256_sub_ps(e, _mm256_and_ps(_mm256_set1_ps(1.0f), small));
+            const __m256 z = _mm256_mul_ps(x, x);
+            __m256 y = _mm256_fmadd_ps(_mm256_set1_ps(7.0376836292e-2f), x, _mm256_set1_ps(-1.1514610310e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.1676998740e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.2420140846e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.4249322787e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.6668057665e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(2.0000714765e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-2.4999993993e-1f));
+            y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(3.3333331174e-1f));
+            y = _mm256_mul_ps(_mm256_mul_ps(y, x), z);
+            y = _mm256_fmadd_ps(e, _mm256_set1_ps(-2.12194440e-4f), y);
+            y = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), y);
+            x = _mm256_fmadd_ps(e, _mm256_set1_ps(0.693359375f), _mm256_add_ps(x, y));
+            return _mm256_or_ps(x, invalid);
+        }
+
+        YR_TARGET_AVX2 inline __m256 atan(__m256 x) {
+            const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32((int32_t)0x80000000));
+            const __m256 sign = _mm256_and_ps(x, signMask);
+            x = _mm256_andnot_ps(signMask, x);
+            const __m256 big = _mm256_cmp_ps(x, _mm256_set1_ps(2.414213562373095f), _CMP_GT_OQ);
+            const __m256 mid = _mm256_andnot_ps(big, _mm256_cmp_ps(x, _mm256_set1_ps(0.4142135623730950f), _CMP_GT_OQ));
+            const __m256 xb = _mm256_div_ps(_mm256_set1_ps(-1.0f), x);
+            const __m256 xm = _mm256_div_ps(_mm256_sub_ps(x, _mm256_set1_ps(1.0f)), _mm256_add_ps(x, _mm256_set1_ps(1.0f)));
+            x = _mm256_blendv_ps(_mm256_blendv_ps(x, xm, mid), xb, big);
+            const __m256 y0 = _mm256_or_ps(_mm256_and_ps(big, _mm256_set1_ps(1.57079632679489661923f)), _mm256_and_ps(mid, _mm256_set1_ps(0.78539816339744830962f)));
+            const __m256 z = _mm256_mul_ps(x, x);
+            __m256 y = _mm256_fmadd_ps(_mm256_set1_ps(8.05374449538e-2f), z, _mm256_set1_ps(-1.38776856032e-1f));
+            y = _mm256_fmadd_ps(y, z, _mm256_set1_ps(1.99777106478e-1f));
+            y = _mm256_fmadd_ps(y, z, _mm256_set1_ps(-3.33329491539e-1f));
+            y = _mm256_fmadd_ps(_mm256_mul_ps(y, z), x, x);
+            return _mm256_xor_ps(_mm256_add_ps(y, y0), sign);
+        }
+
+        YR_TARGET_AVX2 inline __m256 atan2(__m256 y, __m256 x) {
+            const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32((int32_t)0x80000000));
+            const __m256 zero = _mm256_setzero_ps();
+            __m256 r = atan(_mm256_div_ps(y, x));
+            const __m256 offset = _mm256_and_ps(_mm256_cmp_ps(x, zero, _CMP_LT_OQ), _mm256_xor_ps(_mm256_set1_ps(3.14159265358979323846f), _mm256_and_ps(y, signMask)));
+            r = _mm256_add_ps(r, offset);
+            return _mm256_andnot_ps(_mm256_and_ps(_mm256_cmp_ps(x, zero, _CMP_EQ_OQ), _mm256_cmp_ps(y, zero, _CMP_EQ_OQ)), r);
+        }
+
+        YR_TARGET_AVX2 inline __m256 rsqrtNR(__m256 x) {
+            const __m256 y = _mm256_rsqrt_ps(x);
+            const __m256 yyx = _mm256_mul_ps(_mm256_mul_ps(y, y), x);
+            return _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), y), _mm256_sub_ps(_mm256_set1_ps(3.0f), yyx));
+        }
+    }
+#endif
 
     inline double128 add(double128 a, double128 b) { return _mm_add_pd(a,b); }
     inline double128 sub(double128 a, double128 b) { return _mm_sub_pd(a,b); }
@@ -714,6 +969,113 @@ namespace onart{
         b = _mm_div_pd(_mm_loadu_pd(vec + 2), _mm_loadu_pd(val + 2)); _mm_storeu_pd(vec + 2, b);
     }
 
+#ifdef YR_USING_AVX2
+    namespace avx2 {
+        /// @brief 이 CPU와 OS가 AVX2, FMA 명령 및 256비트 레지스터 저장을 지원하는지 확인합니다.
+        inline bool detect() {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) { return false; }
+            __cpuid(info, 1);
+            const bool fma = (info[2] & (1 << 12)) != 0;
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            if (!fma || !osxsave || (_xgetbv(0) & 6) != 6) { return false; }
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+        }
+
+        /// @brief AVX2/FMA 경로 사용 가능 여부입니다. 프로그램 시작 시 한 번만 확인합니다.
+        inline const bool ENABLED = detect();
+
+        /// @brief 이보다 짧은 배열은 분기와 상태 전환 비용이 더 크므로 SSE 경로를 그대로 사용합니다.
+        constexpr size_t MIN_BYTES = 128;
+
+#define YR_AVX2_ARRAY_KERNEL(func, T, LANES, SUFFIX, INTRIN, OP) \
+        YR_TARGET_AVX2 inline void func(T* vec, T val, size_t size) { \
+            const auto v = _mm256_set1_##SUFFIX(val); \
+            const size_t end = size - size % LANES; \
+            size_t i = 0; \
+            for (; i < end; i += LANES) { _mm256_storeu_##SUFFIX(vec + i, INTRIN(_mm256_loadu_##SUFFIX(vec + i), v)); } \
+            for (; i < size; i++) { vec[i] OP val; } \
+        } \
+        YR_TARGET_AVX2 inline void func(T* vec, const T* val, size_t size) { \
+            const size_t end = size - size % LANES; \
+            size_t i = 0; \
+            for (; i < end; i += LANES) { _mm256_storeu_##SUFFIX(vec + i, INTRIN(_mm256_loadu_##SUFFIX(vec + i), _mm256_loadu_##SUFFIX(val + i))); } \
+            for (; i < size; i++) { vec[i] OP val[i]; } \
+        }
+
+        YR_AVX2_ARRAY_KERNEL(addAll, float, 8, ps, _mm256_add_ps, +=)
+        YR_AVX2_ARRAY_KERNEL(mulAll, float, 8, ps, _mm256_mul_ps, *=)
+        YR_AVX2_ARRAY_KERNEL(divAll, float, 8, ps, _mm256_div_ps, /=)
+        YR_AVX2_ARRAY_KERNEL(addAll, double, 4, pd, _mm256_add_pd, +=)
+        YR_AVX2_ARRAY_KERNEL(mulAll, double, 4, pd, _mm256_mul_pd, *=)
+        YR_AVX2_ARRAY_KERNEL(divAll, double, 4, pd, _mm256_div_pd, /=)
+#undef YR_AVX2_ARRAY_KERNEL
+
+        YR_TARGET_AVX2 inline void addsAll(int16_t* vec, const int16_t* val, size_t size) {
+            const size_t end = size - size % 16;
+            size_t i = 0;
+            for (; i < end; i += 16) {
+                __m256i ves = _mm256_loadu_si256((const __m256i*)(vec + i));
+                __m256i ver = _mm256_loadu_si256((const __m256i*)(val + i));
+                _mm256_storeu_si256((__m256i*)(vec + i), _mm256_adds_epi16(ves, ver));
+            }
+            for (; i < size; i++) {
+                int32_t sum = (int32_t)vec[i] + (int32_t)val[i];
+                vec[i] = (int16_t)(sum < INT16_MIN ? INT16_MIN : (sum > INT16_MAX ? INT16_MAX : sum));
+            }
+        }
+
+        YR_TARGET_AVX2 inline void mulAll(int16_t* vec, int16_t v2, float val, size_t size) {
+            const __m256i v = _mm256_set1_epi16(v2);
+            const size_t end = size - size % 16;
+            size_t i = 0;
+            for (; i < end; i += 16) {
+                __m256i ves = _mm256_loadu_si256((const __m256i*)(vec + i));
+                ves = _mm256_slli_epi16(_mm256_mulhi_epi16(ves, v), 1);
+                _mm256_storeu_si256((__m256i*)(vec + i), ves);
+            }
+            for (; i < size; i++) {
+                vec[i] = (int16_t)((float)vec[i] * val);
+            }
+        }
+    }
+
+#define YR_AVX2_DISPATCH(func, T, SIMD4, OP) \
+    template<> \
+    inline void func<T>(T* vec, T val, size_t size) { \
+        if (size * sizeof(T) >= avx2::MIN_BYTES && avx2::ENABLED) { avx2::func(vec, val, size); return; } \
+        const size_t end = size - size % 4; \
+        size_t i = 0; \
+        T val4[4]; \
+        set4<T>(val4, val); \
+        for (; i < end; i += 4) { SIMD4<T>(vec + i, val4); } \
+        for (; i < size; i++) { vec[i] OP val; } \
+    } \
+    template<> \
+    inline void func<T>(T* vec, const T* val, size_t size) { \
+        if (size * sizeof(T) >= avx2::MIN_BYTES && avx2::ENABLED) { avx2::func(vec, val, size); return; } \
+        const size_t end = size - size % 4; \
+        size_t i = 0; \
+        for (; i < end; i += 4) { SIMD4<T>(vec + i, val + i); } \
+        for (; i < size; i++) { vec[i] OP val[i]; } \
+    }
+
+    YR_AVX2_DISPATCH(addAll, float, add4, +=)
+    YR_AVX2_DISPATCH(mulAll, float, mul4, *=)
+    YR_AVX2_DISPATCH(divAll, float, div4, /=)
+    YR_AVX2_DISPATCH(addAll, double, add4, +=)
+    YR_AVX2_DISPATCH(mulAll, double, mul4, *=)
+    YR_AVX2_DISPATCH(divAll, double, div4, /=)
+#undef YR_AVX2_DISPATCH
+#endif
+
     /// @brief float 배열 앞 4개를 절댓값으로 바꿉니다.
     template<>
     inline void abs4<float>(float* vec){
@@ -916,15 +1278,20 @@ namespace onart{
     /// @param val 누적할 값
     /// @param size 누적할 개수
     inline void addsAll(int16_t* vec, const int16_t* val, size_t size){
-        size_t i;
-        for (i = 8; i < size; i += 8) {
-            __m128i ves = _mm_loadu_si128((__m128i*)(vec + i - 8));
-            __m128i ver = _mm_loadu_si128((__m128i*)(val + i - 8));
+#ifdef YR_USING_AVX2
+        if (size * sizeof(int16_t) >= avx2::MIN_BYTES && avx2::ENABLED) { avx2::addsAll(vec, val, size); return; }
+#endif
+        const size_t end = size - size % 8;
+        size_t i = 0;
+        for (; i < end; i += 8) {
+            __m128i ves = _mm_loadu_si128((__m128i*)(vec + i));
+            __m128i ver = _mm_loadu_si128((__m128i*)(val + i));
             ves = _mm_adds_epi16(ves, ver);
-            _mm_storeu_si128((__m128i*)(vec + i - 8), ves);
+            _mm_storeu_si128((__m128i*)(vec + i), ves);
         }
-        for (i -= 8; i < size; i++) {
-            vec[i] += val[i];
+        for (; i < size; i++) {
+            int32_t sum = (int32_t)vec[i] + (int32_t)val[i];
+            vec[i] = (int16_t)(sum < INT16_MIN ? INT16_MIN : (sum > INT16_MAX ? INT16_MAX : sum));
         }
     }
 
@@ -935,15 +1302,19 @@ namespace onart{
     inline void mulAll(int16_t* vec, float val, size_t size) {
         assert(val <= 1.0f && val >= 0.0f && "이 함수에서 곱해지는 실수의 값은 [0,1] 범위만 허용됩니다.");
         int16_t v2 = (int16_t)((float)val * 32768.0f);
+#ifdef YR_USING_AVX2
+        if (size * sizeof(int16_t) >= avx2::MIN_BYTES && avx2::ENABLED) { avx2::mulAll(vec, v2, val, size); return; }
+#endif
         __m128i v = _mm_set1_epi16(v2);
-        size_t i;
-        for (i = 8; i < size; i += 8) {
-            __m128i ves = _mm_loadu_si128((__m128i*)(vec + i - 8));
+        const size_t end = size - size % 8;
+        size_t i = 0;
+        for (; i < end; i += 8) {
+            __m128i ves = _mm_loadu_si128((__m128i*)(vec + i));
             ves = _mm_mulhi_epi16(ves, v);
             ves = _mm_slli_epi16(ves, 1);
-            _mm_storeu_si128((__m128i*)(vec + i - 8), ves);
+            _mm_storeu_si128((__m128i*)(vec + i), ves);
         }
-        for (i -= 8; i < size; i++) {
+        for (; i < size; i++) {
             vec[i] = (int16_t)((float)vec[i] * val);
         }
     }
@@ -1056,6 +1427,29 @@ namespace onart{
     inline float128 sqrt(float128 a) { return {std::sqrt(a._[0]),std::sqrt(a._[1]),std::sqrt(a._[2]),std::sqrt(a._[3])}; }
     inline float128 rsqrt(float128 a) { return { 1.0f / std::sqrt(a._[0]), 1.0f / std::sqrt(a._[1]), 1.0f / std::sqrt(a._[2]), 1.0f / std::sqrt(a._[3]) }; }
     inline float128 rcp(float128 a) { return { 1/a._[0], 1/a._[1], 1/a._[2], 1/a._[3]}; }
+    inline float128 min(float128 a, float128 b) { return { a._[0] < b._[0] ? a._[0] : b._[0], a._[1] < b._[1] ? a._[1] : b._[1], a._[2] < b._[2] ? a._[2] : b._[2], a._[3] < b._[3] ? a._[3] : b._[3] }; }
+    inline float128 max(float128 a, float128 b) { return { a._[0] > b._[0] ? a._[0] : b._[0], a._[1] > b._[1] ? a._[1] : b._[1], a._[2] > b._[2] ? a._[2] : b._[2], a._[3] > b._[3] ? a._[3] : b._[3] }; }
+    inline float128 cmplt(float128 a, float128 b) { float128 r; for (int i = 0; i < 4; i++) { uint32_t m = a._[i] < b._[i] ? ~0u : 0u; std::memcpy(&r._[i], &m, 4); } return r; }
+    inline float128 cmple(float128 a, float128 b) { float128 r; for (int i = 0; i < 4; i++) { uint32_t m = a._[i] <= b._[i] ? ~0u : 0u; std::memcpy(&r._[i], &m, 4); } return r; }
+    inline float128 select(float128 mask, float128 a, float128 b) { return b_xor(b, b_and(mask, b_xor(a, b))); }
+    inline int movemask(float128 a) { int r = 0; for (int i = 0; i < 4; i++) { uint32_t m; std::memcpy(&m, &a._[i], 4); r |= (int)(m >> 31) << i; } return r; }
+    /// @brief 4개 벡터를 4x4 행렬의 행으로 보고 전치합니다.
+    inline void transpose4(float128& r0, float128& r1, float128& r2, float128& r3) {
+        float128 m[4] = { r0, r1, r2, r3 };
+        r0 = { m[0]._[0], m[1]._[0], m[2]._[0], m[3]._[0] };
+        r1 = { m[0]._[1], m[1]._[1], m[2]._[1], m[3]._[1] };
+        r2 = { m[0]._[2], m[1]._[2], m[2]._[2], m[3]._[2] };
+        r3 = { m[0]._[3], m[1]._[3], m[2]._[3], m[3]._[3] };
+    }
+
+    inline void sincos(float128 x, float128& s, float128& c) { for (int i = 0; i < 4; i++) { s._[i] = std::sin(x._[i]); c._[i] = std::cos(x._[i]); } }
+    inline float128 sin(float128 x) { return { std::sin(x._[0]), std::sin(x._[1]), std::sin(x._[2]), std::sin(x._[3]) }; }
+    inline float128 cos(float128 x) { return { std::cos(x._[0]), std::cos(x._[1]), std::cos(x._[2]), std::cos(x._[3]) }; }
+    inline float128 exp(float128 x) { return { std::exp(x._[0]), std::exp(x._[1]), std::exp(x._[2]), std::exp(x._[3]) }; }
+    inline float128 log(float128 x) { return { std::log(x._[0]), std::log(x._[1]), std::log(x._[2]), std::log(x._[3]) }; }
+    inline float128 atan(float128 x) { return { std::atan(x._[0]), std::atan(x._[1]), std::atan(x._[2]), std::atan(x._[3]) }; }
+    inline float128 atan2(float128 y, float128 x) { return { std::atan2(y._[0], x._[0]), std::atan2(y._[1], x._[1]), std::atan2(y._[2], x._[2]), std::atan2(y._[3], x._[3]) }; }
+    inline float128 rsqrtNR(float128 x) { return rsqrt(x); }
     inline double128 mabs(double128 a) { return {-std::abs(a._[0]), -std::abs(a._[1])}; }
     inline double128 abs(double128 a) { return {std::abs(a._[0]), std::abs(a._[1])}; }
     inline double128 sqrt(double128 a) { return {std::sqrt(a._[0]), std::sqrt(a._[1])}; }
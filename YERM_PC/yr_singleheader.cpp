@@ -87,6 +87,10 @@ static void __yrfree(void* p){ buffer.free(p); }
 #define STBI_FREE __yrfree
 
 #include "../externals/single_header/stb_image.h"
+#define STB_TRUETYPE_IMPLEMENTATION
+#define STBTT_malloc(x,u) ((void)(u),__yrmalloc(x))
+#define STBTT_free(x,u) ((void)(u),__yrfree(x))
+#include "../externals/single_header/stb_truetype.h"
 
 #include "../externals/vulkan/vk_mem_alloc.h"
 #include "../externals/single_header/miniaudio.h"
@@ -0,0 +1,255 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "yr_spatialhash.h"
+
+#include <algorithm>
+
+namespace onart {
+
+    SpatialHash2D::SpatialHash2D(float cellSize, uint32_t maxCellsPerProxy)
+        :cellSize(cellSize > 0 ? cellSize : 1), maxCells(maxCellsPerProxy ? maxCellsPerProxy : 1) {
+        invCellSize = 1.0f / this->cellSize;
+    }
+
+    uint32_t SpatialHash2D::allocate() {
+        dirty = true;
+        if (!freeIds.empty()) {
+            const uint32_t id = freeIds.back();
+            freeIds.pop_back();
+            return id;
+        }
+        proxies.emplace_back();
+        stamps.push_back(0);
+        return (uint32_t)proxies.size() - 1;
+    }
+
+    uint32_t SpatialHash2D::insert(const vec2& min, const vec2& max, uint64_t userData) {
+        const uint32_t id = allocate();
+        Proxy& p = proxies[id];
+        p = {};
+        p.minX = min[0]; p.minY = min[1];
+        p.maxX = max[0]; p.maxY = max[1];
+        p.userData = userData;
+        p.alive = true;
+        return id;
+    }
+
+    void SpatialHash2D::insert(const vec2* mins, const vec2* maxs, size_t count, uint32_t* ids, const uint64_t* userData) {
+        proxies.reserve(proxies.size() + (count > freeIds.size() ? count - freeIds.size() : 0));
+        stamps.reserve(proxies.capacity());
+        for (size_t i = 0; i < count; i++) { ids[i] = insert(mins[i], maxs[i], userData ? userData[i] : 0); }
+    }
+
+    uint32_t SpatialHash2D::insert(Transform* transform, const vec2& halfExtent, uint64_t userData) {
+        const uint32_t id = allocate();
+        Proxy& p = proxies[id];
+        p = {};
+        p.userData = userData;
+        p.transform = transform;
+        p.halfX = halfExtent[0]; p.halfY = halfExtent[1];
+        p.alive = true;
+        setFromTransform(p, transform->getGlobalTransform());
+        return id;
+    }
+
+    uint32_t SpatialHash2D::insert(const TransformHierarchy& hierarchy, TransformHandle node, const vec2& halfExtent, uint64_t userData) {
+        const uint32_t id = allocate();
+        Proxy& p = proxies[id];
+        p = {};
+        p.userData = userData;
+        p.hierarchy = &hierarchy;
+        p.node = node;
+        p.halfX = halfExtent[0]; p.halfY = halfExtent[1];
+        p.alive = true;
+        if (hierarchy.isValid(node)) { setFromTransform(p, hierarchy.getGlobalTransform(node)); }
+        return id;
+    }
+
+    void SpatialHash2D::update(uint32_t id, const vec2& min, const vec2& max) {
+        Proxy& p = proxies[id];
+        p.minX = min[0]; p.minY = min[1];
+        p.maxX = max[0]; p.maxY = max[1];
+        dirty = true;
+    }
+
+    void SpatialHash2D::update(const uint32_t* ids, const vec2* mins, const vec2* maxs, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            Proxy& p = proxies[ids[i]];
+            p.minX = mins[i][0]; p.minY = mins[i][1];
+            p.maxX = maxs[i][0]; p.maxY = maxs[i][1];
+        }
+        if (count) { dirty = true; }
+    }
+
+    void SpatialHash2D::setFromTransform(Proxy& p, const mat4& g) {
+        const float ex = std::abs(g._11) * p.halfX + std::abs(g._12) * p.halfY;
+        const float ey = std::abs(g._21) * p.halfX + std::abs(g._22) * p.halfY;
+        p.minX = g._14 - ex; p.maxX = g._14 + ex;
+        p.minY = g._24 - ey; p.maxY = g._24 + ey;
+        dirty = true;
+    }
+
+    void SpatialHash2D::syncTransforms() {
+        for (Proxy& p : proxies) {
+            if (!p.alive) continue;
+            if (p.transform) { setFromTransform(p, p.transform->getGlobalTransform()); }
+            else if (p.hierarchy && p.hierarchy->isValid(p.node)) { setFromTransform(p, p.hierarchy->getGlobalTransform(p.node)); }
+        }
+    }
+
+    void SpatialHash2D::remove(uint32_t id) {
+        Proxy& p = proxies[id];
+        if (!p.alive) return;
+        p.alive = false;
+        p.transform = nullptr;
+        p.hierarchy = nullptr;
+        freeIds.push_back(id);
+        dirty = true;
+    }
+
+    void SpatialHash2D::clear() {
+        proxies.clear();
+        freeIds.clear();
+        stamps.clear();
+        dirty = true;
+    }
+
+    void SpatialHash2D::rebuild() {
+        if (!dirty) return;
+        dirty = false;
+        oversized.clear();
+
+        // 1회차: 격자에 들어갈 칸 수를 셉니다.
+        size_t total = 0;
+        for (uint32_t id = 0; id < proxies.size(); id++) {
+            Proxy& p = proxies[id];
+            if (!p.alive) continue;
+            // NaN이 섞인 상자는 어떤 상자와도 겹치지 않으므로 격자와 oversized 어디에도 넣지 않습니다.
+            if (isNaN(p)) { p.inGrid = false; continue; }
+            const int64_t w = (int64_t)cellOf(p.maxX) - cellOf(p.minX) + 1;
+            const int64_t h = (int64_t)cellOf(p.maxY) - cellOf(p.minY) + 1;
+            p.inGrid = w > 0 && h > 0 && w * h <= maxCells;
+            if (p.inGrid) { total += (size_t)(w * h); }
+            else { oversized.push_back(id); }
+        }
+
+        // 버킷 수는 칸 수의 2배 이상인 2의 거듭제곱으로 잡아 충돌을 줄입니다.
+        uint32_t buckets = 16;
+        while (buckets < total * 2 && buckets < (1u << 30)) { buckets <<= 1; }
+        bucketMask = buckets - 1;
+        bucketStart.assign((size_t)buckets + 1, 0);
+        entries.resize(total);
+
+        for (const Proxy& p : proxies) {
+            if (!p.alive || !p.inGrid) continue;
+            const int32_t x0 = cellOf(p.minX), x1 = cellOf(p.maxX), y0 = cellOf(p.minY), y1 = cellOf(p.maxY);
+            for (int32_t y = y0; y <= y1; y++) {
+                for (int32_t x = x0; x <= x1; x++) { bucketStart[(size_t)bucketOf(x, y) + 1]++; }
+            }
+        }
+        for (uint32_t b = 0; b < buckets; b++) { bucketStart[(size_t)b + 1] += bucketStart[b]; }
+
+        // 2회차: 버킷 순으로 항목을 채웁니다. 채우면서 앞당긴 시작 위치는 마지막에 되돌립니다.
+        for (uint32_t id = 0; id < proxies.size(); id++) {
+            const Proxy& p = proxies[id];
+            if (!p.alive || !p.inGrid) continue;
+            const int32_t x0 = cellOf(p.minX), x1 = cellOf(p.maxX), y0 = cellOf(p.minY), y1 = cellOf(p.maxY);
+            for (int32_t y = y0; y <= y1; y++) {
+                for (int32_t x = x0; x <= x1; x++) { entries[bucketStart[bucketOf(x, y)]++] = { x, y, id }; }
+            }
+        }
+        for (uint32_t b = buckets; b > 0; b--) { bucketStart[b] = bucketStart[b - 1]; }
+        bucketStart[0] = 0;
+    }
+
+    template<class F>
+    void SpatialHash2D::forEachOverlap(float minX, float minY, float maxX, float maxY, F&& f) {
+        rebuild();
+        if (++stamp == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            stamp = 1;
+        }
+        Proxy q{};
+        q.minX = minX; q.minY = minY; q.maxX = maxX; q.maxY = maxY;
+        const int32_t x0 = cellOf(minX), x1 = cellOf(maxX), y0 = cellOf(minY), y1 = cellOf(maxY);
+        const int64_t cells = ((int64_t)x1 - x0 + 1) * ((int64_t)y1 - y0 + 1);
+        if (cells > (int64_t)entries.size()) {
+            // 영역이 격자 항목 수보다 많은 칸을 덮으면 칸을 도는 것보다 전체를 한 번 보는 것이 빠릅니다.
+            for (uint32_t id = 0; id < proxies.size(); id++) {
+                if (proxies[id].alive && overlaps(proxies[id], q)) { f(id); }
+            }
+            return;
+        }
+        for (int32_t y = y0; y <= y1; y++) {
+            for (int32_t x = x0; x <= x1; x++) {
+                const uint32_t b = bucketOf(x, y);
+                for (uint32_t e = bucketStart[b]; e < bucketStart[(size_t)b + 1]; e++) {
+                    const uint32_t id = entries[e].id;
+                    if (stamps[id] == stamp) continue;
+                    stamps[id] = stamp;
+                    if (overlaps(proxies[id], q)) { f(id); }
+                }
+            }
+        }
+        for (uint32_t id : oversized) {
+            if (overlaps(proxies[id], q)) { f(id); }
+        }
+    }
+
+    void SpatialHash2D::query(const vec2& min, const vec2& max, std::vector<uint32_t>& out) {
+        forEachOverlap(min[0], min[1], max[0], max[1], [&out](uint32_t id) { out.push_back(id); });
+    }
+
+    void SpatialHash2D::query(const vec2* mins, const vec2* maxs, size_t count, std::vector<uint32_t>& out, std::vector<uint32_t>& offsets) {
+        offsets.resize(count + 1);
+        for (size_t i = 0; i < count; i++) {
+            offsets[i] = (uint32_t)out.size();
+            forEachOverlap(mins[i][0], mins[i][1], maxs[i][0], maxs[i][1], [&out](uint32_t id) { out.push_back(id); });
+        }
+        offsets[count] = (uint32_t)out.size();
+    }
+
+    void SpatialHash2D::queryPoint(const vec2& p, std::vector<uint32_t>& out) {
+        forEachOverlap(p[0], p[1], p[0], p[1], [&out](uint32_t id) { out.push_back(id); });
+    }
+
+    void SpatialHash2D::findPairs(std::vector<std::pair<uint32_t, uint32_t>>& out) {
+        rebuild();
+        // 두 상자가 여러 칸을 공유해도 겹친 영역의 최소 모서리가 속한 칸에서만 보고하여 중복을 없앱니다. 그 점은 두 상자에 모두 포함되므로 두 상자 모두 그 칸에 들어 있습니다.
+        const uint32_t buckets = bucketMask + 1;
+        for (uint32_t b = 0; b < buckets; b++) {
+            const uint32_t begin = bucketStart[b], end = bucketStart[(size_t)b + 1];
+            for (uint32_t i = begin; i < end; i++) {
+                const Entry& ei = entries[i];
+                const Proxy& pi = proxies[ei.id];
+                for (uint32_t j = i + 1; j < end; j++) {
+                    const Entry& ej = entries[j];
+                    if (ej.cellX != ei.cellX || ej.cellY != ei.cellY) continue;
+                    const Proxy& pj = proxies[ej.id];
+                    if (!overlaps(pi, pj)) continue;
+                    if (cellOf(std::max(pi.minX, pj.minX)) != ei.cellX || cellOf(std::max(pi.minY, pj.minY)) != ei.cellY) continue;
+                    out.emplace_back(std::min(ei.id, ej.id), std::max(ei.id, ej.id));
+                }
+            }
+        }
+        for (uint32_t o : oversized) {
+            const Proxy& po = proxies[o];
+            for (uint32_t id = 0; id < proxies.size(); id++) {
+                const Proxy& p = proxies[id];
+                if (id == o || !p.alive || (!p.inGrid && id < o)) continue;
+                if (overlaps(po, p)) { out.emplace_back(std::min(o, id), std::max(o, id)); }
+            }
+        }
+    }
+}
@@ -0,0 +1,117 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef __YR_SPATIALHASH_H__
+#define __YR_SPATIALHASH_H__
+
+#include "yr_scene.h"
+
+#include <cmath>
+#include <vector>
+#include <utility>
+
+namespace onart {
+
+    /// @brief 2D 축 정렬 경계 상자를 균일 격자 칸에 해시하여 영역/점 검색과 겹치는 쌍 생성을 빠르게 하는 광역 단계(broadphase) 구조입니다.
+    /// 추가/변경/제거는 상자만 기록하며, 다음 검색 시 모든 칸을 계수 정렬로 한 번에 다시 만듭니다. 따라서 매 프레임 많은 상자를 옮긴 뒤 검색하는 경우에 알맞습니다.
+    /// 칸을 maxCellsPerProxy개보다 많이 덮는 큰 상자는 격자에 넣지 않고 따로 모아 선형으로 검사합니다.
+    class SpatialHash2D {
+        public:
+            /// @param cellSize 격자 한 칸의 크기. 대부분의 상자보다 조금 크게 잡는 것이 좋습니다.
+            /// @param maxCellsPerProxy 상자 하나가 격자에 들어갈 최대 칸 수
+            SpatialHash2D(float cellSize = 64, uint32_t maxCellsPerProxy = 64);
+            /// @brief 상자를 추가하고 그 번호를 리턴합니다.
+            /// @param userData 상자에 붙여 둘 임의의 값
+            uint32_t insert(const vec2& min, const vec2& max, uint64_t userData = 0);
+            /// @brief 상자 여러 개를 추가합니다. 번호는 ids에 차례로 기록됩니다.
+            void insert(const vec2* mins, const vec2* maxs, size_t count, uint32_t* ids, const uint64_t* userData = nullptr);
+            /// @brief 주어진 Transform을 따라다니는 상자를 추가합니다. 상자는 지역 공간에서 원점 중심, 반 길이 halfExtent이며 syncTransforms()에서 전역 변환을 반영합니다.
+            /// Transform을 삭제하기 전에 remove()로 상자를 먼저 제거해야 합니다.
+            uint32_t insert(Transform* transform, const vec2& halfExtent, uint64_t userData = 0);
+            /// @brief TransformHierarchy의 노드를 따라다니는 상자를 추가합니다. 나머지는 Transform을 받는 insert()와 같으며, 노드가 무효해지면 상자는 마지막 위치에 남습니다.
+            uint32_t insert(const TransformHierarchy& hierarchy, TransformHandle node, const vec2& halfExtent, uint64_t userData = 0);
+            /// @brief 상자 위치를 바꿉니다.
+            void update(uint32_t id, const vec2& min, const vec2& max);
+            /// @brief 상자 여러 개의 위치를 바꿉니다.
+            void update(const uint32_t* ids, const vec2* mins, const vec2* maxs, size_t count);
+            /// @brief Transform/TransformHierarchy 노드에 연결된 모든 상자를 현재 전역 변환으로 갱신합니다. 전역 변환의 회전/배율은 상자를 감싸는 축 정렬 상자로 반영됩니다.
+            /// TransformHierarchy 노드는 마지막 TransformHierarchy::update() 시점의 값을 씁니다.
+            void syncTransforms();
+            /// @brief 상자를 제거합니다. 번호는 이후 추가에서 재사용됩니다.
+            void remove(uint32_t id);
+            /// @brief 모든 상자를 제거합니다.
+            void clear();
+            /// @brief 주어진 영역과 겹치는(접하는 경우 포함) 상자의 번호를 out 뒤에 추가합니다. 순서는 정해져 있지 않습니다.
+            void query(const vec2& min, const vec2& max, std::vector<uint32_t>& out);
+            /// @brief 영역 여러 개를 한 번에 검색합니다. i번째 영역과 겹치는 상자 번호는 out[offsets[i]]부터 out[offsets[i + 1]] 앞까지 추가됩니다.
+            /// offsets는 count + 1 크기로 덮어씌워지며 값은 out 전체 기준 위치입니다. 격자 재구성과 중복 제거용 표시는 모든 영역에서 함께 씁니다.
+            void query(const vec2* mins, const vec2* maxs, size_t count, std::vector<uint32_t>& out, std::vector<uint32_t>& offsets);
+            /// @brief 주어진 점을 포함하는 상자의 번호를 out 뒤에 추가합니다. 마우스 선택 등에 사용합니다.
+            void queryPoint(const vec2& p, std::vector<uint32_t>& out);
+            /// @brief 서로 겹치는 모든 상자 쌍을 out 뒤에 추가합니다. 각 쌍은 한 번씩만 나오며 first < second입니다.
+            void findPairs(std::vector<std::pair<uint32_t, uint32_t>>& out);
+            inline uint64_t getUserData(uint32_t id) const { return proxies[id].userData; }
+            inline vec2 getMin(uint32_t id) const { return vec2(proxies[id].minX, proxies[id].minY); }
+            inline vec2 getMax(uint32_t id) const { return vec2(proxies[id].maxX, proxies[id].maxY); }
+            /// @brief 살아 있는 상자 수를 리턴합니다.
+            inline size_t size() const { return proxies.size() - freeIds.size(); }
+        private:
+            struct Proxy {
+                float minX, minY, maxX, maxY;
+                uint64_t userData;
+                Transform* transform;
+                const TransformHierarchy* hierarchy;
+                TransformHandle node;
+                float halfX, halfY;
+                bool alive;
+                bool inGrid; // 마지막 rebuild()에서 격자에 넣었으면 참. 거짓이면 oversized에 있습니다.
+            };
+            /// @brief 격자 칸 하나에 들어간 상자입니다. 해시 충돌로 한 버킷에 여러 칸이 섞이므로 칸 좌표를 함께 둡니다.
+            struct Entry {
+                int32_t cellX, cellY;
+                uint32_t id;
+            };
+            /// @brief 칸 좌표 범위. NaN/무한대/아주 큰 값을 정수로 바꾸는 것은 미정의 동작이므로 먼저 이 범위로 자르며, 칸을 순회하는 반복문이 넘치지 않도록 int32 범위보다 좁게 잡습니다.
+            static constexpr int32_t CELL_LIMIT = 1 << 30;
+            inline int32_t cellOf(float v) const {
+                const float c = std::floor(v * invCellSize);
+                if (!(c > (float)-CELL_LIMIT)) return -CELL_LIMIT; // NaN 포함
+                if (c >= (float)CELL_LIMIT) return CELL_LIMIT;
+                return (int32_t)c;
+            }
+            inline uint32_t bucketOf(int32_t x, int32_t y) const { return (((uint32_t)x * 73856093u) ^ ((uint32_t)y * 19349663u)) & bucketMask; }
+            inline static bool isNaN(const Proxy& p) { return p.minX != p.minX || p.minY != p.minY || p.maxX != p.maxX || p.maxY != p.maxY; }
+            inline static bool overlaps(const Proxy& a, const Proxy& b) { return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY; }
+            uint32_t allocate();
+            /// @brief 지역 상자 [-half, half]를 전역 변환한 것을 감싸는 축 정렬 상자로 상자를 바꿉니다.
+            void setFromTransform(Proxy& proxy, const mat4& global);
+            /// @brief 바뀐 상자가 있으면 격자를 다시 만듭니다.
+            void rebuild();
+            /// @brief 영역과 겹치는 상자마다 f(id)를 한 번씩 호출합니다.
+            template<class F>
+            void forEachOverlap(float minX, float minY, float maxX, float maxY, F&& f);
+            std::vector<Proxy> proxies;
+            std::vector<uint32_t> freeIds;
+            std::vector<uint32_t> bucketStart; // 버킷별 entries 시작 위치. 크기는 버킷 수 + 1
+            std::vector<Entry> entries;
+            std::vector<uint32_t> oversized; // 격자에 넣지 않은 큰 상자
+            std::vector<uint32_t> stamps; // 검색 중복 제거용. 이번 검색 번호와 같으면 이미 보고한 상자
+            float cellSize, invCellSize;
+            uint32_t maxCells;
+            uint32_t bucketMask = 0;
+            uint32_t stamp = 0;
+            bool dirty = true;
+    };
+}
+
+#endif
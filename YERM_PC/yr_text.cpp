@@ -0,0 +1,260 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "yr_text.h"
+#include "yr_string.hpp"
+#include "logger.hpp"
+
+#include <cmath>
+#include <cstring>
+
+#include "../externals/single_header/stb_truetype.h"
+#include <fstream>
+
+namespace onart {
+#ifdef YR_HAS_TEXT
+
+    /// @brief stb_truetype을 이용하는 래스터화기입니다.
+    class TrueTypeRasterizer: public GlyphRasterizer {
+    public:
+        inline bool init(std::vector<uint8_t>&& data) {
+            file = std::move(data);
+            int offset = stbtt_GetFontOffsetForIndex(file.data(), 0);
+            if (offset < 0 || !stbtt_InitFont(&info, file.data(), offset)) return false;
+            int lineGap;
+            stbtt_GetFontVMetrics(&info, &asc, &desc, &lineGap);
+            gap = lineGap;
+            return true;
+        }
+        bool rasterize(uint32_t codepoint, float pixelHeight, GlyphBitmap& out) override {
+            int index = stbtt_FindGlyphIndex(&info, (int)codepoint);
+            if (index == 0 && codepoint != 0) return false;
+            const float scale = stbtt_ScaleForPixelHeight(&info, pixelHeight);
+            int advance, bearing, x0, y0, x1, y1;
+            stbtt_GetGlyphHMetrics(&info, index, &advance, &bearing);
+            stbtt_GetGlyphBitmapBox(&info, index, scale, scale, &x0, &y0, &x1, &y1);
+            out.advance = advance * scale;
+            out.left = x0;
+            out.top = y0;
+            out.width = x1 > x0 ? x1 - x0 : 0;
+            out.height = y1 > y0 ? y1 - y0 : 0;
+            out.coverage.resize((size_t)out.width * out.height);
+            if (out.width && out.height) { stbtt_MakeGlyphBitmap(&info, out.coverage.data(), out.width, out.height, out.width, scale, scale, index); }
+            return true;
+        }
+        float ascent(float pixelHeight) override { return asc * stbtt_ScaleForPixelHeight(&info, pixelHeight); }
+        float lineHeight(float pixelHeight) override { return (asc - desc + gap) * stbtt_ScaleForPixelHeight(&info, pixelHeight); }
+        float kerning(uint32_t a, uint32_t b, float pixelHeight) override { return stbtt_GetCodepointKernAdvance(&info, (int)a, (int)b) * stbtt_ScaleForPixelHeight(&info, pixelHeight); }
+    private:
+        std::vector<uint8_t> file;
+        stbtt_fontinfo info{};
+        int asc = 0, desc = 0, gap = 0;
+    };
+
+    /// @brief 글꼴 데이터가 CFF 윤곽선을 쓰는지(sfnt 버전 'OTTO' 또는 'CFF ', 'CFF2' 테이블) 확인합니다. 글꼴 모음은 첫 글꼴을 봅니다.
+    static bool usesCFF(const uint8_t* data, size_t size) {
+        auto be32 = [data](size_t at) { return ((uint32_t)data[at] << 24) | ((uint32_t)data[at + 1] << 16) | ((uint32_t)data[at + 2] << 8) | data[at + 3]; };
+        if (size < 12) return false;
+        size_t offset = 0;
+        if (std::memcmp(data, "ttcf", 4) == 0) {
+            if (size < 16) return false;
+            offset = be32(12);
+            if (offset > size - 12) return false;
+        }
+        if (std::memcmp(data + offset, "OTTO", 4) == 0) return true;
+        const uint32_t tables = ((uint32_t)data[offset + 4] << 8) | data[offset + 5];
+        for (uint32_t i = 0; i < tables; i++) {
+            const size_t record = offset + 12 + (size_t)i * 16;
+            if (record + 4 > size) break;
+            if (std::memcmp(data + record, "CFF ", 4) == 0 || std::memcmp(data + record, "CFF2", 4) == 0) return true;
+        }
+        return false;
+    }
+
+    std::shared_ptr<Font> Font::load(const char* fileName, float basePixelHeight, uint32_t spread) {
+        std::ifstream f(fileName, std::ios::binary | std::ios::ate);
+        if (!f) {
+            LOGWITH("Failed to open font file:", fileName);
+            return {};
+        }
+        std::vector<uint8_t> data((size_t)f.tellg());
+        f.seekg(0);
+        f.read((char*)data.data(), data.size());
+        return load(data.data(), data.size(), basePixelHeight, spread);
+    }
+
+    std::shared_ptr<Font> Font::load(const void* mem, size_t size, float basePixelHeight, uint32_t spread) {
+        std::unique_ptr<TrueTypeRasterizer> rasterizer = std::make_unique<TrueTypeRasterizer>();
+        if (!rasterizer->init(std::vector<uint8_t>((const uint8_t*)mem, (const uint8_t*)mem + size))) {
+            if (usesCFF((const uint8_t*)mem, size)) { LOGWITH("CFF-outline (OpenType .otf) fonts are not supported. Use a font with TrueType (glyf) outlines"); }
+            else { LOGWITH("Invalid font data"); }
+            return {};
+        }
+        return std::make_shared<Font>(std::move(rasterizer), basePixelHeight, spread);
+    }
+#endif // YR_HAS_TEXT
+
+    /// @brief 1차원 제곱 거리 변환 (Felzenszwalb & Huttenlocher). f를 n개 간격 stride로 읽고 결과를 그 자리에 씁니다.
+    static void edt1D(float* f, size_t stride, int32_t n, float* d, float* v, float* z) {
+        int32_t k = 0;
+        v[0] = 0;
+        z[0] = -INFINITY;
+        z[1] = INFINITY;
+        for (int32_t q = 1; q < n; q++) {
+            const float fq = f[q * stride] + (float)q * q;
+            int32_t p = (int32_t)v[k];
+            float s = (fq - (f[p * stride] + (float)p * p)) / (2.0f * (q - p));
+            while (s <= z[k]) { // z[0]이 -무한대이므로 k는 0 아래로 내려가지 않음
+                k--;
+                p = (int32_t)v[k];
+                s = (fq - (f[p * stride] + (float)p * p)) / (2.0f * (q - p));
+            }
+            k++;
+            v[k] = (float)q;
+            z[k] = s;
+            z[k + 1] = INFINITY;
+        }
+        k = 0;
+        for (int32_t q = 0; q < n; q++) {
+            while (z[k + 1] < q) k++;
+            const int32_t p = (int32_t)v[k];
+            d[q] = (float)(q - p) * (q - p) + f[p * stride];
+        }
+        for (int32_t q = 0; q < n; q++) { f[q * stride] = d[q]; }
+    }
+
+    /// @brief 2차원 제곱 거리 변환. 값이 0인 칸까지의 제곱 거리로 grid를 바꿉니다.
+    static void edt2D(float* grid, int32_t width, int32_t height, float* scratch) {
+        const int32_t n = width > height ? width : height;
+        float* d = scratch;
+        float* v = d + n;
+        float* z = v + n;
+        for (int32_t x = 0; x < width; x++) { edt1D(grid + x, width, height, d, v, z); }
+        for (int32_t y = 0; y < height; y++) { edt1D(grid + (size_t)y * width, 1, width, d, v, z); }
+    }
+
+    void coverageToSDF(const uint8_t* coverage, int32_t width, int32_t height, uint32_t spread, std::vector<uint8_t>& out, std::vector<float>& work) {
+        const int32_t s = (int32_t)spread;
+        const int32_t w = width + 2 * s, h = height + 2 * s;
+        const size_t area = (size_t)w * h;
+        const int32_t n = w > h ? w : h;
+        work.resize(area * 2 + (size_t)n * 3 + 1);
+        float* outside = work.data(); // 안쪽 픽셀까지의 제곱 거리
+        float* inside = outside + area; // 바깥 픽셀까지의 제곱 거리
+        float* scratch = inside + area;
+        constexpr float FAR = 1e20f;
+        for (int32_t y = 0; y < h; y++) {
+            for (int32_t x = 0; x < w; x++) {
+                const int32_t cx = x - s, cy = y - s;
+                const bool in = cx >= 0 && cy >= 0 && cx < width && cy < height && coverage[(size_t)cy * width + cx] >= 128;
+                outside[(size_t)y * w + x] = in ? 0 : FAR;
+                inside[(size_t)y * w + x] = in ? FAR : 0;
+            }
+        }
+        edt2D(outside, w, h, scratch);
+        edt2D(inside, w, h, scratch);
+        out.resize(area * 4);
+        // 경계는 안쪽/바깥쪽 픽셀 사이에 있으므로 양쪽 거리에서 반 픽셀씩 뺍니다.
+        const float invRange = 1.0f / (2.0f * (float)(s > 0 ? s : 1));
+        for (size_t i = 0; i < area; i++) {
+            const float dist = inside[i] > 0 ? std::sqrt(inside[i]) - 0.5f : 0.5f - std::sqrt(outside[i]);
+            float value = 0.5f + dist * invRange;
+            value = value < 0 ? 0 : (value > 1 ? 1 : value);
+            uint8_t* px = &out[i * 4];
+            px[0] = px[1] = px[2] = 255;
+            px[3] = (uint8_t)(value * 255.0f + 0.5f);
+        }
+    }
+
+#ifdef YR_HAS_TEXT
+    Font::Font(std::unique_ptr<GlyphRasterizer>&& rasterizer, float basePixelHeight, uint32_t spread, uint32_t atlasPageSize)
+        :rasterizer(std::move(rasterizer)), atlas(atlasPageSize, atlasPageSize, 1), baseHeight(basePixelHeight), spread(spread) {
+        ascent = this->rasterizer->ascent(basePixelHeight);
+        lineHeight = this->rasterizer->lineHeight(basePixelHeight);
+    }
+
+    const Font::Glyph* Font::getGlyph(uint32_t codepoint) {
+        auto it = glyphs.find(codepoint);
+        if (it != glyphs.end()) return &it->second;
+        if (!rasterizer->rasterize(codepoint, baseHeight, scratch)) return nullptr;
+        Glyph& glyph = glyphs[codepoint];
+        glyph.advance = scratch.advance;
+        glyph.left = (float)scratch.left - spread;
+        glyph.top = (float)scratch.top - spread;
+        glyph.width = (float)(scratch.width + 2 * spread);
+        glyph.height = (float)(scratch.height + 2 * spread);
+        if (scratch.width > 0 && scratch.height > 0) {
+            coverageToSDF(scratch.coverage.data(), scratch.width, scratch.height, spread, sdf, edtBuffer);
+            glyph.atlasId = atlas.add(sdf.data(), (uint32_t)glyph.width, (uint32_t)glyph.height);
+        }
+        return &glyph;
+    }
+
+    void Font::preload(const char* utf8) {
+        for (const char* p = utf8; *p;) { getGlyph((uint32_t)u82int(p)); }
+        flush();
+    }
+
+    /// @brief utf8 문자열을 배치합니다. 글자마다 emit(glyph, x, y, scale)을 호출하고 영역 크기를 리턴합니다.
+    template<class F>
+    static vec2 layoutText(Font& font, const char* utf8, float pixelHeight, F&& emit) {
+        const float scale = pixelHeight / font.getBaseHeight();
+        const float lineHeight = font.getLineHeight() * scale;
+        float x = 0, baseline = font.getAscent() * scale, maxX = 0;
+        uint32_t prev = 0;
+        for (const char* p = utf8; *p;) {
+            const uint32_t cp = (uint32_t)u82int(p);
+            if (cp == '\n') {
+                maxX = x > maxX ? x : maxX;
+                x = 0;
+                baseline += lineHeight;
+                prev = 0;
+                continue;
+            }
+            const Font::Glyph* glyph = font.getGlyph(cp);
+            if (!glyph) continue;
+            if (prev) { x += font.kerning(prev, cp) * scale; }
+            emit(*glyph, x, baseline, scale);
+            x += glyph->advance * scale;
+            prev = cp;
+        }
+        maxX = x > maxX ? x : maxX;
+        return vec2(maxX, baseline - font.getAscent() * scale + lineHeight);
+    }
+
+    vec2 measureText(Font& font, const char* utf8, float pixelHeight) {
+        return layoutText(font, utf8, pixelHeight, [](const Font::Glyph&, float, float, float) {});
+    }
+
+    vec2 drawText(SpriteBatch& batch, Font& font, const char* utf8, const mat4& transform, float pixelHeight, const vec4& color) {
+        // 새 글리프를 모두 만든 뒤 한 번만 올려야 페이지 텍스처가 글자마다 다시 만들어지지 않습니다.
+        font.preload(utf8);
+        TextureAtlas& atlas = font.getAtlas();
+        const vec4 c0 = transform.col(0), c1 = transform.col(1), c2 = transform.col(2), c3 = transform.col(3);
+        return layoutText(font, utf8, pixelHeight, [&](const Font::Glyph& glyph, float x, float baseline, float scale) {
+            if (glyph.atlasId == UINT32_MAX) return;
+            // 기본 사각형(-1~1)을 글리프 사각형으로 옮기는 변환을 transform 뒤에 곱한 결과
+            const float hw = glyph.width * scale * 0.5f, hh = glyph.height * scale * 0.5f;
+            const float cx = x + glyph.left * scale + hw, cy = baseline + glyph.top * scale + hh;
+            const vec4 x0 = c0 * hw, y0 = c1 * hh, t = c0 * cx + c1 * cy + c3;
+            const mat4 model(
+                x0[0], y0[0], c2[0], t[0],
+                x0[1], y0[1], c2[1], t[1],
+                x0[2], y0[2], c2[2], t[2],
+                x0[3], y0[3], c2[3], t[3]
+            );
+            batch.add(model, atlas.getTextureOf(glyph.atlasId), atlas.getTexrect(glyph.atlasId), color);
+        });
+    }
+#endif // YR_HAS_TEXT
+}
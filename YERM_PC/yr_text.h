@@ -0,0 +1,112 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef __YR_TEXT_H__
+#define __YR_TEXT_H__
+
+#include "yr_2d.h"
+#include "yr_atlas.h"
+
+#include <memory>
+#include <unordered_map>
+
+// SDF 글자 파이프라인(get2DTextPipeline())이 없는 D3D11에서는 Font와 drawText, measureText를 사용할 수 없습니다.
+#ifndef YR_USE_D3D11
+#define YR_HAS_TEXT
+#endif
+
+namespace onart {
+
+    /// @brief 글리프 1개의 래스터화 결과입니다. 좌표는 기준선 원점, y 아래 방향 기준(px)입니다.
+    struct GlyphBitmap {
+        std::vector<uint8_t> coverage; // width * height, 0~255
+        int32_t width = 0, height = 0;
+        int32_t left = 0, top = 0; // 비트맵 좌상단의 기준선 원점 대비 위치. top은 보통 음수입니다.
+        float advance = 0; // 다음 글자까지의 가로 거리
+    };
+
+    /// @brief 유니코드 글리프를 주어진 크기의 흑백 비트맵으로 만드는 인터페이스입니다.
+    class GlyphRasterizer {
+    public:
+        virtual ~GlyphRasterizer() = default;
+        /// @brief 글리프를 래스터화합니다. 폰트에 없는 글자면 false를 리턴합니다. 공백처럼 비트맵이 없는 글자는 크기 0으로 채우고 true를 리턴합니다.
+        virtual bool rasterize(uint32_t codepoint, float pixelHeight, GlyphBitmap& out) = 0;
+        /// @brief 기준선 위쪽 높이(px)를 리턴합니다.
+        virtual float ascent(float pixelHeight) = 0;
+        /// @brief 줄 간격(px)을 리턴합니다.
+        virtual float lineHeight(float pixelHeight) = 0;
+        /// @brief 두 글자 사이 커닝(px)을 리턴합니다.
+        virtual float kerning(uint32_t, uint32_t, float) { return 0; }
+    };
+
+#ifdef YR_HAS_TEXT
+    /// @brief 글리프를 처음 요청될 때 기준 크기로 래스터화하고 부호 있는 거리장(SDF)으로 바꾸어 TextureAtlas에 보관합니다.
+    /// SDF이므로 한 번 만든 글리프를 get2DTextPipeline()으로 여러 크기로 그릴 수 있습니다.
+    class Font {
+    public:
+        struct Glyph {
+            uint32_t atlasId = UINT32_MAX; // 비트맵이 없는 글자면 UINT32_MAX
+            float left, top, width, height; // 거리장 여백을 포함한 사각형(기준 크기 px)
+            float advance;
+        };
+        /// @param rasterizer 글리프 래스터화기
+        /// @param basePixelHeight 아틀라스에 보관할 기준 크기(px). 이보다 몇 배 크게 그려도 경계가 유지됩니다.
+        /// @param spread 거리장 범위(px). 글리프 둘레에 이만큼 여백이 붙습니다.
+        /// @param atlasPageSize 아틀라스 페이지 크기(px)
+        Font(std::unique_ptr<GlyphRasterizer>&& rasterizer, float basePixelHeight = 48, uint32_t spread = 6, uint32_t atlasPageSize = 1024);
+        /// @brief TrueType 윤곽선(glyf 테이블)을 쓰는 글꼴 파일(.ttf, .ttc의 첫 글꼴, glyf 기반 .otf)로 글꼴을 만듭니다. 실패하면 빈 포인터를 리턴합니다.
+        /// CFF 윤곽선을 쓰는 OpenType 글꼴(대부분의 .otf)은 지원하지 않으며, 이 경우 그 사실을 로그로 남기고 빈 포인터를 리턴합니다.
+        static std::shared_ptr<Font> load(const char* fileName, float basePixelHeight = 48, uint32_t spread = 6);
+        /// @brief 메모리의 글꼴 데이터로 글꼴을 만듭니다. 데이터는 복사됩니다. 지원 형식과 실패 시 동작은 파일을 받는 load()와 같습니다.
+        static std::shared_ptr<Font> load(const void* mem, size_t size, float basePixelHeight = 48, uint32_t spread = 6);
+        /// @brief 글리프를 리턴합니다. 없으면 만들어 아틀라스에 추가합니다. 폰트에 없는 글자면 nullptr를 리턴합니다.
+        const Glyph* getGlyph(uint32_t codepoint);
+        /// @brief 주어진 utf8 문자열의 글리프를 미리 만들고 아틀라스를 올립니다. 자주 쓰는 글자를 미리 준비해 두면 그리는 도중 페이지를 다시 올리는 일을 줄일 수 있습니다.
+        void preload(const char* utf8);
+        /// @brief 새로 추가된 글리프가 있는 페이지를 올립니다.
+        inline void flush() { atlas.flush(); }
+        inline TextureAtlas& getAtlas() { return atlas; }
+        inline float getBaseHeight() const { return baseHeight; }
+        inline float getAscent() const { return ascent; }
+        inline float getLineHeight() const { return lineHeight; }
+        inline float kerning(uint32_t a, uint32_t b) { return rasterizer->kerning(a, b, baseHeight); }
+    private:
+        std::unique_ptr<GlyphRasterizer> rasterizer;
+        std::unordered_map<uint32_t, Glyph> glyphs;
+        TextureAtlas atlas;
+        GlyphBitmap scratch;
+        std::vector<uint8_t> sdf;
+        std::vector<float> edtBuffer;
+        float baseHeight, ascent, lineHeight;
+        uint32_t spread;
+    };
+
+#endif // YR_HAS_TEXT
+
+    /// @brief 흑백 비트맵을 부호 있는 거리장으로 바꿉니다. 결과는 (width + 2 * spread) x (height + 2 * spread) 크기 RGBA이며 RGB는 255, A는 경계에서 128입니다.
+    /// @param work 작업 공간. 호출 간에 재사용하면 할당을 줄일 수 있습니다.
+    void coverageToSDF(const uint8_t* coverage, int32_t width, int32_t height, uint32_t spread, std::vector<uint8_t>& out, std::vector<float>& work);
+
+#ifdef YR_HAS_TEXT
+    /// @brief utf8 문자열을 글리프 사각형으로 배치하여 배치(batch)에 추가합니다. 같은 아틀라스 페이지를 쓰는 글자는 인스턴스 드로우 1회로 그려집니다.
+    /// 배치는 get2DTextPipeline()을 사용해야 합니다. 좌표는 첫 줄 좌상단이 원점이고 x 오른쪽, y 아래 방향이며 단위는 px입니다. '\n'에서 줄을 바꿉니다.
+    /// @param transform 배치된 글자 전체에 적용할 변환
+    /// @param pixelHeight 글자 크기(px)
+    /// @return 배치된 글자 영역의 크기(px)
+    vec2 drawText(SpriteBatch& batch, Font& font, const char* utf8, const mat4& transform, float pixelHeight, const vec4& color = vec4(1));
+    /// @brief drawText로 그렸을 때의 영역 크기(px)를 리턴합니다. 글리프를 새로 만들 수 있습니다.
+    vec2 measureText(Font& font, const char* utf8, float pixelHeight);
+#endif // YR_HAS_TEXT
+}
+
+#endif
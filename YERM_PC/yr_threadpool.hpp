@@ -16,8 +16,10 @@
 
 #include <cstdint>
 
+#include <algorithm>
 #include <functional>
 #include <deque>
+#include <memory>
 #include <vector>
 #include <mutex>
 #include <thread>
@@ -36,7 +38,7 @@ namespace onart{
         };
         inline void clear(){
             head = tail = ~0u;
-            ind.resize(ind.capacity());
+            ind.resize(data.size());
             for(size_t i = 0 ; i < ind.size() ; i++){
                 ind[i] = (uint32_t)(ind.size() - 1 - i);
             }
@@ -48,11 +50,13 @@ namespace onart{
         }
         inline void enqueue(const T& v) {
             if(ind.size() == 0) {
-                size_t newSize = data.size() * 2;
-                for (size_t i = data.size(); i < newSize; i++) { ind[i] = uint32_t(newSize - 1 - i); }
+                size_t oldSize = data.size();
+                size_t newSize = oldSize ? oldSize * 2 : 16;
                 data.resize(newSize);
+                for (size_t i = newSize; i > oldSize; i--) { ind.push_back(uint32_t(i - 1)); }
             }
             uint32_t newTail = ind.back();
+            ind.pop_back();
             data[newTail].v = v;
             data[newTail].next = ~0u;
 
@@ -99,8 +103,9 @@ namespace onart{
             Node* obt = const_cast<Node*>(reinterpret_cast<const Node*>(oneBeforeTarget));
             uint32_t next = obt->next;
             if(next == ~0u) return;
-            data[next].next = ~0u;
             obt->next = data[next].next;
+            data[next].next = ~0u;
+            if(tail == next) tail = (uint32_t)(obt - data.data());
             ind.push_back(next);
         }
         private:
@@ -154,6 +159,44 @@ namespace onart{
                 works.enqueue({work, completionHandler, strand});
                 if(toSignal) cond.notify_one();
             }
+            /// @brief [begin, end) 구간을 grain개씩 나눈 조각마다 f(조각 시작, 조각 끝)을 호출 스레드와 작업자들에서 나누어 실행하고, 모두 끝나면 리턴합니다.
+            /// 작업자마다 조각 하나를 post하지 않고, 최대 작업자 수만큼만 post하여 각자 남은 조각을 가져가게 합니다. 작업자가 다른 작업으로 바쁘면 호출 스레드가 남은 조각을 모두 처리하며 그 작업을 기다리지 않습니다.
+            /// 구간이 grain 이하이거나, 작업자가 없거나, 하드웨어 스레드가 하나뿐이면 호출 스레드에서 f(begin, end)를 한 번 호출합니다.
+            /// @param f 서로 다른 조각에 대해 동시에 호출될 수 있습니다.
+            template<class F>
+            inline void parallelFor(uint32_t begin, uint32_t end, uint32_t grain, F&& f) {
+                if (end <= begin) return;
+                if (grain == 0) grain = 1;
+                static const bool singleCore = std::thread::hardware_concurrency() == 1;
+                if (end - begin <= grain || workers.size() == 0 || singleCore) {
+                    f(begin, end);
+                    return;
+                }
+                struct Latch {
+                    std::atomic_uint32_t next{};
+                    std::atomic_uint32_t done{};
+                    std::mutex guard;
+                    std::condition_variable cond;
+                };
+                const uint32_t chunks = (end - begin - 1) / grain + 1;
+                // 늦게 시작한 작업은 가져갈 조각이 없으면 f에 접근하지 않고 끝나므로 latch만 공유하면 됩니다.
+                std::shared_ptr<Latch> latch = std::make_shared<Latch>();
+                auto run = [latch, chunks, begin, end, grain, fp = &f]() {
+                    for (uint32_t c = latch->next++; c < chunks; c = latch->next++) {
+                        const uint32_t cb = begin + c * grain;
+                        (*fp)(cb, end - cb > grain ? cb + grain : end);
+                        if (++latch->done == chunks) {
+                            std::unique_lock<std::mutex> _(latch->guard);
+                            latch->cond.notify_one();
+                        }
+                    }
+                };
+                const size_t helpers = std::min(workers.size(), (size_t)chunks - 1);
+                for (size_t i = 0; i < helpers; i++) { post([run]() { run(); return variant8(); }); }
+                run();
+                std::unique_lock<std::mutex> _(latch->guard);
+                latch->cond.wait(_, [&latch, chunks]() { return latch->done.load() == chunks; });
+            }
             /// @brief 완료된 동작에 대하여 등록한 후처리를 수행합니다.
             inline void handleCompleted(){
                 asGuard.lock();
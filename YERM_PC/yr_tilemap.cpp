@@ -0,0 +1,237 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "yr_tilemap.h"
+#include "yr_scene.h"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace onart {
+
+    TileMap::TileMap(uint32_t width, uint32_t height, uint32_t chunkSize, const vec2& tileSize)
+        :tileSize(tileSize), width(width), height(height), chunkSize(chunkSize < 1 ? 1 : (chunkSize > 128 ? 128 : chunkSize)) {
+        if (this->chunkSize != chunkSize) { LOGWITH("Chunk size", chunkSize, "clamped to", this->chunkSize); }
+        chunksX = (width + this->chunkSize - 1) / this->chunkSize;
+        chunksY = (height + this->chunkSize - 1) / this->chunkSize;
+        visibleChunks.resize((size_t)chunksX * chunksY, 1);
+    }
+
+    uint32_t TileMap::addLayer(const YRGraphics::pTexture& tileset, uint32_t columns, uint32_t rows, const vec4& color) {
+        Layer& layer = layers.emplace_back();
+        layer.texture = tileset;
+        layer.columns = columns ? columns : 1;
+        layer.rows = rows ? rows : 1;
+        layer.color = color;
+        layer.tiles.resize((size_t)width * height, EMPTY);
+        layer.animationOf.resize((size_t)layer.columns * layer.rows, UINT16_MAX);
+        layer.chunks.resize((size_t)chunksX * chunksY);
+        return (uint32_t)layers.size() - 1;
+    }
+
+    void TileMap::setTile(uint32_t layer, uint32_t x, uint32_t y, uint16_t tile) {
+        if (x >= width || y >= height) return;
+        uint16_t& t = layers[layer].tiles[(size_t)y * width + x];
+        if (t == tile) return;
+        t = tile;
+        layers[layer].chunks[(size_t)(y / chunkSize) * chunksX + x / chunkSize].dirty = true;
+    }
+
+    void TileMap::fill(uint32_t layer, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint16_t tile) {
+        if (x >= this->width || y >= this->height) return;
+        const uint32_t x1 = width > this->width - x ? this->width : x + width;
+        const uint32_t y1 = height > this->height - y ? this->height : y + height;
+        Layer& l = layers[layer];
+        for (uint32_t ty = y; ty < y1; ty++) {
+            std::fill(l.tiles.begin() + (size_t)ty * this->width + x, l.tiles.begin() + (size_t)ty * this->width + x1, tile);
+        }
+        if (x1 == x || y1 == y) return;
+        for (uint32_t cy = y / chunkSize; cy <= (y1 - 1) / chunkSize; cy++) {
+            for (uint32_t cx = x / chunkSize; cx <= (x1 - 1) / chunkSize; cx++) { l.chunks[(size_t)cy * chunksX + cx].dirty = true; }
+        }
+    }
+
+    uint16_t TileMap::getTile(uint32_t layer, uint32_t x, uint32_t y) const {
+        if (x >= width || y >= height) return EMPTY;
+        return layers[layer].tiles[(size_t)y * width + x];
+    }
+
+    void TileMap::addAnimation(uint32_t layer, uint16_t firstTile, uint16_t frameCount, float frameDuration) {
+        Layer& l = layers[layer];
+        const uint32_t column = firstTile % l.columns;
+        if (firstTile >= l.animationOf.size() || frameCount == 0 || column + frameCount > l.columns) {
+            LOGWITH("Animation frames", firstTile, '~', (uint32_t)firstTile + frameCount - 1, "must lie on a single tileset row");
+            return;
+        }
+        uint16_t& index = l.animationOf[firstTile];
+        if (index == UINT16_MAX) {
+            index = (uint16_t)l.animations.size();
+            l.animations.push_back({ firstTile, frameCount, frameDuration });
+        }
+        else {
+            l.animations[index] = { firstTile, frameCount, frameDuration };
+        }
+        for (Chunk& chunk : l.chunks) { chunk.dirty = true; }
+    }
+
+    void TileMap::rebuild(Layer& layer, uint32_t chunkIndex) {
+        Chunk& chunk = layer.chunks[chunkIndex];
+        chunk.dirty = false;
+        chunk.ranges.clear();
+        const uint32_t cx = chunkIndex % chunksX, cy = chunkIndex / chunksX;
+        const uint32_t x0 = cx * chunkSize, y0 = cy * chunkSize;
+        const uint32_t x1 = x0 + chunkSize < width ? x0 + chunkSize : width;
+        const uint32_t y1 = y0 + chunkSize < height ? y0 + chunkSize : height;
+        const uint32_t tileCount = layer.columns * layer.rows;
+
+        // 정적 타일을 0번, 애니메이션 i의 타일을 i + 1번 그룹으로 계수 정렬합니다.
+        const size_t groups = layer.animations.size() + 1;
+        std::vector<uint32_t> offsets(groups + 1, 0);
+        for (uint32_t y = y0; y < y1; y++) {
+            for (uint32_t x = x0; x < x1; x++) {
+                const uint16_t t = layer.tiles[(size_t)y * width + x];
+                if (t >= tileCount) continue;
+                offsets[layer.animationOf[t] == UINT16_MAX ? 1 : (size_t)layer.animationOf[t] + 2]++;
+            }
+        }
+        for (size_t g = 1; g <= groups; g++) { offsets[g] += offsets[g - 1]; }
+        const uint32_t total = offsets[groups];
+        if (total == 0) {
+            chunk.mesh = {};
+            return;
+        }
+        orderScratch.resize(total);
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (uint32_t y = y0; y < y1; y++) {
+            for (uint32_t x = x0; x < x1; x++) {
+                const uint16_t t = layer.tiles[(size_t)y * width + x];
+                if (t >= tileCount) continue;
+                const size_t g = layer.animationOf[t] == UINT16_MAX ? 0 : (size_t)layer.animationOf[t] + 1;
+                orderScratch[cursor[g]++] = ((uint32_t)t << 16) | ((y - y0) << 8) | (x - x0);
+            }
+        }
+
+        vertexScratch.resize((size_t)total * 16);
+        indexScratch.resize((size_t)total * 6);
+        const float iw = 1.0f / layer.columns, ih = 1.0f / layer.rows;
+        for (uint32_t i = 0; i < total; i++) {
+            const uint32_t packed = orderScratch[i];
+            const float lx = (float)(packed & 0xff), ly = (float)((packed >> 8) & 0xff);
+            const uint32_t t = packed >> 16;
+            const float u0 = (t % layer.columns) * iw, v0 = (t / layer.columns) * ih;
+            const float quad[16] = {
+                lx, ly, u0, v0,
+                lx, ly + 1, u0, v0 + ih,
+                lx + 1, ly, u0 + iw, v0,
+                lx + 1, ly + 1, u0 + iw, v0 + ih
+            };
+            std::memcpy(&vertexScratch[(size_t)i * 16], quad, sizeof(quad));
+            const uint16_t base = (uint16_t)(i * 4);
+            const uint16_t inds[6] = { base, (uint16_t)(base + 1), (uint16_t)(base + 2), (uint16_t)(base + 2), (uint16_t)(base + 1), (uint16_t)(base + 3) };
+            std::memcpy(&indexScratch[(size_t)i * 6], inds, sizeof(inds));
+        }
+        for (size_t g = 0; g < groups; g++) {
+            if (offsets[g + 1] == offsets[g]) continue;
+            chunk.ranges.push_back({ g == 0 ? UINT32_MAX : (uint32_t)(g - 1), offsets[g] * 6, (offsets[g + 1] - offsets[g]) * 6 });
+        }
+
+        MeshCreationOptions opts{};
+        opts.vertices = vertexScratch.data();
+        opts.vertexCount = (size_t)total * 4;
+        opts.singleVertexSize = sizeof(_2dvertex_t);
+        opts.indices = indexScratch.data();
+        opts.indexCount = (size_t)total * 6;
+        opts.singleIndexSize = 2;
+        chunk.mesh = YRGraphics::createMesh(INT32_MIN, opts);
+    }
+
+    void TileMap::cull() {
+        if (!culling) {
+            std::fill(visibleChunks.begin(), visibleChunks.end(), 1);
+            return;
+        }
+        const float chunkW = chunkSize * tileSize[0], chunkH = chunkSize * tileSize[1];
+        for (uint32_t cy = 0; cy < chunksY; cy++) {
+            for (uint32_t cx = 0; cx < chunksX; cx++) {
+                const float x1 = (cx + 1) * chunkSize < width ? (cx + 1) * chunkW : width * tileSize[0];
+                const float y1 = (cy + 1) * chunkSize < height ? (cy + 1) * chunkH : height * tileSize[1];
+                const AABB box = AABB(vec3(cx * chunkW, cy * chunkH, 0), vec3(x1, y1, 0)).transformed(transform);
+                visibleChunks[(size_t)cy * chunksX + cx] = intersects(frustum, box);
+            }
+        }
+    }
+
+    template<class RP>
+    void TileMap::drawTo(RP* target) {
+        cull();
+        lastDrawCount = 0;
+        const YRGraphics::pPipeline pipeline = get2DDefaultPipeline();
+        bool pipelineBound = false;
+        const float chunkW = chunkSize * tileSize[0], chunkH = chunkSize * tileSize[1];
+        _2dpush_t push;
+        for (Layer& layer : layers) {
+            if (!layer.visible || !layer.texture) continue;
+            bool layerBound = false;
+            push.color = layer.color;
+            for (uint32_t ci = 0; ci < layer.chunks.size(); ci++) {
+                if (!visibleChunks[ci]) continue;
+                Chunk& chunk = layer.chunks[ci];
+                if (chunk.dirty) { rebuild(layer, ci); }
+                if (!chunk.mesh) continue;
+                if (!pipelineBound) {
+                    target->usePipeline(pipeline.get(), 0);
+                    pipelineBound = true;
+                }
+                if (!layerBound) {
+                    target->bind(_2D_TEXTURE_BIND_INDEX, layer.texture);
+                    layerBound = true;
+                }
+                const float ox = (ci % chunksX) * chunkW, oy = (ci / chunksX) * chunkH;
+                push.model = transform * mat4(
+                    tileSize[0], 0, 0, ox,
+                    0, tileSize[1], 0, oy,
+                    0, 0, 1, 0,
+                    0, 0, 0, 1
+                );
+                push.texrect = vec4(1, 1, 0, 0);
+                target->push(&push, 0, sizeof(push));
+                for (const Range& range : chunk.ranges) {
+                    if (range.animation != UINT32_MAX) {
+                        const Animation& anim = layer.animations[range.animation];
+                        const uint32_t frame = anim.frameDuration > 0 && time > 0 ? (uint32_t)(time / anim.frameDuration) % anim.frameCount : 0;
+                        push.texrect = vec4(1, 1, (float)frame / layer.columns, 0);
+                        target->push(&push.texrect, offsetof(_2dpush_t, texrect), offsetof(_2dpush_t, texrect) + sizeof(vec4));
+                    }
+                    target->invoke(chunk.mesh, range.start, range.count);
+                    lastDrawCount++;
+                }
+            }
+        }
+    }
+
+    void TileMap::draw(YRGraphics::RenderPass* target) { drawTo(target); }
+#ifdef YR_USE_VULKAN
+    void TileMap::draw(YRGraphics::RenderPass2Screen* target) { drawTo(target); }
+#endif
+
+    TileMap* addTileMap(Scene& scene, uint32_t width, uint32_t height, uint32_t chunkSize, const vec2& tileSize, VisualElementHandle* handle) {
+        VisualElementHandle h = scene.insert();
+        VisualElement* elem = scene.get(h);
+        TileMap* map = new TileMap(width, height, chunkSize, tileSize);
+        elem->fr.reset(map);
+        elem->pipeline = get2DDefaultPipeline();
+        if (handle) { *handle = h; }
+        return map;
+    }
+}
@@ -0,0 +1,124 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef __YR_TILEMAP_H__
+#define __YR_TILEMAP_H__
+
+#include "yr_2d.h"
+#include "yr_geometry.hpp"
+
+namespace onart {
+
+    /// @brief 격자 형태의 2D 타일 맵입니다. 맵을 chunkSize x chunkSize 타일 단위 청크로 나누어 레이어별 청크마다 정적 메시 1개를 만들고, 타일이 바뀐 청크만 다시 만듭니다.
+    /// 보이는 청크마다 get2DDefaultPipeline()으로 드로우 1회(애니메이션 타일이 있으면 그 애니메이션마다 1회 추가)로 그립니다.
+    /// 맵 좌표계는 타일 (x, y)가 [x, x + 1] x [y, y + 1]을 차지하고 y가 타일셋 이미지의 행 방향(아래)으로 증가합니다. 여기에 타일 크기와 setTransform()의 변환이 적용됩니다.
+    class TileMap: public FreeRenderer {
+        public:
+            /// @brief 빈 타일입니다.
+            static constexpr uint16_t EMPTY = 0xffff;
+            /// @param width 맵 가로 타일 수
+            /// @param height 맵 세로 타일 수
+            /// @param chunkSize 청크 한 변의 타일 수. 16비트 인덱스를 쓰기 위해 128 이하로 제한됩니다.
+            /// @param tileSize 타일 1개의 크기
+            TileMap(uint32_t width, uint32_t height, uint32_t chunkSize = 32, const vec2& tileSize = vec2(1));
+            /// @brief 레이어를 추가하고 그 번호를 리턴합니다. 레이어는 추가한 순서대로 그려집니다.
+            /// @param tileset 타일셋 텍스처. 타일 번호는 왼쪽 위부터 행 우선으로 0, 1, 2, ...입니다.
+            /// @param columns 타일셋의 가로 타일 수
+            /// @param rows 타일셋의 세로 타일 수
+            /// @param color 텍스처에 곱할 색
+            uint32_t addLayer(const YRGraphics::pTexture& tileset, uint32_t columns, uint32_t rows, const vec4& color = vec4(1));
+            /// @brief 타일 하나를 바꿉니다. 범위 밖이면 무시합니다.
+            void setTile(uint32_t layer, uint32_t x, uint32_t y, uint16_t tile);
+            /// @brief 직사각형 영역을 같은 타일로 채웁니다. 맵을 벗어나는 부분은 무시합니다.
+            void fill(uint32_t layer, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint16_t tile);
+            /// @brief 타일 번호를 리턴합니다. 범위 밖이면 EMPTY를 리턴합니다.
+            uint16_t getTile(uint32_t layer, uint32_t x, uint32_t y) const;
+            /// @brief 애니메이션 타일을 등록합니다. firstTile을 놓은 칸은 시간에 따라 firstTile, firstTile + 1, ..., firstTile + frameCount - 1을 번갈아 보여 줍니다.
+            /// 프레임은 타일셋의 같은 행에 연속으로 있어야 합니다. 프레임 전환은 청크별 푸시 상수의 텍스처 좌표 오프셋만 바꾸므로 메시를 다시 만들지 않습니다.
+            /// @param frameDuration 프레임 1개의 길이(초)
+            void addAnimation(uint32_t layer, uint16_t firstTile, uint16_t frameCount, float frameDuration);
+            /// @brief 애니메이션 시각(초)을 설정합니다.
+            inline void setTime(float seconds) { time = seconds; }
+            /// @brief 레이어를 그릴지 설정합니다.
+            inline void setLayerVisible(uint32_t layer, bool visible) { layers[layer].visible = visible; }
+            /// @brief 레이어 색을 설정합니다.
+            inline void setLayerColor(uint32_t layer, const vec4& color) { layers[layer].color = color; }
+            /// @brief 맵 전체에 적용할 변환을 설정합니다.
+            inline void setTransform(const mat4& transform) { this->transform = transform; }
+            /// @brief 청크를 주어진 뷰-투사 행렬의 절두체로 컬링합니다. 카메라가 움직일 때마다 호출하세요.
+            /// @param zeroToOneDepth 정규 장치 좌표의 z 범위가 [0, 1]이면 참, [-1, 1]이면 거짓
+            inline void setViewProjection(const mat4& viewProjection, bool zeroToOneDepth = true) { frustum = Frustum::fromMatrix(viewProjection, zeroToOneDepth); culling = true; }
+            /// @brief 컬링을 끕니다.
+            inline void disableCulling() { culling = false; }
+            /// @brief 직전에 그릴 때 사용한 드로우 호출 수를 리턴합니다.
+            inline size_t drawCount() const { return lastDrawCount; }
+            inline uint32_t getWidth() const { return width; }
+            inline uint32_t getHeight() const { return height; }
+            inline size_t layerCount() const { return layers.size(); }
+            void draw(YRGraphics::RenderPass*) override;
+#ifdef YR_USE_VULKAN
+            void draw(YRGraphics::RenderPass2Screen*) override;
+#endif
+        private:
+            template<class RP>
+            void drawTo(RP* target);
+            struct Animation {
+                uint16_t firstTile;
+                uint16_t frameCount;
+                float frameDuration;
+            };
+            /// @brief 청크 메시 안에서 같은 텍스처 좌표 오프셋으로 그리는 인덱스 구간입니다.
+            struct Range {
+                uint32_t animation; // UINT32_MAX면 정적 타일
+                uint32_t start;
+                uint32_t count;
+            };
+            struct Chunk {
+                YRGraphics::pMesh mesh;
+                std::vector<Range> ranges;
+                bool dirty = true;
+            };
+            struct Layer {
+                YRGraphics::pTexture texture;
+                uint32_t columns, rows;
+                vec4 color;
+                std::vector<uint16_t> tiles;
+                std::vector<Animation> animations;
+                std::vector<uint16_t> animationOf; // 타일 번호 -> animations 내 번호. 애니메이션 첫 타일이 아니면 UINT16_MAX
+                std::vector<Chunk> chunks;
+                bool visible = true;
+            };
+            /// @brief 청크의 메시와 구간을 다시 만듭니다. 정적 타일을 앞에, 애니메이션 타일을 애니메이션별로 모아 뒤에 둡니다.
+            void rebuild(Layer& layer, uint32_t chunkIndex);
+            /// @brief 청크 영역이 절두체와 겹치는지 레이어 공통으로 판정합니다.
+            void cull();
+            std::vector<Layer> layers;
+            std::vector<uint8_t> visibleChunks;
+            std::vector<float> vertexScratch; // _2dvertex_t와 같은 배치
+            std::vector<uint16_t> indexScratch;
+            std::vector<uint32_t> orderScratch;
+            mat4 transform;
+            Frustum frustum;
+            vec2 tileSize;
+            float time = 0;
+            uint32_t width, height, chunkSize, chunksX, chunksY;
+            size_t lastDrawCount = 0;
+            bool culling = false;
+    };
+
+    /// @brief 장면에 TileMap을 그리는 요소를 추가하고 그 맵을 리턴합니다. 리턴된 포인터는 해당 요소가 제거될 때까지 유효합니다.
+    /// @param handle nullptr가 아니면 추가된 요소의 핸들을 여기에 저장합니다.
+    TileMap* addTileMap(class Scene& scene, uint32_t width, uint32_t height, uint32_t chunkSize = 32, const vec2& tileSize = vec2(1), VisualElementHandle* handle = nullptr);
+}
+
+#endif
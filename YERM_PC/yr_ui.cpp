@@ -0,0 +1,257 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "yr_ui.h"
+#include "yr_scene.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+namespace onart {
+
+    uint32_t UILayer::addElement(Element&& element) {
+        uint32_t id;
+        if (!freeIds.empty()) {
+            id = freeIds.back();
+            freeIds.pop_back();
+            elements[id] = std::move(element);
+            alive[id] = 1;
+        }
+        else {
+            id = (uint32_t)elements.size();
+            elements.push_back(std::move(element));
+            alive.push_back(1);
+        }
+        order.push_back(id);
+        dirty = true;
+        return id;
+    }
+
+    uint32_t UILayer::addImage(const YRGraphics::pTexture& texture, const vec2& position, const vec2& size, const vec4& texrect, const vec4& color, uint32_t clip) {
+        return addElement({ texture, texrect, color, vec4(), position, size, 1, clip, Kind::IMAGE, true });
+    }
+
+    uint32_t UILayer::addNineSlice(const YRGraphics::pTexture& texture, const vec2& position, const vec2& size, const vec4& border, float borderScale, const vec4& texrect, const vec4& color, uint32_t clip) {
+        return addElement({ texture, texrect, color, border, position, size, borderScale, clip, Kind::NINE_SLICE, true });
+    }
+
+    uint32_t UILayer::addRect(const vec2& position, const vec2& size, const vec4& color, uint32_t clip) {
+        return addElement({ get2DWhiteTexture(), vec4(1, 1, 0, 0), color, vec4(), position, size, 1, clip, Kind::RECT, true });
+    }
+
+    uint32_t UILayer::addClip(const vec2& position, const vec2& size, uint32_t parent) {
+        clips.push_back({ position, position + size, parent, true });
+        dirty = true;
+        return (uint32_t)clips.size() - 1;
+    }
+
+    void UILayer::setClip(uint32_t clip, const vec2& position, const vec2& size) {
+        clips[clip].min = position;
+        clips[clip].max = position + size;
+        dirty = true;
+    }
+
+    void UILayer::removeClip(uint32_t clip) {
+        clips[clip].alive = false;
+        dirty = true;
+    }
+
+    void UILayer::setPosition(uint32_t element, const vec2& position) { elements[element].position = position; dirty = true; }
+    void UILayer::setSize(uint32_t element, const vec2& size) { elements[element].size = size; dirty = true; }
+    void UILayer::setColor(uint32_t element, const vec4& color) { elements[element].color = color; dirty = true; }
+    void UILayer::setVisible(uint32_t element, bool visible) { elements[element].visible = visible; dirty = true; }
+    void UILayer::setElementClip(uint32_t element, uint32_t clip) { elements[element].clip = clip; dirty = true; }
+
+    void UILayer::setTexture(uint32_t element, const YRGraphics::pTexture& texture, const vec4& texrect) {
+        Element& e = elements[element];
+        if (e.kind == Kind::RECT) return;
+        e.texture = texture;
+        e.texrect = texrect;
+        dirty = true;
+    }
+
+    void UILayer::remove(uint32_t element) {
+        if (!alive[element]) return;
+        alive[element] = 0;
+        elements[element].texture.reset();
+        order.erase(std::find(order.begin(), order.end(), element));
+        freeIds.push_back(element);
+        dirty = true;
+    }
+
+    void UILayer::clear() {
+        elements.clear();
+        alive.clear();
+        freeIds.clear();
+        order.clear();
+        clips.clear();
+        dirty = true;
+    }
+
+    const UILayer::Clip* UILayer::resolveClip(uint32_t clip) {
+        while (clip != NO_CLIP && !clips[clip].alive) { clip = clips[clip].parent; }
+        if (clip == NO_CLIP) return nullptr;
+        if (clipResolved[clip]) return &resolvedClips[clip];
+        Clip c = clips[clip];
+        if (const Clip* parent = resolveClip(c.parent)) {
+            c.min = vec2(std::max(c.min[0], parent->min[0]), std::max(c.min[1], parent->min[1]));
+            c.max = vec2(std::min(c.max[0], parent->max[0]), std::min(c.max[1], parent->max[1]));
+        }
+        resolvedClips[clip] = c;
+        clipResolved[clip] = 1;
+        return &resolvedClips[clip];
+    }
+
+    void UILayer::emitQuad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, const Clip* clip) {
+        if (x1 <= x0 || y1 <= y0) return;
+        if (clip) {
+            // 축 정렬 사각형이므로 잘린 비율만큼 텍스처 좌표도 선형으로 옮기면 시저와 같은 결과가 됩니다.
+            const float cx0 = std::max(x0, clip->min[0]), cy0 = std::max(y0, clip->min[1]);
+            const float cx1 = std::min(x1, clip->max[0]), cy1 = std::min(y1, clip->max[1]);
+            if (cx1 <= cx0 || cy1 <= cy0) return;
+            const float du = (u1 - u0) / (x1 - x0), dv = (v1 - v0) / (y1 - y0);
+            const float nu0 = u0 + (cx0 - x0) * du, nu1 = u0 + (cx1 - x0) * du;
+            const float nv0 = v0 + (cy0 - y0) * dv, nv1 = v0 + (cy1 - y0) * dv;
+            x0 = cx0; y0 = cy0; x1 = cx1; y1 = cy1;
+            u0 = nu0; u1 = nu1; v0 = nv0; v1 = nv1;
+        }
+        const uint32_t base = (uint32_t)(vertices.size() / 4);
+        const float quad[16] = {
+            x0, y0, u0, v0,
+            x0, y1, u0, v1,
+            x1, y0, u1, v0,
+            x1, y1, u1, v1
+        };
+        vertices.insert(vertices.end(), quad, quad + 16);
+        const uint32_t inds[6] = { base, base + 1, base + 2, base + 2, base + 1, base + 3 };
+        indices.insert(indices.end(), inds, inds + 6);
+    }
+
+    void UILayer::rebuild() {
+        dirty = false;
+        vertices.clear();
+        indices.clear();
+        runs.clear();
+        resolvedClips.resize(clips.size());
+        clipResolved.assign(clips.size(), 0);
+        for (uint32_t id : order) {
+            const Element& e = elements[id];
+            if (!e.visible || !e.texture) continue;
+            const Clip* clip = resolveClip(e.clip);
+            const uint32_t before = (uint32_t)indices.size();
+            const float x0 = e.position[0], y0 = e.position[1], x1 = x0 + e.size[0], y1 = y0 + e.size[1];
+            const float u0 = e.texrect[2], v0 = e.texrect[3], u1 = u0 + e.texrect[0], v1 = v0 + e.texrect[1];
+            if (e.kind != Kind::NINE_SLICE) {
+                emitQuad(x0, y0, x1, y1, u0, v0, u1, v1, clip);
+            }
+            else {
+                const float tw = e.texture->width, th = e.texture->height;
+                float l = e.border[0] * e.borderScale, t = e.border[1] * e.borderScale, r = e.border[2] * e.borderScale, b = e.border[3] * e.borderScale;
+                if (l + r > e.size[0] && l + r > 0) { const float s = e.size[0] / (l + r); l *= s; r *= s; }
+                if (t + b > e.size[1] && t + b > 0) { const float s = e.size[1] / (t + b); t *= s; b *= s; }
+                const float xs[4] = { x0, x0 + l, x1 - r, x1 };
+                const float ys[4] = { y0, y0 + t, y1 - b, y1 };
+                const float us[4] = { u0, u0 + e.border[0] / tw, u1 - e.border[2] / tw, u1 };
+                const float vs[4] = { v0, v0 + e.border[1] / th, v1 - e.border[3] / th, v1 };
+                for (int j = 0; j < 3; j++) {
+                    for (int i = 0; i < 3; i++) { emitQuad(xs[i], ys[j], xs[i + 1], ys[j + 1], us[i], vs[j], us[i + 1], vs[j + 1], clip); }
+                }
+            }
+            const uint32_t added = (uint32_t)indices.size() - before;
+            if (added == 0) continue;
+            if (runs.empty() || runs.back().texture != e.texture || runs.back().color != e.color) {
+                runs.push_back({ e.texture, e.color, before, added });
+            }
+            else {
+                runs.back().count += added;
+            }
+        }
+#ifndef YR_HAS_STREAM_GEOMETRY
+        if (indices.empty()) return;
+
+        const uint32_t vertexCount = (uint32_t)(vertices.size() / 4), indexCount = (uint32_t)indices.size();
+        if (!mesh || vertexCount > vertexCapacity || indexCount > indexCapacity) {
+            if (vertexCapacity == 0) { vertexCapacity = 256; indexCapacity = 384; }
+            while (vertexCapacity < vertexCount) { vertexCapacity *= 2; }
+            while (indexCapacity < indexCount) { indexCapacity *= 2; }
+            std::unique_ptr<float[]> initialVertices(new float[(size_t)vertexCapacity * 4]());
+            std::unique_ptr<uint32_t[]> initialIndices(new uint32_t[indexCapacity]());
+            MeshCreationOptions opts{};
+            opts.vertices = initialVertices.get();
+            opts.vertexCount = vertexCapacity;
+            opts.singleVertexSize = sizeof(_2dvertex_t);
+            opts.indices = initialIndices.get();
+            opts.indexCount = indexCapacity;
+            opts.singleIndexSize = 4;
+            opts.fixed = false;
+            mesh = YRGraphics::createMesh(INT32_MIN, opts);
+        }
+        if (mesh) {
+            mesh->update(vertices.data(), 0, (uint32_t)(vertices.size() * sizeof(float)));
+            mesh->updateIndex(indices.data(), 0, (uint32_t)(indices.size() * sizeof(uint32_t)));
+        }
+#endif
+    }
+
+    template<class RP>
+    void UILayer::drawTo(RP* target) {
+        if (dirty) { rebuild(); }
+        if (runs.empty()) return;
+#ifdef YR_HAS_STREAM_GEOMETRY
+        // 스트리밍 버퍼는 프레임마다 비워지므로 요소가 그대로여도 정점 스트림을 매번 복사합니다. 메시 갱신(Vulkan에서는 스테이징 복사와 제출)은 하지 않습니다.
+        YRGraphics::StreamGeometry source = YRGraphics::allocateStreamGeometry((uint32_t)(vertices.size() / 4), sizeof(_2dvertex_t), (uint32_t)indices.size(), 4);
+        if (!source) return;
+        std::memcpy(source.vertices, vertices.data(), vertices.size() * sizeof(float));
+        std::memcpy(source.indices, indices.data(), indices.size() * sizeof(uint32_t));
+#else
+        if (!mesh) return;
+        const YRGraphics::pMesh& source = mesh;
+#endif
+        target->usePipeline(get2DDefaultPipeline().get(), 0);
+        _2dpush_t push;
+        push.model = transform;
+        push.texrect = vec4(1, 1, 0, 0);
+        push.color = runs[0].color;
+        target->push(&push, 0, sizeof(push));
+        const YRGraphics::Texture* prevTexture = nullptr;
+        for (size_t i = 0; i < runs.size(); i++) {
+            const Run& run = runs[i];
+            if (run.color != push.color) {
+                push.color = run.color;
+                target->push(&push.color, offsetof(_2dpush_t, color), offsetof(_2dpush_t, color) + sizeof(vec4));
+            }
+            if (run.texture.get() != prevTexture) {
+                target->bind(_2D_TEXTURE_BIND_INDEX, run.texture);
+                prevTexture = run.texture.get();
+            }
+            target->invoke(source, run.start, run.count);
+        }
+    }
+
+    void UILayer::draw(YRGraphics::RenderPass* target) { drawTo(target); }
+#ifdef YR_USE_VULKAN
+    void UILayer::draw(YRGraphics::RenderPass2Screen* target) { drawTo(target); }
+#endif
+
+    UILayer* addUILayer(Scene& scene, VisualElementHandle* handle) {
+        VisualElementHandle h = scene.insert();
+        VisualElement* elem = scene.get(h);
+        UILayer* layer = new UILayer;
+        elem->fr.reset(layer);
+        elem->pipeline = get2DDefaultPipeline();
+        elem->transparent = true;
+        if (handle) { *handle = h; }
+        return layer;
+    }
+}
@@ -0,0 +1,127 @@
+// Copyright 2022 onart@github. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef __YR_UI_H__
+#define __YR_UI_H__
+
+#include "yr_2d.h"
+
+namespace onart {
+
+    /// @brief 이미지, 나인 슬라이스 패널, 단색 사각형으로 이루어진 UI를 보관하고 그리는 유지 모드(retained mode) 레이어입니다.
+    /// 요소가 바뀐 프레임에만 모든 요소를 정점 스트림 1개로 다시 만들며, get2DDefaultPipeline()으로 텍스처나 색이 바뀌는 곳에서만 드로우를 나눕니다.
+    /// 정점 스트림은 Vulkan, OpenGL에서는 매 프레임 스트리밍 버퍼(YRGraphics::allocateStreamGeometry)에 복사하고, 그 외에서는 바뀐 프레임에만 메시에 올립니다.
+    /// 클립 영역은 시저 대신 CPU에서 사각형과 텍스처 좌표를 잘라 적용하므로 드로우를 나누지 않습니다.
+    /// 레이어 좌표계는 x가 오른쪽, y가 텍스처 이미지의 행 방향(아래)으로 증가하며, 요소는 추가한 순서대로 그려집니다. 여기에 setTransform()의 변환이 적용됩니다.
+    class UILayer: public FreeRenderer {
+        public:
+            /// @brief 클립 영역이 없음을 나타냅니다.
+            static constexpr uint32_t NO_CLIP = UINT32_MAX;
+            UILayer() = default;
+            /// @brief 이미지를 추가하고 그 번호를 리턴합니다.
+            /// @param position 왼쪽 위 좌표
+            /// @param size 크기
+            /// @param texrect 텍스처 좌표 변환 (xy: 배율, zw: 오프셋)
+            /// @param color 텍스처에 곱할 색
+            /// @param clip addClip()으로 만든 클립 영역. 영역 밖 부분은 그리지 않습니다.
+            uint32_t addImage(const YRGraphics::pTexture& texture, const vec2& position, const vec2& size, const vec4& texrect = vec4(1, 1, 0, 0), const vec4& color = vec4(1), uint32_t clip = NO_CLIP);
+            /// @brief 나인 슬라이스 패널을 추가하고 그 번호를 리턴합니다. 텍스처 영역의 네 모서리는 늘리지 않고, 변은 한 방향으로만, 가운데는 양방향으로 늘립니다.
+            /// @param border 늘리지 않을 가장자리 두께(텍스처 픽셀). 순서대로 왼쪽, 위, 오른쪽, 아래입니다.
+            /// @param borderScale 화면에 그릴 가장자리 두께의 배율. 패널이 가장자리보다 작으면 가장자리를 비율에 맞게 줄입니다.
+            /// @param texrect 텍스처에서 패널로 쓸 영역 (xy: 배율, zw: 오프셋)
+            uint32_t addNineSlice(const YRGraphics::pTexture& texture, const vec2& position, const vec2& size, const vec4& border, float borderScale = 1, const vec4& texrect = vec4(1, 1, 0, 0), const vec4& color = vec4(1), uint32_t clip = NO_CLIP);
+            /// @brief 단색 사각형을 추가하고 그 번호를 리턴합니다.
+            uint32_t addRect(const vec2& position, const vec2& size, const vec4& color, uint32_t clip = NO_CLIP);
+            /// @brief 클립 영역을 추가하고 그 번호를 리턴합니다.
+            /// @param parent 다른 클립 영역이 주어지면 그 영역과의 교집합이 됩니다.
+            uint32_t addClip(const vec2& position, const vec2& size, uint32_t parent = NO_CLIP);
+            /// @brief 클립 영역을 옮기거나 크기를 바꿉니다.
+            void setClip(uint32_t clip, const vec2& position, const vec2& size);
+            /// @brief 클립 영역을 제거합니다. 이 영역을 쓰던 요소와 하위 영역은 이후 이 영역의 부모 영역을 따릅니다.
+            void removeClip(uint32_t clip);
+            void setPosition(uint32_t element, const vec2& position);
+            void setSize(uint32_t element, const vec2& size);
+            void setColor(uint32_t element, const vec4& color);
+            void setTexture(uint32_t element, const YRGraphics::pTexture& texture, const vec4& texrect = vec4(1, 1, 0, 0));
+            void setVisible(uint32_t element, bool visible);
+            void setElementClip(uint32_t element, uint32_t clip);
+            /// @brief 요소를 제거합니다. 번호는 이후 추가에서 재사용됩니다.
+            void remove(uint32_t element);
+            /// @brief 모든 요소와 클립 영역을 제거합니다.
+            void clear();
+            /// @brief 레이어 전체에 적용할 변환을 설정합니다. 예를 들어 화면 픽셀 좌표를 카메라 공간으로 옮기는 행렬을 줍니다.
+            inline void setTransform(const mat4& transform) { this->transform = transform; }
+            /// @brief 직전에 그릴 때 사용한 드로우 호출 수를 리턴합니다.
+            inline size_t drawCount() const { return runs.size(); }
+            /// @brief 살아 있는 요소 수를 리턴합니다.
+            inline size_t size() const { return order.size(); }
+            void draw(YRGraphics::RenderPass*) override;
+#ifdef YR_USE_VULKAN
+            void draw(YRGraphics::RenderPass2Screen*) override;
+#endif
+        private:
+            template<class RP>
+            void drawTo(RP* target);
+            enum class Kind: uint8_t { IMAGE, NINE_SLICE, RECT };
+            struct Element {
+                YRGraphics::pTexture texture;
+                vec4 texrect;
+                vec4 color;
+                vec4 border;
+                vec2 position, size;
+                float borderScale;
+                uint32_t clip;
+                Kind kind;
+                bool visible;
+            };
+            struct Clip {
+                vec2 min, max;
+                uint32_t parent;
+                bool alive;
+            };
+            /// @brief 같은 텍스처, 색으로 그리는 인덱스 구간입니다.
+            struct Run {
+                YRGraphics::pTexture texture;
+                vec4 color;
+                uint32_t start;
+                uint32_t count;
+            };
+            uint32_t addElement(Element&& element);
+            /// @brief 요소를 정점 스트림으로 다시 만듭니다. 스트리밍 버퍼가 없는 백엔드에서는 메시에도 올립니다.
+            void rebuild();
+            /// @brief 사각형 하나를 클립 영역으로 잘라 정점 스트림에 추가합니다.
+            void emitQuad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, const Clip* clip);
+            /// @brief 부모 영역과의 교집합을 구한 실제 클립 영역을 리턴합니다. 영역이 없으면 nullptr를 리턴합니다.
+            const Clip* resolveClip(uint32_t clip);
+            std::vector<Element> elements;
+            std::vector<uint8_t> alive;
+            std::vector<uint32_t> freeIds;
+            std::vector<uint32_t> order; // 그리는 순서대로의 요소 번호
+            std::vector<Clip> clips;
+            std::vector<Clip> resolvedClips; // rebuild()에서 쓰는 clips와 같은 길이의 교집합 결과
+            std::vector<uint8_t> clipResolved;
+            std::vector<float> vertices; // _2dvertex_t와 같은 배치
+            std::vector<uint32_t> indices;
+            std::vector<Run> runs;
+            YRGraphics::pMesh mesh; // 스트리밍 버퍼가 없는 백엔드에서만 사용
+            mat4 transform;
+            uint32_t vertexCapacity = 0, indexCapacity = 0;
+            bool dirty = true;
+    };
+
+    /// @brief 장면에 UILayer를 그리는 요소를 추가하고 그 레이어를 리턴합니다. 리턴된 포인터는 해당 요소가 제거될 때까지 유효합니다.
+    /// @param handle nullptr가 아니면 추가된 요소의 핸들을 여기에 저장합니다.
+    UILayer* addUILayer(class Scene& scene, VisualElementHandle* handle = nullptr);
+}
+
+#endif
@@ -1,51 +1,234 @@
 #include "yr_visual.h"
 #include "yr_basic.hpp"
 #include "yr_sys.h"
+#include "logger.hpp"
 #include <algorithm>
+#include <unordered_map>
+#include <cmath>
 
 namespace onart {
 	
 	constexpr static int PER_OBJ_UB_DESCRIPTOR_BIND_INDEX = 1;
 	constexpr static int PER_OBJ_TEXTURE_DESCRIPTOR_BIND_INDEX = 2;
 
-	void Scene::insert(const std::shared_ptr<VisualElement>& e) {
-		ve.push_back(e);
-		e->sceneRefs++;
+	VisualElementHandle Scene::insert() {
+		uint32_t slot;
+		if (freeSlots.empty()) {
+			slot = (uint32_t)slots.size();
+			slots.emplace_back();
+		}
+		else {
+			slot = freeSlots.back();
+			freeSlots.pop_back();
+		}
+		if (nextSequence == UINT32_MAX) {
+			// 삽입 번호가 다 찼으면 현재 순서대로 번호를 다시 매김
+			restoreInsertionOrder();
+			nextSequence = 0;
+			for (VisualElement& elem : elements) { elem.sequence = nextSequence++; }
+		}
+		slots[slot].dense = (uint32_t)elements.size();
+		VisualElement& elem = elements.emplace_back();
+		elem.slot = slot;
+		elem.sequence = nextSequence++;
+		return { slot, slots[slot].generation };
+	}
+
+	void Scene::remove(VisualElementHandle handle) {
+		if (!isValid(handle)) { return; }
+		ElementSlot& sl = slots[handle.index];
+		const uint32_t dense = sl.dense;
+		// 맨 뒤 요소를 빈 자리로 당겨옵니다. 정렬하지 않는 장면(2D 등)의 삽입 순서는 다음 그리기 전에 한 번에 되돌립니다.
+		const uint32_t last = (uint32_t)elements.size() - 1;
+		if (dense != last) {
+			elements[dense] = std::move(elements[last]);
+			slots[elements[dense].slot].dense = dense;
+			orderBroken = true;
+		}
+		elements.pop_back();
+		sl.dense = UINT32_MAX;
+		sl.generation++;
+		freeSlots.push_back(handle.index);
+	}
+
+	VisualElement* Scene::get(VisualElementHandle handle) {
+		if (!isValid(handle)) { return nullptr; }
+		return &elements[slots[handle.index].dense];
+	}
+
+	bool Scene::isValid(VisualElementHandle handle) const {
+		return handle.index < slots.size() && slots[handle.index].generation == handle.generation && slots[handle.index].dense != UINT32_MAX;
+	}
+
+	void Scene::relinkSlots() {
+		for (uint32_t i = 0; i < (uint32_t)elements.size(); i++) {
+			slots[elements[i].slot].dense = i;
+		}
+	}
+
+	void Scene::restoreInsertionOrder() {
+		if (!orderBroken) { return; }
+		orderBroken = false;
+		std::sort(elements.begin(), elements.end(), [](const VisualElement& a, const VisualElement& b) { return a.sequence < b.sequence; });
+		relinkSlots();
 	}
 
 	void Scene::clear() {
-		for (auto& elem : ve) {
-			if(elem) elem->sceneRefs--;
+		for (VisualElement& elem : elements) {
+			ElementSlot& sl = slots[elem.slot];
+			sl.dense = UINT32_MAX;
+			sl.generation++;
+			freeSlots.push_back(elem.slot);
 		}
-		ve.clear();
+		elements.clear();
+		nextSequence = 0;
+		orderBroken = false;
 	}
 
 	Scene::~Scene() {
 		clear();
 	}
 
+	void Scene::setSortView(const mat4& view) {
+		sortView = view;
+		depthSort = true;
+	}
+
+	/// @brief 부호 있는 float를 대소 관계가 유지되는 부호 없는 정수로 바꿉니다.
+	static uint32_t sortableFloat(float f) {
+		uint32_t u;
+		std::memcpy(&u, &f, sizeof(u));
+		return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+	}
+
+	/// @brief 상위 32비트를 키로 하는 안정 기수 정렬입니다. 모든 원소가 같은 자릿수 값을 가지는 단계는 건너뜁니다.
+	static void radixSortUpper32(std::vector<uint64_t>& items, std::vector<uint64_t>& scratch) {
+		if (items.size() < 2) { return; }
+		scratch.resize(items.size());
+		for (int shift = 32; shift < 64; shift += 8) {
+			size_t count[256]{};
+			for (uint64_t v : items) { count[(v >> shift) & 0xff]++; }
+			if (count[(items[0] >> shift) & 0xff] == items.size()) { continue; }
+			size_t sum = 0;
+			for (size_t& c : count) {
+				size_t t = c;
+				c = sum;
+				sum += t;
+			}
+			for (uint64_t v : items) { scratch[count[(v >> shift) & 0xff]++] = v; }
+			items.swap(scratch);
+		}
+	}
+
+	void Scene::buildDrawOrder() {
+		const uint32_t count = (uint32_t)elements.size();
+		drawOrder.resize(count);
+		if (sorter) {
+			for (uint32_t i = 0; i < count; i++) { drawOrder[i] = i; }
+			return;
+		}
+		if (!depthSort) { restoreInsertionOrder(); }
+		// 뷰 공간 z (오른손 좌표계이므로 앞쪽이 음수)를 뒤집어 카메라로부터의 거리로 사용
+		sortDepth.resize(count);
+		if (depthSort) {
+			const float a = -sortView[8], b = -sortView[9], c = -sortView[10], d = -sortView[11];
+			uint32_t i = 0;
+#ifdef YR_USING_SIMD
+			alignas(16) float xs[4], ys[4], zs[4];
+			const float128 va = load(a), vb = load(b), vc = load(c), vd = load(d);
+			for (; i + 4 <= count; i += 4) {
+				for (uint32_t k = 0; k < 4; k++) {
+					const vec3& p = elements[i + k].sortPosition;
+					xs[k] = p.x; ys[k] = p.y; zs[k] = p.z;
+				}
+				float128 depth = add(add(mul(va, load(xs)), mul(vb, load(ys))), add(mul(vc, load(zs)), vd));
+				storeu(depth, sortDepth.data() + i);
+			}
+#endif
+			for (; i < count; i++) {
+				const vec3& p = elements[i].sortPosition;
+				sortDepth[i] = a * p.x + b * p.y + c * p.z + d;
+			}
+		}
+		uint32_t head = 0;
+		for (int transparent = 0; transparent < 2; transparent++) {
+			sortItems.clear();
+			for (uint32_t i = 0; i < count; i++) {
+				const VisualElement& elem = elements[i];
+				if (elem.transparent != (transparent == 1)) { continue; }
+				uint32_t key = 0;
+				if (depthSort) {
+					uint32_t depth = sortableFloat(sortDepth[i]);
+					if (transparent) {
+						key = ~depth;
+					}
+					else {
+						uintptr_t pp = (uintptr_t)elem.pipeline.get();
+						key = (depth & 0xffff0000u) | ((uint32_t)((pp >> 4) ^ (pp >> 20)) & 0xffffu);
+					}
+				}
+				sortItems.push_back(((uint64_t)key << 32) | i);
+			}
+			radixSortUpper32(sortItems, sortScratch);
+			for (uint64_t item : sortItems) { drawOrder[head++] = (uint32_t)item; }
+		}
+	}
+
+	void Scene::uploadPerObjectData() {
+		uint32_t count = 0;
+		uint32_t size = 0;
+		for (VisualElement& elem : elements) {
+			if (elem.poub.size() && !elem.fr) {
+				count++;
+				size = std::max(size, (uint32_t)elem.poub.size());
+			}
+		}
+		if (count == 0 || perObjectFallback) { return; }
+		if (!perObjectUB || count > perObjectCapacity || size > perObjectSize) {
+			perObjectCapacity = std::max(count, perObjectCapacity + perObjectCapacity / 2);
+			perObjectSize = std::max(size, perObjectSize);
+			UniformBufferCreationOptions opts;
+			opts.size = perObjectSize;
+			opts.count = std::max(perObjectCapacity, 2u);
+			perObjectUB = YRGraphics::createUniformBuffer(INT32_MIN, opts);
+			if (!perObjectUB) {
+				LOGWITH("Failed to create per-object uniform buffer. Falling back to per-element uniform buffers");
+				perObjectFallback = true;
+				return;
+			}
+		}
+		const uint32_t stride = perObjectUB->getStride();
+		perObjectStaging.resize((size_t)stride * count);
+		uint8_t* dst = perObjectStaging.data();
+		for (uint32_t idx : drawOrder) {
+			VisualElement& elem = elements[idx];
+			if (elem.poub.size() && !elem.fr) {
+				std::memcpy(dst, elem.poub.data(), elem.poub.size());
+				dst += stride;
+			}
+		}
+		perObjectUB->update(perObjectStaging.data(), 0, 0, (uint32_t)perObjectStaging.size());
+	}
+
 	template<class RP>
 	void Scene::draw(RP& target0) {
-		if (sorter) { sorter(ve); }
+		if (sorter) {
+			sorter(elements);
+			relinkSlots();
+		}
+		buildDrawOrder();
+		if constexpr (!YRGraphics::VULKAN_GRAPHICS) { uploadPerObjectData(); }
 		struct {
 			YRGraphics::Pipeline* pipeline = nullptr;
 		} state;
-		if (ve.size()) {
-			target0->usePipeline(ve[0]->pipeline.get(), 0);
+		uint32_t perObjectIndex = 0;
+		if (elements.size()) {
+			target0->usePipeline(elements[drawOrder[0]].pipeline.get(), 0);
 		}
 		target0->start();
 		target0->bind(0, perFrameUB.get());
-		size_t size = ve.size();
-		size_t invalidHead = 0;
-		for (size_t i = 0; i < size; i++) {
-			VisualElement* elem = ve[i].get();
-			if (!elem || elem->getSceneRefCount() == ve[i].use_count()) {
-				if (elem) { elem->sceneRefs--; }
-				ve[i].reset();
-				continue;
-			}
-			if (i != invalidHead) { ve[invalidHead] = std::move(ve[i]); }
-			invalidHead++;
+		for (uint32_t idx : drawOrder) {
+			VisualElement* elem = &elements[idx];
 			if (elem->fr) {
 				elem->fr->draw(target0.get());
 				std::memset(&state, 0, sizeof(state));
@@ -54,13 +237,22 @@ namespace onart {
 			if (state.pipeline != elem->pipeline.get()) { state.pipeline = elem->pipeline.get(); target0->usePipeline(state.pipeline, 0); }
 
 			if (elem->pushed.size()) { target0->push(elem->pushed.data(), 0, elem->pushed.size()); }
-			if (elem->ubIndex >= 0) {
-				if constexpr (YRGraphics::VULKAN_GRAPHICS) {
-					target0->bind(PER_OBJ_UB_DESCRIPTOR_BIND_INDEX, elem->ub.get(), elem->ubIndex);
-				}
-				else {
-					elem->ub->update(elem->poub.data(), 0, 0, elem->poub.size());
-					target0->bind(1, elem->ub.get(), elem->ubIndex);
+			if constexpr (YRGraphics::VULKAN_GRAPHICS) {
+				if (elem->ubIndex >= 0) { target0->bind(PER_OBJ_UB_DESCRIPTOR_BIND_INDEX, elem->ub.get(), elem->ubIndex); }
+			}
+			else {
+				if (elem->poub.size() && perObjectUB) { target0->bind(PER_OBJ_UB_DESCRIPTOR_BIND_INDEX, perObjectUB.get(), perObjectIndex++); }
+				else if (elem->poub.size() && perObjectFallback) {
+					if (!elem->ub || elem->ubIndex < 0) {
+						UniformBufferCreationOptions opts;
+						opts.size = elem->poub.size();
+						elem->ub = YRGraphics::createUniformBuffer(INT32_MIN, opts);
+						elem->ubIndex = 0;
+					}
+					if (elem->ub) {
+						elem->ub->update(elem->poub.data(), elem->ubIndex, 0, (uint32_t)elem->poub.size());
+						target0->bind(PER_OBJ_UB_DESCRIPTOR_BIND_INDEX, elem->ub.get(), elem->ubIndex);
+					}
 				}
 			}
 
@@ -81,51 +273,105 @@ namespace onart {
 			if (elem->mesh1) { target0->invoke(elem->mesh0, elem->mesh1, elem->instanceCount, 0, elem->meshRangeCount, elem->meshRangeCount); }
 			else { target0->invoke(elem->mesh0, elem->meshRangeStart, elem->meshRangeCount); }
 		}
-		if (invalidHead < ve.size()) {
-			ve.resize(invalidHead);
-		}
 	}
 
-	IntermediateScene::IntermediateScene(const RenderPassCreationOptions& opts) {		
+	IntermediateScene::IntermediateScene(const RenderPassCreationOptions& opts): opts(opts) {
+		if (opts.targets) {
+			optTargets.assign(opts.targets, opts.targets + opts.subpassCount);
+			this->opts.targets = optTargets.data();
+		}
+		if (opts.depthInput) {
+			optDepthInput.reset(new bool[opts.subpassCount]);
+			std::copy(opts.depthInput, opts.depthInput + opts.subpassCount, optDepthInput.get());
+			this->opts.depthInput = optDepthInput.get();
+		}
 		target0 = YRGraphics::createRenderPass(INT32_MIN, opts);
 	}
 
 	IntermediateScene::~IntermediateScene() {
+		topologyVersion++;
 		clear();
 		for (auto it = pred.begin(); it != pred.end(); ++it) { (*it)->succ.erase(this); }
 		for (auto it = succ.begin(); it != succ.end(); ++it) { (*it)->removePred(this); }
 		for (auto it = succ2.begin(); it != succ2.end(); ++it) { (*it)->removePred(this); }
 	}
 
+	void IntermediateScene::setTarget(const YRGraphics::pRenderPass& target, bool alias) {
+		aliased = alias;
+		if (target0 == target) { return; }
+		YRGraphics::pRenderPass old = std::move(target0);
+		target0 = target;
+		// 후속 장면이 이 장면의 결과를 샘플링하고 있었다면 새 타겟을 보도록 바꿈
+		for (IntermediateScene* sc : succ) {
+			for (VisualElement& elem : sc->elements) {
+				if (elem.rtTexture == old) { elem.rtTexture = target0; }
+			}
+		}
+		for (FinalScene* sc : succ2) {
+			for (VisualElement& elem : sc->elements) {
+				if (elem.rtTexture == old) { elem.rtTexture = target0; }
+			}
+		}
+	}
+
 	void IntermediateScene::resize(uint32_t width, uint32_t height) {
-		target0->resize(width, height);
+		opts.width = width;
+		opts.height = height;
+		if (aliased) {
+			setTarget(YRGraphics::createRenderPass(INT32_MIN, opts), false);
+		}
+		else {
+			target0->resize(width, height);
+		}
+		topologyVersion++;
 	}
 
 	void IntermediateScene::addPred(IntermediateScene* sc) {
 		sc->succ.insert(this);
 		pred.insert(sc);
+		topologyVersion++;
 	}
 
 	void IntermediateScene::removePred(IntermediateScene* sc) {
 		sc->succ.erase(this);
 		pred.erase(sc);
+		topologyVersion++;
+	}
+
+	void IntermediateScene::setTransient(bool t) {
+		if (transient == t) { return; }
+		transient = t;
+		if (!transient && aliased) {
+			setTarget(YRGraphics::createRenderPass(INT32_MIN, opts), false);
+		}
+		topologyVersion++;
+	}
+
+	bool IntermediateScene::sameTarget(const IntermediateScene& other) const {
+		const RenderPassCreationOptions& o = other.opts;
+		if (opts.width != o.width || opts.height != o.height || opts.subpassCount != o.subpassCount) { return false; }
+		if (opts.linearSampled != o.linearSampled || opts.canCopy != o.canCopy || opts.autoclear.use != o.autoclear.use) { return false; }
+		if (opts.autoclear.use && std::memcmp(opts.autoclear.color, o.autoclear.color, sizeof(opts.autoclear.color)) != 0) { return false; }
+		if (optTargets != other.optTargets) { return false; }
+		for (uint32_t i = 0; i < opts.subpassCount; i++) {
+			bool d1 = optDepthInput ? optDepthInput[i] : false;
+			bool d2 = other.optDepthInput ? other.optDepthInput[i] : false;
+			if (d1 != d2) { return false; }
+		}
+		return true;
 	}
 
 	void IntermediateScene::draw() {
 		Scene::draw(target0);
-		YRGraphics::RenderPass* prerequisites[16]{};
-		size_t idx = 0;
+		std::vector<YRGraphics::RenderPass*> prerequisites;
+		prerequisites.reserve(pred.size());
 		for (auto& pr : pred) { 
-			if (pr->ve.size()) {
-				prerequisites[idx++] = pr->target0.get();
+			if (pr->elements.size()) {
+				prerequisites.push_back(pr->target0.get());
 			}
 		}
 
-		target0->execute(succ.size() + succ2.size(), idx, prerequisites);
-	}
-
-	std::shared_ptr<VisualElement> VisualElement::create() {
-		return std::make_shared<shp_t<VisualElement>>();
+		target0->execute(succ.size() + succ2.size(), prerequisites.size(), prerequisites.data());
 	}
 
 	void VisualElement::updatePOUB(const void* data, uint32_t offset, uint32_t size) {
@@ -138,27 +384,268 @@ namespace onart {
 	void FinalScene::addPred(IntermediateScene* sc) { 
 		pred.insert(sc);
 		sc->succ2.insert(this);
+		IntermediateScene::topologyVersion++;
 	}
 
 	void FinalScene::removePred(IntermediateScene* sc) { 
 		pred.erase(sc);
 		sc->succ2.erase(this);
+		IntermediateScene::topologyVersion++;
 	}
 	
 	void FinalScene::draw() {
 		Scene::draw(target0);
-		YRGraphics::RenderPass* prerequisites[16]{};
-		size_t idx = 0;
+		std::vector<YRGraphics::RenderPass*> prerequisites;
+		prerequisites.reserve(pred.size());
 		for (auto& pr : pred) { 
-			if (pr->ve.size()) {
-				prerequisites[idx++] = pr->target0.get();
+			if (pr->elements.size()) {
+				prerequisites.push_back(pr->target0.get());
 			}
 		}
-		target0->execute(idx, prerequisites);
+		target0->execute(prerequisites.size(), prerequisites.data());
 	}
 
 	FinalScene::~FinalScene() {
+		IntermediateScene::topologyVersion++;
 		clear();
 		for (auto it = pred.begin(); it != pred.end(); ++it) { (*it)->succ2.erase(this); }
 	}
-}
\ No newline at end of file
+
+	bool RenderGraph::compile(FinalScene* const* rootArray, size_t count) {
+		roots.assign(rootArray, rootArray + count);
+		order.clear();
+		nodes.clear();
+		preds.clear();
+		succs.clear();
+		rootPreds.clear();
+		finalPreds.clear();
+		compiledVersion = IntermediateScene::topologyVersion;
+
+		// 후위 순회로 선행 장면이 항상 앞에 오도록 정렬. 방문 중인 장면은 UINT32_MAX
+		std::unordered_map<IntermediateScene*, uint32_t> position;
+		std::vector<std::pair<IntermediateScene*, std::set<IntermediateScene*>::iterator>> stack;
+		for (FinalScene* root : roots) {
+			for (IntermediateScene* start : root->pred) {
+				if (position.find(start) != position.end()) { continue; }
+				position[start] = UINT32_MAX;
+				stack.emplace_back(start, start->pred.begin());
+				while (!stack.empty()) {
+					IntermediateScene* scene = stack.back().first;
+					auto& it = stack.back().second;
+					if (it == scene->pred.end()) {
+						position[scene] = (uint32_t)order.size();
+						order.push_back(scene);
+						stack.pop_back();
+						continue;
+					}
+					IntermediateScene* next = *(it++);
+					auto found = position.find(next);
+					if (found == position.end()) {
+						position[next] = UINT32_MAX;
+						stack.emplace_back(next, next->pred.begin());
+					}
+					else if (found->second == UINT32_MAX) {
+						LOGWITH("Scene dependency has a cycle");
+						roots.clear();
+						order.clear();
+						return false;
+					}
+				}
+			}
+		}
+
+		nodes.resize(order.size());
+		for (uint32_t i = 0; i < (uint32_t)order.size(); i++) {
+			IntermediateScene* scene = order[i];
+			Node& node = nodes[i];
+			node.predBegin = (uint32_t)preds.size();
+			for (IntermediateScene* pr : scene->pred) { preds.push_back(position[pr]); }
+			node.predEnd = (uint32_t)preds.size();
+			node.succBegin = (uint32_t)succs.size();
+			for (IntermediateScene* sc : scene->succ) {
+				auto found = position.find(sc);
+				if (found != position.end()) { succs.push_back(found->second); }
+			}
+			node.succEnd = (uint32_t)succs.size();
+			node.finalSuccCount = 0;
+			for (FinalScene* sc : scene->succ2) {
+				if (std::find(roots.begin(), roots.end(), sc) != roots.end()) { node.finalSuccCount++; }
+			}
+		}
+		for (FinalScene* root : roots) {
+			uint32_t begin = (uint32_t)finalPreds.size();
+			for (IntermediateScene* pr : root->pred) { finalPreds.push_back(position[pr]); }
+			rootPreds.emplace_back(begin, (uint32_t)finalPreds.size());
+		}
+
+		// transient 장면의 결과는 마지막으로 읽는 장면까지만 유지되면 되므로, 그 이후에 시작하는 같은 형태의 장면에 타겟을 넘김
+		struct TargetSlot {
+			IntermediateScene* owner;
+			uint32_t lastUse;
+			bool shared;
+		};
+		std::vector<TargetSlot> slots;
+		for (uint32_t i = 0; i < (uint32_t)order.size(); i++) {
+			IntermediateScene* scene = order[i];
+			if (!scene->transient) { continue; }
+			const Node& node = nodes[i];
+			uint32_t lastUse = node.finalSuccCount ? UINT32_MAX : i;
+			for (uint32_t j = node.succBegin; j < node.succEnd; j++) { lastUse = std::max(lastUse, succs[j]); }
+			TargetSlot* reuse = nullptr;
+			for (TargetSlot& slot : slots) {
+				if (slot.lastUse < i && slot.owner->sameTarget(*scene)) {
+					reuse = &slot;
+					break;
+				}
+			}
+			if (reuse) {
+				scene->setTarget(reuse->owner->target0, true);
+				reuse->lastUse = lastUse;
+				reuse->shared = true;
+			}
+			else {
+				if (scene->aliased) {
+					scene->setTarget(YRGraphics::createRenderPass(INT32_MIN, scene->opts), false);
+				}
+				slots.push_back({ scene, lastUse, false });
+			}
+		}
+#ifdef YR_USE_VULKAN
+		// 공유되는 타겟만 이전 사용자의 샘플링을 기다리도록 하고, 나머지 패스는 기본 의존성을 그대로 씀
+		for (TargetSlot& slot : slots) { slot.owner->target0->setShared(slot.shared); }
+#endif
+		return true;
+	}
+
+	void RenderGraph::draw() {
+		if (compiledVersion != IntermediateScene::topologyVersion) {
+			std::vector<FinalScene*> prevRoots(std::move(roots));
+			if (!compile(prevRoots.data(), prevRoots.size())) { return; }
+		}
+		active.resize(order.size());
+		for (size_t i = 0; i < order.size(); i++) { active[i] = order[i]->elements.size() != 0; }
+		for (uint32_t i = 0; i < (uint32_t)order.size(); i++) {
+			if (!active[i]) { continue; }
+			IntermediateScene* scene = order[i];
+			const Node& node = nodes[i];
+			static_cast<Scene*>(scene)->draw(scene->target0);
+			prerequisites.clear();
+			for (uint32_t j = node.predBegin; j < node.predEnd; j++) {
+				if (active[preds[j]]) { prerequisites.push_back(order[preds[j]]->target0.get()); }
+			}
+			size_t successorCount = node.finalSuccCount;
+			for (uint32_t j = node.succBegin; j < node.succEnd; j++) {
+				if (active[succs[j]]) { successorCount++; }
+			}
+			scene->target0->execute(successorCount, prerequisites.size(), prerequisites.data());
+		}
+		for (size_t r = 0; r < roots.size(); r++) {
+			FinalScene* root = roots[r];
+			static_cast<Scene*>(root)->draw(root->target0);
+			prerequisites.clear();
+			for (uint32_t j = rootPreds[r].first; j < rootPreds[r].second; j++) {
+				if (active[finalPreds[j]]) { prerequisites.push_back(order[finalPreds[j]]->target0.get()); }
+			}
+			root->target0->execute(prerequisites.size(), prerequisites.data());
+		}
+	}
+
+	void RenderGraph::restoreTargets() {
+		// 마지막 컴파일 이후 장면이 소멸했을 수 있으면 건드리지 않음
+		if (compiledVersion != IntermediateScene::topologyVersion) { return; }
+		for (IntermediateScene* scene : order) {
+			if (scene->aliased) {
+				scene->setTarget(YRGraphics::createRenderPass(INT32_MIN, scene->opts), false);
+			}
+#ifdef YR_USE_VULKAN
+			else { scene->target0->setShared(false); }
+#endif
+		}
+	}
+
+	void RenderGraph::clear() {
+		restoreTargets();
+		roots.clear();
+		order.clear();
+		nodes.clear();
+		preds.clear();
+		succs.clear();
+		rootPreds.clear();
+		finalPreds.clear();
+		compiledVersion = UINT64_MAX;
+	}
+
+	RenderGraph::~RenderGraph() {
+		restoreTargets();
+	}
+
+	DynamicResolution::DynamicResolution(const DynamicResolutionOptions& opts) : opts(opts), scale(opts.maxScale) {}
+
+	void DynamicResolution::apply(const Target& target) const {
+		uint32_t width = std::max(1u, (uint32_t)(target.width * scale + 0.5f));
+		uint32_t height = std::max(1u, (uint32_t)(target.height * scale + 0.5f));
+		target.scene->resize(width, height);
+	}
+
+	void DynamicResolution::addScene(IntermediateScene* scene, uint32_t baseWidth, uint32_t baseHeight) {
+		for (Target& t : targets) {
+			if (t.scene == scene) {
+				t.width = baseWidth;
+				t.height = baseHeight;
+				apply(t);
+				return;
+			}
+		}
+		targets.push_back({ scene, baseWidth, baseHeight });
+		apply(targets.back());
+	}
+
+	void DynamicResolution::removeScene(IntermediateScene* scene) {
+		for (size_t i = 0; i < targets.size(); i++) {
+			if (targets[i].scene == scene) {
+				targets[i] = targets.back();
+				targets.pop_back();
+				return;
+			}
+		}
+	}
+
+	void DynamicResolution::setBaseSize(IntermediateScene* scene, uint32_t baseWidth, uint32_t baseHeight) {
+		addScene(scene, baseWidth, baseHeight);
+	}
+
+	bool DynamicResolution::update(float frameTime) {
+		if (average == 0) { average = frameTime; }
+		else { average += (frameTime - average) * opts.smoothing; }
+		if (cooldown) {
+			cooldown--;
+			return false;
+		}
+		float next = scale;
+		if (average > opts.targetFrameTime * opts.downThreshold) {
+			// 비용이 픽셀 수(배율의 제곱)에 비례한다고 보고 한 번에 필요한 만큼 내림
+			next = scale * std::sqrt(opts.targetFrameTime / average);
+			next = std::floor(next / opts.step) * opts.step;
+			if (next >= scale) { next = scale - opts.step; }
+		}
+		else if (average < opts.targetFrameTime * opts.upThreshold) {
+			// 올릴 때는 진동하지 않도록 한 단계씩
+			next = std::floor(scale / opts.step + 0.5f) * opts.step + opts.step;
+		}
+		next = std::clamp(next, opts.minScale, opts.maxScale);
+		if (std::abs(next - scale) < opts.step * 0.5f) { return false; }
+		scale = next;
+		cooldown = opts.cooldownFrames;
+		for (const Target& t : targets) { apply(t); }
+		return true;
+	}
+
+	void DynamicResolution::reset() {
+		average = 0;
+		cooldown = 0;
+		if (scale != opts.maxScale) {
+			scale = opts.maxScale;
+			for (const Target& t : targets) { apply(t); }
+		}
+	}
+}
@@ -19,6 +19,9 @@ namespace onart
     struct VisualElement{
         friend class Scene;
         public:
+            VisualElement() = default;
+            VisualElement(VisualElement&&) = default;
+            VisualElement& operator=(VisualElement&&) = default;
             YRGraphics::pMesh mesh0; // basic mesh
             YRGraphics::pMesh mesh1; // instance data
             YRGraphics::pTexture texture; // todo: plus lighting parameter
@@ -27,13 +30,14 @@ namespace onart
             YRGraphics::pRenderPass rtTexture;
             YRGraphics::pUniformBuffer ub;
             std::vector<uint8_t> pushed; // per object push data
-            std::vector<uint8_t> poub; // per object ub data (only for non-vulkan ver)
+            std::vector<uint8_t> poub; // per object ub data (only for non-vulkan ver). Scene이 프레임마다 모아서 한 번에 올리므로 ub를 따로 만들 필요가 없습니다. (동적 유니폼 버퍼를 만들 수 없는 환경에서는 Scene이 요소별 ub를 만들어 사용합니다.)
             std::unique_ptr<FreeRenderer> fr = nullptr;
             unsigned instanceCount = 1;
             unsigned meshRangeStart = 0;
             unsigned meshRangeCount = 0;
             int ubIndex = -1; // dynamic ub index
-            static std::shared_ptr<VisualElement> create();
+            bool transparent = false; // true면 불투명 요소를 모두 그린 후 뒤에서부터 그립니다.
+            vec3 sortPosition; // 깊이 정렬에 사용할 월드 위치
             void updatePOUB(const void* data, uint32_t offsetByte, uint32_t size);
             inline void reset() {
                 mesh0 = {};
@@ -55,38 +59,90 @@ namespace onart
                 meshRangeStart = 0;
                 meshRangeCount = 0;
                 ubIndex = -1;
+                transparent = false;
+                sortPosition = {};
             }
-            inline uint16_t getSceneRefCount() const { return sceneRefs; }
-        protected:
-            ~VisualElement() = default;
         private:
-            uint16_t sceneRefs = 0;
+            uint32_t slot = 0; // 이 요소를 가리키는 Scene 슬롯 번호
+            uint32_t sequence = 0; // Scene 안에서의 삽입 순서. 깊이 정렬을 하지 않는 장면은 이 순서대로 그립니다.
     };
 
-    using pVisualElement = std::shared_ptr<VisualElement>;
+    /// @brief Scene 내 VisualElement를 가리키는 세대 핸들입니다. 요소가 제거된 후 같은 슬롯이 재사용되어도 세대가 다르므로 무효한 핸들로 판별됩니다.
+    struct VisualElementHandle {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+        inline bool operator==(const VisualElementHandle& other) const { return index == other.index && generation == other.generation; }
+        inline bool operator!=(const VisualElementHandle& other) const { return !operator==(other); }
+    };
 
     class Scene{
+    friend class RenderGraph;
     protected:
         template<class RP>
         void draw(RP&);
-        std::vector<std::shared_ptr<VisualElement>> ve;
-        size_t poolSize = 0;
+        /// @brief 슬롯 번호를 elements의 위치로 변환합니다. 빈 슬롯의 dense는 UINT32_MAX입니다.
+        struct ElementSlot {
+            uint32_t dense = UINT32_MAX;
+            uint32_t generation = 0;
+        };
+        std::vector<VisualElement> elements; // 그리기 순서대로 연속 저장된 요소
+        std::vector<ElementSlot> slots;
+        std::vector<uint32_t> freeSlots;
+        void relinkSlots();
+        /// @brief 제거로 흐트러진 elements를 삽입 순서로 되돌립니다. 제거가 없었으면 아무 일도 하지 않습니다.
+        void restoreInsertionOrder();
+        uint32_t nextSequence = 0;
+        bool orderBroken = false; // remove()가 맨 뒤 요소를 당겨와 elements가 삽입 순서가 아님
+        /// @brief 불투명/반투명 요소를 나누고 깊이 순으로 정렬하여 drawOrder를 만듭니다.
+        void buildDrawOrder();
+        std::vector<uint32_t> drawOrder; // 이번 프레임에 그릴 elements 순서
+        std::vector<uint64_t> sortItems, sortScratch; // 상위 32비트 키, 하위 32비트 elements 위치
+        std::vector<float> sortDepth;
+        mat4 sortView;
+        bool depthSort = false;
+        /// @brief 모든 요소의 poub를 하나의 동적 유니폼 버퍼로 모아 한 번에 올립니다. (non-vulkan 전용)
+        void uploadPerObjectData();
+        YRGraphics::pUniformBuffer perObjectUB; // 프레임 단위로 poub를 모아 올리는 동적 유니폼 버퍼
+        std::vector<uint8_t> perObjectStaging;
+        uint32_t perObjectCapacity = 0;
+        uint32_t perObjectSize = 0;
+        bool perObjectFallback = false; // 동적 유니폼 버퍼 생성에 실패한 경우 true. 이후로는 요소마다 따로 갱신합니다.
     public:
         YRGraphics::pUniformBuffer perFrameUB;
-        void insert(const std::shared_ptr<VisualElement>&);
+        /// @brief 새 요소를 장면 안에 생성하고 그 핸들을 리턴합니다.
+        VisualElementHandle insert();
+        /// @brief 핸들이 가리키는 요소를 제거합니다. 맨 뒤 요소를 빈 자리로 옮기므로 상수 시간이며, 깊이 정렬이나 sorter가 없는 장면의 그리기 순서(삽입 순서)는 다음 그리기 전에 되돌려집니다. 이미 제거된 핸들이면 아무 일도 일어나지 않습니다.
+        void remove(VisualElementHandle handle);
+        /// @brief 핸들이 가리키는 요소를 리턴합니다. 제거된 핸들이면 nullptr를 리턴합니다.
+        /// 리턴된 포인터는 이 장면에 insert/remove/draw를 호출하기 전까지만 유효하므로 보관하지 말고 핸들을 보관하세요.
+        VisualElement* get(VisualElementHandle handle);
+        /// @brief 핸들이 가리키는 요소가 아직 살아 있는지 확인합니다.
+        bool isValid(VisualElementHandle handle) const;
+        inline size_t size() const { return elements.size(); }
         void clear();
-        std::function<void(decltype(ve)&)> sorter{};
+        /// @brief 깊이 정렬에 사용할 뷰 행렬을 설정합니다. 설정하면 불투명 요소는 대략 앞에서 뒤로(같은 깊이 구간에서는 파이프라인끼리), 반투명 요소는 정확히 뒤에서 앞으로 그립니다.
+        /// 설정하지 않으면 각 버킷 안에서는 삽입 순서를 유지합니다.
+        void setSortView(const mat4& view);
+        /// @brief 깊이 정렬을 끕니다. 불투명 요소를 먼저 그리는 것은 유지됩니다.
+        inline void disableDepthSort() { depthSort = false; }
+        /// @brief 그리기 전 요소 순서를 바꿉니다. 요소를 추가/제거하지 말고 순서만 바꿔야 합니다. 주어진 경우 불투명/반투명 구분과 깊이 정렬은 하지 않습니다.
+        std::function<void(decltype(elements)&)> sorter{};
         ~Scene();
     };
 
     class IntermediateScene: public Scene{
     friend class FinalScene;
+    friend class RenderGraph;
     public:
         IntermediateScene(const RenderPassCreationOptions&);
+        /// @brief 타겟 크기를 바꿉니다. RenderGraph에서 다른 장면과 타겟을 공유 중이라면 그 장면들의 타겟도 함께 바뀌므로 그래프가 다시 컴파일됩니다.
         void resize(uint32_t width, uint32_t height);
         void addPred(IntermediateScene* scene);
         void removePred(IntermediateScene* scene);
         void draw();
+        /// @brief RenderGraph에서 타겟을 다른 장면과 공유해도 되는지 설정합니다. 이 장면의 결과를 그래프 내의 후속 장면 외에서(다음 프레임, 복사 등) 읽지 않는 경우에만 true로 설정하세요. 기본값 false
+        void setTransient(bool transient);
+        /// @brief 렌더 타겟을 리턴합니다. transient 장면은 RenderGraph 컴파일 시 타겟이 바뀔 수 있으며, 이 때 후속 장면 요소의 rtTexture 중 이전 타겟을 가리키던 것은 새 타겟으로 바뀝니다. 그 외의 곳에 보관한 타겟은 컴파일 후에 다시 가져와야 합니다.
         inline YRGraphics::pRenderPass& getRenderpass() { return target0; }
         ~IntermediateScene();
     private:
@@ -94,9 +150,22 @@ namespace onart
         std::set<IntermediateScene*> succ;
         std::set<class FinalScene*> succ2;
         YRGraphics::pRenderPass target0;
+        /// @brief 생성 옵션 사본입니다. 공유 가능 여부 판정과 타겟 재생성에 사용됩니다.
+        RenderPassCreationOptions opts;
+        std::vector<RenderTargetType> optTargets;
+        std::unique_ptr<bool[]> optDepthInput;
+        bool transient = false;
+        bool aliased = false; // target0가 다른 장면의 것인지
+        bool sameTarget(const IntermediateScene& other) const;
+        /// @brief 타겟을 바꾸고, 후속 장면 요소 중 이전 타겟을 샘플링하던 것이 새 타겟을 보도록 합니다.
+        void setTarget(const YRGraphics::pRenderPass& target, bool alias);
+        /// @brief 장면 간 선후 관계가 바뀔 때마다 증가합니다. RenderGraph가 재컴파일 여부를 판단할 때 사용합니다.
+        inline static uint64_t topologyVersion = 0;
     };
 
     class FinalScene: public Scene{
+    friend class RenderGraph;
+    friend class IntermediateScene;
     public:
         FinalScene(const YRGraphics::pRenderPass2Screen&);
         void addPred(IntermediateScene* scene);
@@ -107,6 +176,90 @@ namespace onart
         std::set<IntermediateScene*> pred;
         YRGraphics::pRenderPass2Screen target0;
     };
+
+    /// @brief IntermediateScene/FinalScene의 선후 관계를 한 번 위상 정렬해 두고 매 프레임 그 순서대로 그리는 렌더 그래프입니다.
+    /// 최종 장면에 결과가 도달하지 않는 장면은 그리지 않으며, 수명이 겹치지 않는 transient 장면끼리는 렌더 타겟을 공유합니다.
+    class RenderGraph {
+    public:
+        /// @brief 주어진 최종 장면들로부터 선행 관계를 거슬러 도달 가능한 장면만 모아 정렬합니다. 최종 장면들은 이 그래프보다 오래 유지되어야 합니다.
+        /// @return 순환 관계가 있으면 false를 리턴하며, 이 때 그래프는 비어 있게 됩니다.
+        bool compile(FinalScene* const* roots, size_t count);
+        inline bool compile(FinalScene* root) { return compile(&root, 1); }
+        /// @brief 정렬된 순서대로 모든 장면을 그립니다. 마지막 컴파일 이후 장면 간 관계가 바뀌었으면 먼저 다시 컴파일합니다.
+        void draw();
+        /// @brief 정렬된 IntermediateScene 순서를 리턴합니다.
+        inline const std::vector<IntermediateScene*>& getOrder() const { return order; }
+        /// @brief 컴파일 결과를 비웁니다. 공유하던 타겟은 각 장면 고유의 것으로 되돌립니다.
+        void clear();
+        ~RenderGraph();
+    private:
+        struct Node {
+            uint32_t predBegin, predEnd; // preds 내 범위
+            uint32_t succBegin, succEnd; // succs 내 범위
+            uint32_t finalSuccCount;
+        };
+        void restoreTargets();
+        std::vector<FinalScene*> roots;
+        std::vector<IntermediateScene*> order;
+        std::vector<Node> nodes;
+        std::vector<uint32_t> preds; // order 내 번호
+        std::vector<uint32_t> succs; // order 내 번호
+        std::vector<std::pair<uint32_t, uint32_t>> rootPreds; // roots별 finalPreds 내 범위
+        std::vector<uint32_t> finalPreds;
+        std::vector<uint8_t> active;
+        std::vector<YRGraphics::RenderPass*> prerequisites;
+        uint64_t compiledVersion = UINT64_MAX;
+    };
+
+    /// @brief DynamicResolution의 조절 기준입니다.
+    struct DynamicResolutionOptions {
+        /// @brief 목표 프레임 시간(초)입니다. 기본값 1/60
+        float targetFrameTime = 1.0f / 60;
+        /// @brief 최소/최대 배율입니다. 기본값 0.5, 1
+        float minScale = 0.5f, maxScale = 1.0f;
+        /// @brief 배율 단위입니다. 배율은 항상 이 값의 배수(또는 최소/최대값)가 되며, 렌더 타겟을 너무 자주 다시 만들지 않도록 하는 역할도 합니다. 기본값 0.05
+        float step = 0.05f;
+        /// @brief 평균 프레임 시간이 목표의 이 비율을 넘으면 해상도를 낮춥니다. 기본값 1.05
+        float downThreshold = 1.05f;
+        /// @brief 평균 프레임 시간이 목표의 이 비율보다 작으면 해상도를 한 단계 높입니다. 기본값 0.85
+        float upThreshold = 0.85f;
+        /// @brief 프레임 시간 지수이동평균 계수(0~1)입니다. 클수록 최근 프레임 비중이 큽니다. 기본값 0.1
+        float smoothing = 0.1f;
+        /// @brief 배율을 바꾼 후 다시 바꾸기 전까지 최소 프레임 수입니다. 기본값 30
+        uint32_t cooldownFrames = 30;
+    };
+
+    /// @brief 프레임 시간에 따라 IntermediateScene의 렌더 타겟 해상도를 조절하는 컨트롤러입니다.
+    /// 타겟 전체 크기를 바꾸므로 FinalScene에서 그 결과를 텍스처 좌표 0~1로 샘플링하고 있다면 자연스럽게 화면 크기로 업스케일됩니다.
+    /// 등록된 장면이 없어도 동작하므로 임의의 프레임 시간을 넣어 동작을 확인할 수 있습니다.
+    class DynamicResolution {
+    public:
+        DynamicResolution(const DynamicResolutionOptions& opts = {});
+        /// @brief 조절 대상 장면을 추가합니다. 주어진 크기가 배율 1일 때의 크기이며, 현재 배율이 즉시 적용됩니다.
+        void addScene(IntermediateScene* scene, uint32_t baseWidth, uint32_t baseHeight);
+        void removeScene(IntermediateScene* scene);
+        /// @brief 장면의 배율 1 크기를 바꿉니다. 창 크기가 바뀌었을 때 호출하세요.
+        void setBaseSize(IntermediateScene* scene, uint32_t baseWidth, uint32_t baseHeight);
+        /// @brief 측정한 프레임 시간(초)을 반영합니다. 배율이 바뀌면 등록된 장면의 크기를 바꾸고 true를 리턴합니다. 보통 매 프레임 Game::dt를 넣으면 됩니다.
+        bool update(float frameTime);
+        /// @brief 현재 배율을 리턴합니다.
+        inline float getScale() const { return scale; }
+        /// @brief 평균 프레임 시간(초)을 리턴합니다.
+        inline float getAverageFrameTime() const { return average; }
+        /// @brief 배율을 최대로 되돌리고 측정값을 초기화합니다.
+        void reset();
+    private:
+        struct Target {
+            IntermediateScene* scene;
+            uint32_t width, height;
+        };
+        void apply(const Target& target) const;
+        DynamicResolutionOptions opts;
+        std::vector<Target> targets;
+        float scale;
+        float average = 0;
+        uint32_t cooldown = 0;
+    };
 }
 
 
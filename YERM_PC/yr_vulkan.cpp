@@ -479,6 +479,11 @@ namespace onart {
     void VkMachine::free() {
         reap();
         vkDeviceWaitIdle(device);
+        if (stream.buffer) { vmaDestroyBuffer(allocator, stream.buffer, stream.alloc); }
+        for (VkFence& fence : stream.fences) { vkDestroyFence(device, fence, nullptr); fence = VK_NULL_HANDLE; }
+        stream.buffer = VK_NULL_HANDLE;
+        stream.alloc = nullptr;
+        stream.mapped = nullptr;
         for(VkSampler& sampler: textureSampler) { vkDestroySampler(device, sampler, nullptr); sampler = VK_NULL_HANDLE; }
         vkDestroySampler(device, nearestSampler, nullptr); nearestSampler = VK_NULL_HANDLE;
         for(auto& ly: descriptorSetLayouts) { vkDestroyDescriptorSetLayout(device, ly.second, nullptr); }
@@ -559,6 +564,7 @@ namespace onart {
 
     void VkMachine::handle() {
         singleton->loadThread.handleCompleted();
+        singleton->advanceStream();
     }
 
     void VkMachine::post(std::function<variant8(void)> exec, std::function<void(variant8)> handler, uint8_t strand) {
@@ -642,6 +648,141 @@ namespace onart {
         return singleton->meshes[name] = std::make_shared<shp_t<Mesh>>(VK_NULL_HANDLE, VK_NULL_HANDLE, vcount, 0, 0, false);
     }
 
+    bool VkMachine::createStreamBuffer(uint64_t capacity) {
+        for (uint32_t i = 0; i < STREAM_FRAMES; i++) {
+            if (stream.pending[i]) {
+                vkWaitForFences(device, 1, &stream.fences[i], VK_FALSE, UINT64_MAX);
+                stream.pending[i] = false;
+            }
+            if (!stream.fences[i]) {
+                stream.fences[i] = createFence();
+                if (!stream.fences[i]) { return false; }
+            }
+        }
+        if (stream.buffer) {
+            vmaDestroyBuffer(allocator, stream.buffer, stream.alloc);
+            stream.buffer = VK_NULL_HANDLE;
+            stream.alloc = nullptr;
+            stream.mapped = nullptr;
+            stream.capacity = 0;
+        }
+
+        VkBufferCreateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        info.size = capacity * STREAM_FRAMES;
+        info.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+        info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        allocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT; // 매 프레임 flush하지 않도록
+        VmaAllocationInfo mapInfo;
+        reason = vmaCreateBuffer(allocator, &info, &allocInfo, &stream.buffer, &stream.alloc, &mapInfo);
+        if (reason != VK_SUCCESS) {
+            LOGWITH("Failed to create stream buffer:", reason, resultAsString(reason));
+            stream.buffer = VK_NULL_HANDLE;
+            stream.alloc = nullptr;
+            return false;
+        }
+        stream.mapped = (uint8_t*)mapInfo.pMappedData;
+        stream.capacity = capacity;
+        return true;
+    }
+
+    void VkMachine::advanceStream() {
+        if (!stream.buffer) return;
+        const uint32_t current = stream.frame % STREAM_FRAMES;
+        if (stream.used) {
+            // 빈 제출에 붙인 펜스는 그 전에 큐에 제출된 명령이 모두 끝나면 신호를 받습니다.
+            vkResetFences(device, 1, &stream.fences[current]);
+            if (qSubmit(true, 0, nullptr, stream.fences[current]) == VK_SUCCESS) { stream.pending[current] = true; }
+            else { vkDeviceWaitIdle(device); }
+        }
+        stream.frame++;
+        const uint32_t next = stream.frame % STREAM_FRAMES;
+        if (stream.pending[next]) {
+            vkWaitForFences(device, 1, &stream.fences[next], VK_FALSE, UINT64_MAX);
+            stream.pending[next] = false;
+        }
+        if (stream.demand > stream.capacity) {
+            uint64_t capacity = stream.capacity * 2;
+            while (capacity < stream.demand) { capacity *= 2; }
+            createStreamBuffer(capacity);
+        }
+        stream.used = 0;
+        stream.demand = 0;
+    }
+
+    VkMachine::StreamGeometry VkMachine::allocateStreamGeometry(uint32_t vertexCount, uint32_t singleVertexSize, uint32_t indexCount, uint32_t singleIndexSize) {
+        constexpr uint64_t DEFAULT_STREAM_CAPACITY = 4 << 20;
+        if (indexCount != 0 && singleIndexSize != 2 && singleIndexSize != 4) {
+            LOGWITH("Invalid isize");
+            return {};
+        }
+        if (vertexCount == 0 || singleVertexSize == 0) { return {}; }
+        auto& stream = singleton->stream;
+        if (!stream.buffer && !singleton->createStreamBuffer(DEFAULT_STREAM_CAPACITY)) { return {}; }
+        const uint64_t vertexBegin = (stream.used + 15) & ~(uint64_t)15;
+        const uint64_t indexBegin = (vertexBegin + (uint64_t)vertexCount * singleVertexSize + 3) & ~(uint64_t)3;
+        const uint64_t end = indexBegin + (uint64_t)indexCount * singleIndexSize;
+        if (end > stream.capacity) {
+            if (stream.demand <= stream.capacity) { LOGWITH("Stream buffer is full in this frame; capacity will grow from the next frame"); }
+            stream.demand += end - stream.used;
+            return {};
+        }
+        stream.demand += end - stream.used;
+        stream.used = end;
+        const uint64_t base = stream.capacity * (stream.frame % STREAM_FRAMES);
+        StreamGeometry ret;
+        ret.vertices = stream.mapped + base + vertexBegin;
+        ret.indices = indexCount ? stream.mapped + base + indexBegin : nullptr;
+        ret.vertexCount = vertexCount;
+        ret.indexCount = indexCount;
+        ret.vertexSize = singleVertexSize;
+        ret.vertexOffset = base + vertexBegin;
+        ret.indexOffset = base + indexBegin;
+        ret.frame = stream.frame;
+        ret.use32 = singleIndexSize == 4;
+        return ret;
+    }
+
+    /// @brief 스트리밍 기하를 그리는 명령을 기록합니다. RenderPass와 RenderPass2Screen이 공유합니다.
+    static bool recordStreamDraw(VkCommandBuffer cb, VkBuffer buffer, uint32_t currentFrame, const VkMachine::StreamGeometry& geometry, uint32_t start, uint32_t count) {
+        if (!geometry || geometry.frame != currentFrame) {
+            LOGWITH("Invalid call: stream geometry is empty or was allocated in another frame");
+            return false;
+        }
+        const uint64_t total = geometry.indexCount ? geometry.indexCount : geometry.vertexCount;
+        if ((uint64_t)start + count > total) {
+            LOGWITH("Invalid call: this geometry has", total, geometry.indexCount ? "indices but" : "vertices but", start, "~", (uint64_t)start + count, "requested to be drawn");
+            return false;
+        }
+        if (count == 0) { count = uint32_t(total - start); }
+        VkDeviceSize offs = geometry.vertexOffset;
+        vkCmdBindVertexBuffers(cb, 0, 1, &buffer, &offs);
+        if (geometry.indexCount) {
+            vkCmdBindIndexBuffer(cb, buffer, geometry.indexOffset, geometry.use32 ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16);
+            vkCmdDrawIndexed(cb, count, 1, start, 0, 0);
+        }
+        else {
+            vkCmdDraw(cb, count, 1, start, 0);
+        }
+        return true;
+    }
+
+    /// @brief 스트리밍 인스턴스 기하가 이번 프레임 것이고 요청 범위를 담고 있는지 확인합니다. RenderPass와 RenderPass2Screen이 공유합니다.
+    static bool checkStreamInstances(uint32_t currentFrame, const VkMachine::StreamGeometry& instanceInfo, uint32_t instanceCount, uint32_t istart) {
+        if (!instanceInfo || instanceInfo.frame != currentFrame) {
+            LOGWITH("Invalid call: stream geometry is empty or was allocated in another frame");
+            return false;
+        }
+        if ((uint64_t)istart + instanceCount > instanceInfo.vertexCount) {
+            LOGWITH("Invalid call: this geometry has", instanceInfo.vertexCount, "instances but", istart, "~", (uint64_t)istart + instanceCount, "requested to be drawn");
+            return false;
+        }
+        return true;
+    }
+
     VkMachine::pMesh VkMachine::createMesh(int32_t key, const MeshCreationOptions& opts) {
         if (opts.indexCount != 0 && opts.singleIndexSize != 2 && opts.singleIndexSize != 4) {
             LOGWITH("Invalid isize");
@@ -3726,6 +3867,15 @@ namespace onart {
         bound = mesh.get();
     }
 
+    void VkMachine::RenderPass::invoke(const StreamGeometry& geometry, uint32_t start, uint32_t count) {
+        if (currentPass == -1) {
+            LOGWITH("Invalid call: render pass not begun");
+            return;
+        }
+        recordStreamDraw(recentCommandBuffer, singleton->stream.buffer, singleton->stream.frame, geometry, start, count);
+        bound = nullptr;
+    }
+
     void VkMachine::RenderPass::invoke(const pMesh& mesh, const pMesh& instanceInfo, uint32_t instanceCount, uint32_t istart, uint32_t start, uint32_t count) {
         if (currentPass == -1) {
             LOGWITH("Invalid call: render pass not begun");
@@ -3763,6 +3913,29 @@ namespace onart {
         bound = nullptr;
     }
 
+    void VkMachine::RenderPass::invoke(const pMesh& mesh, const StreamGeometry& instanceInfo, uint32_t instanceCount, uint32_t istart) {
+        if (currentPass == -1) {
+            LOGWITH("Invalid call: render pass not begun");
+            return;
+        }
+        if (!checkStreamInstances(singleton->stream.frame, instanceInfo, instanceCount, istart)) {
+            bound = nullptr;
+            return;
+        }
+        VkDeviceSize offs[2] = { 0, instanceInfo.vertexOffset };
+        VkBuffer buffs[2] = { mesh->vb, singleton->stream.buffer };
+        mesh->sync();
+        vkCmdBindVertexBuffers(recentCommandBuffer, 0, 2, buffs, offs);
+        if (mesh->icount) {
+            vkCmdBindIndexBuffer(recentCommandBuffer, mesh->vb, mesh->ioff, mesh->idxType);
+            vkCmdDrawIndexed(recentCommandBuffer, (uint32_t)mesh->icount, instanceCount, 0, 0, istart);
+        }
+        else {
+            vkCmdDraw(recentCommandBuffer, (uint32_t)mesh->vcount, instanceCount, 0, istart);
+        }
+        bound = nullptr;
+    }
+
     void VkMachine::RenderPass::execute(size_t successorCount, size_t predecessorCount, RenderPass** others) {
         if (currentPass != pipelines.size() - 1) {
             LOGWITH("Renderpass not started. This message can be ignored safely if the rendering goes fine after now");
@@ -3925,6 +4098,11 @@ namespace onart {
                 currentPass = -1;
                 return;
             }
+            if (shared) {
+                // 같은 타겟을 쓴 이전 내용의 후속 패스가 아직 샘플링 중일 수 있으므로(읽기 후 쓰기) 그 프래그먼트 셰이더가 끝난 뒤 타겟에 씁니다.
+                // 이전 패스는 임의 위치를 샘플링하므로 영역 단위로 줄일 수 없으며, 렌더패스의 외부 의존성과 COLOR_ATTACHMENT_OUTPUT 단계로 이어집니다.
+                vkCmdPipelineBarrier(recentCommandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+            }
             VkRenderPassBeginInfo rpInfo{};
             std::vector<VkClearValue> clearValues;
             if (autoclear) {
@@ -4423,6 +4601,15 @@ namespace onart {
         bound = mesh.get();
     }
 
+    void VkMachine::RenderPass2Screen::invoke(const StreamGeometry& geometry, uint32_t start, uint32_t count){
+        if(currentPass == -1){
+            LOGWITH("Invalid call: render pass not begun");
+            return;
+        }
+        recordStreamDraw(cbs[currentCB], singleton->stream.buffer, singleton->stream.frame, geometry, start, count);
+        bound = nullptr;
+    }
+
     void VkMachine::RenderPass2Screen::invoke(const pMesh& mesh, const pMesh& instanceInfo, uint32_t instanceCount, uint32_t istart, uint32_t start, uint32_t count){
          if(currentPass == -1){
             LOGWITH("Invalid call: render pass not begun");
@@ -4460,6 +4647,29 @@ namespace onart {
         bound = nullptr;
     }
 
+    void VkMachine::RenderPass2Screen::invoke(const pMesh& mesh, const StreamGeometry& instanceInfo, uint32_t instanceCount, uint32_t istart) {
+        if (currentPass == -1) {
+            LOGWITH("Invalid call: render pass not begun");
+            return;
+        }
+        if (!checkStreamInstances(singleton->stream.frame, instanceInfo, instanceCount, istart)) {
+            bound = nullptr;
+            return;
+        }
+        VkDeviceSize offs[2] = { 0, instanceInfo.vertexOffset };
+        VkBuffer buffs[2] = { mesh->vb, singleton->stream.buffer };
+        mesh->sync();
+        vkCmdBindVertexBuffers(cbs[currentCB], 0, 2, buffs, offs);
+        if (mesh->icount) {
+            vkCmdBindIndexBuffer(cbs[currentCB], mesh->vb, mesh->ioff, mesh->idxType);
+            vkCmdDrawIndexed(cbs[currentCB], (uint32_t)mesh->icount, instanceCount, 0, 0, istart);
+        }
+        else {
+            vkCmdDraw(cbs[currentCB], (uint32_t)mesh->vcount, instanceCount, 0, istart);
+        }
+        bound = nullptr;
+    }
+
     void VkMachine::RenderPass2Screen::clear(RenderTargetType toClear, float* colors) {
         if (currentPass < 0) {
             LOGWITH("This renderPass is currently not running");
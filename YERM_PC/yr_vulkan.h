@@ -214,6 +214,22 @@ namespace onart {
             /// @param vcount 정점의 수
             /// @param key 프로그램 내에서 사용할 이름입니다. INT32_MIN은 저장되지 않습니다.
             static pMesh createNullMesh(int32_t key, size_t vcount);
+            /// @brief 이번 프레임에만 쓸 정점/인덱스 공간입니다. 스프라이트, 글자, 디버그 선처럼 매 프레임 CPU에서 새로 만드는 기하에 사용합니다.
+            /// 다음 @ref handle 호출 이후에는 사용할 수 없습니다.
+            struct StreamGeometry {
+                void* vertices = nullptr; // 정점 데이터를 쓸 곳입니다. 이 프레임 동안 쓰기만 가능합니다.
+                void* indices = nullptr; // 인덱스 데이터를 쓸 곳입니다. 인덱스를 요청하지 않았으면 nullptr입니다.
+                uint32_t vertexCount = 0, indexCount = 0;
+                uint32_t vertexSize = 0;
+                uint64_t vertexOffset = 0, indexOffset = 0; // 스트리밍 버퍼 안의 위치(바이트)
+                uint32_t frame = 0;
+                bool use32 = false;
+                inline operator bool() const { return vertices != nullptr; }
+            };
+            /// @brief 프레임마다 비워지는 스트리밍 버퍼에서 정점/인덱스 공간을 할당합니다. 버퍼는 호스트에서 보이는 메모리에 항상 매핑되어 있으므로 스테이징이나 메시 생성 없이 바로 쓰고 RenderPass::invoke(const StreamGeometry&)로 그릴 수 있습니다.
+            /// 프레임당 용량을 넘으면 빈 객체를 리턴하며, 다음 프레임부터 그만큼 용량이 늘어납니다.
+            /// @param singleIndexSize 2 또는 4
+            static StreamGeometry allocateStreamGeometry(uint32_t vertexCount, uint32_t singleVertexSize, uint32_t indexCount = 0, uint32_t singleIndexSize = 2);
             /// @brief 만들어 둔 렌더패스를 리턴합니다. 없으면 nullptr를 리턴합니다.
             static pRenderPass2Screen getRenderPass2Screen(int32_t key);
             /// @brief 만들어 둔 렌더패스를 리턴합니다. 없으면 nullptr를 리턴합니다.
@@ -305,6 +321,10 @@ namespace onart {
             VkResult qSubmit(const VkPresentInfoKHR* present);
             /// @brief vulkan 객체를 없앱니다.
             void free();
+            /// @brief 스트리밍 버퍼의 다음 프레임 영역으로 넘어갑니다. 이번 프레임 영역은 지금까지 제출된 명령이 끝나면 재사용됩니다.
+            void advanceStream();
+            /// @brief 스트리밍 버퍼를 (다시) 만듭니다. 기존 버퍼를 쓰는 명령이 모두 끝날 때까지 기다립니다.
+            bool createStreamBuffer(uint64_t capacity);
         private:
             static RenderTarget* createRenderTarget2D(int width, int height, RenderTargetType type, bool useDepthInput, bool sampled, bool linear, bool canRead);
             static VkPipelineLayout createPipelineLayout(const PipelineLayoutOptions& options);
@@ -414,6 +434,18 @@ namespace onart {
             std::set<ImageSet*> images;
             std::vector<std::shared_ptr<RenderPass>> passes;
             VmaAllocator allocator = nullptr;
+            constexpr static uint32_t STREAM_FRAMES = 3;
+            struct {
+                VkBuffer buffer = VK_NULL_HANDLE;
+                VmaAllocation alloc = nullptr;
+                uint8_t* mapped = nullptr;
+                VkFence fences[STREAM_FRAMES] = {};
+                bool pending[STREAM_FRAMES] = {}; // 해당 영역을 읽는 명령이 끝났는지 아직 모름
+                uint64_t capacity = 0; // 프레임 1개 영역의 크기
+                uint64_t used = 0;
+                uint64_t demand = 0; // 이번 프레임에 요청된 양. 할당에 실패한 것도 포함
+                uint32_t frame = 0;
+            } stream;
             enum vkm_strand { 
                 NONE = 0,
                 GENERAL = 1,
@@ -581,6 +613,14 @@ namespace onart {
             /// @param start 정점 시작 위치 (주어진 메시에 인덱스 버퍼가 있는 경우 그것을 기준으로 합니다.)
             /// @param count 정점 수. 0이 주어진 경우 주어진 start부터 끝까지 그립니다.
             void invoke(const pMesh& mesh, const pMesh& instanceInfo, uint32_t instanceCount, uint32_t istart = 0, uint32_t start = 0, uint32_t count = 0);
+            /// @brief allocateStreamGeometry()로 할당하여 채운 기하를 그립니다. 정점 사양은 파이프라인과 맞아야 하며, 할당한 프레임에만 사용할 수 있습니다.
+            /// @param start 정점 시작 위치 (인덱스를 할당한 경우 그것을 기준으로 합니다.)
+            /// @param count 정점 수. 0이 주어진 경우 주어진 start부터 끝까지 그립니다.
+            void invoke(const StreamGeometry& geometry, uint32_t start = 0, uint32_t count = 0);
+            /// @brief 인스턴스 속성을 allocateStreamGeometry()로 할당한 기하에서 읽어 메시를 그립니다. 매 프레임 CPU에서 새로 만드는 인스턴스 데이터를 메시 갱신 없이 그리는 데 사용합니다.
+            /// @param instanceInfo 인스턴스 속성만 담은 기하. 인덱스는 사용하지 않으며, 할당한 프레임에만 사용할 수 있습니다.
+            /// @param istart instanceInfo 안의 인스턴스 시작 위치
+            void invoke(const pMesh& mesh, const StreamGeometry& instanceInfo, uint32_t instanceCount, uint32_t istart = 0);
             /// @brief 서브패스를 시작합니다. 이미 서브패스가 시작된 상태라면 다음 서브패스를 시작하며, 다음 것이 없으면 아무 동작도 하지 않습니다. 주어진 파이프라인이 없으면 동작이 실패합니다.
             /// @param pos 이전 서브패스의 결과인 입력 첨부물을 바인드할 위치의 시작점입니다. 예를 들어, pos=0이고 이전 타겟이 색 첨부물 2개, 깊이 첨부물 1개였으면 0, 1, 2번에 바인드됩니다. 셰이더를 그에 맞게 만들어야 합니다.
             void start(uint32_t pos = 0, bool waitOnZero = true);
@@ -610,6 +650,9 @@ namespace onart {
             /// @param key 핸들러에 전달될 키입니다.
             /// @param handler 비동기 핸들러입니다. @ref ReadBackBuffer의 포인터가 전달되며 해당 메모리는 자동으로 해제되므로 핸들러에서는 읽기만 가능합니다.
             void asyncReadBack(int32_t key, uint32_t index, std::function<void(variant8)> handler, const TextureArea2D& area = {});
+            /// @brief 이 렌더패스를 한 프레임에 여러 번 서로 다른 내용으로 그리는지(타겟 공유) 설정합니다. 참이면 패스를 시작할 때마다, 앞서 이 타겟을 샘플링한 프래그먼트 셰이더가 끝난 뒤 쓰도록 배리어를 기록합니다.
+            /// 공유하지 않는 패스는 렌더패스의 기본 외부 의존성만 사용합니다.
+            inline void setShared(bool shared) { this->shared = shared; }
         private:
             void reconstructFB(RenderTarget** targets);
             VkCommandBuffer& getCommandBuffer();
@@ -628,6 +671,7 @@ namespace onart {
             const Mesh* bound = nullptr;
             const bool canBeRead;
             bool autoclear;
+            bool shared = false;
             float clearColor[4];
         protected:
             RenderPass(VkRenderPass rp, VkFramebuffer fb, uint16_t stageCount, bool canBeRead, float* autoclear); // 이후 다수의 서브패스를 쓸 수 있도록 변경
@@ -777,6 +821,14 @@ namespace onart {
             /// @param instanceInfo 
             /// @param instanceCount 
             void invoke(const pMesh& mesh, const pMesh& instanceInfo, uint32_t instanceCount, uint32_t istart = 0, uint32_t start = 0, uint32_t count = 0);
+            /// @brief allocateStreamGeometry()로 할당하여 채운 기하를 그립니다. 정점 사양은 파이프라인과 맞아야 하며, 할당한 프레임에만 사용할 수 있습니다.
+            /// @param start 정점 시작 위치 (인덱스를 할당한 경우 그것을 기준으로 합니다.)
+            /// @param count 정점 수. 0이 주어진 경우 주어진 start부터 끝까지 그립니다.
+            void invoke(const StreamGeometry& geometry, uint32_t start = 0, uint32_t count = 0);
+            /// @brief 인스턴스 속성을 allocateStreamGeometry()로 할당한 기하에서 읽어 메시를 그립니다. 매 프레임 CPU에서 새로 만드는 인스턴스 데이터를 메시 갱신 없이 그리는 데 사용합니다.
+            /// @param instanceInfo 인스턴스 속성만 담은 기하. 인덱스는 사용하지 않으며, 할당한 프레임에만 사용할 수 있습니다.
+            /// @param istart instanceInfo 안의 인스턴스 시작 위치
+            void invoke(const pMesh& mesh, const StreamGeometry& instanceInfo, uint32_t instanceCount, uint32_t istart = 0);
             /// @brief 현재 서브패스의 타겟을 클리어합니다.
             /// @param toClear 실제로 클리어할 타겟을 명시합니다.
             /// @param colors 초기화할 색상을 앞에서부터 차례대로 (r, g, b, a) 명시합니다. depth/stencil 타겟은 각각 고정 1 / 0으로 클리어됩니다.
@@ -943,6 +995,8 @@ namespace onart {
             uint16_t getIndex();
             /// @brief 파이프라인을 정의하기 위한 레이아웃을 가져옵니다.
             inline VkDescriptorSetLayout getLayout() { return layout; }
+            /// @brief 동적 유니폼 버퍼의 항목 간격(바이트)을 리턴합니다.
+            inline uint32_t getStride() const { return individual; }
         private:
             inline uint32_t offset(uint32_t index) { return individual * index; }
             /// @brief 임시로 저장되어 있던 내용을 모두 GPU로 올립니다.
@@ -20,8 +20,8 @@ void android_main(struct android_app* app) {
     Game game;
     IntermediateScene* scn{};
     FinalScene* fscn{};
-    pVisualElement ve, ve2;
-    game.setInit([&scn, &fscn, &ve, &ve2]() {
+    VisualElementHandle veh, veh2;
+    game.setInit([&scn, &fscn, &veh, &veh2]() {
         RenderPassCreationOptions opts;
         opts.width = 400;
         opts.height = 300;
@@ -30,8 +30,8 @@ void android_main(struct android_app* app) {
         scn = new IntermediateScene(opts);
         fscn = new FinalScene(YRGraphics::createRenderPass2Screen(0, 0, {}));
         fscn->addPred(scn);
-        ve = VisualElement::create();
-        fscn->insert(ve);
+        veh = fscn->insert();
+        VisualElement* ve = fscn->get(veh);
         ve->pipeline = get2DDefaultPipeline();
         ve->instanceCount = 1;
         ve->rtTexture = scn->getRenderpass();
@@ -65,8 +65,8 @@ void android_main(struct android_app* app) {
         var = vec4(1, 1, 1, 1);
         std::memcpy(ve->pushed.data() + 80, &var, 16);
 
-        ve2 = VisualElement::create();
-        scn->insert(ve2);
+        veh2 = scn->insert();
+        VisualElement* ve2 = scn->get(veh2);
         ve2->pipeline = get2DInstancedPipeline();
         ve2->instanceCount = 1;
         ve2->mesh0 = ve->mesh0;
@@ -6,7 +6,7 @@
 using namespace onart;
 
 FinalScene* fscn{};
-pVisualElement ve;
+VisualElementHandle veh;
 
 int main(){
   Game game;
@@ -21,8 +21,8 @@ int main(){
         scn = new IntermediateScene(opts);
         fscn = new FinalScene(YRGraphics::createRenderPass2Screen(0, 0, {}));
         //fscn->addPred(scn);
-        ve = VisualElement::create();
-        fscn->insert(ve);
+        veh = fscn->insert();
+        VisualElement* ve = fscn->get(veh);
         ve->pipeline = get2DDefaultPipeline();
         ve->instanceCount = 1;
         ve->texture = YRGraphics::createTexture(INT32_MIN, TEX0, sizeof(TEX0), {});
@@ -1115,13 +1115,22 @@ namespace onart
     WGLMachine::pUniformBuffer WGLMachine::createUniformBuffer(int32_t key, const UniformBufferCreationOptions& opts) {
         if (pUniformBuffer ret = getUniformBuffer(key)) { return ret; }
 
+        uint32_t individual = 0;
+        size_t length = opts.size;
+        if (opts.count > 1) {
+            GLint alignment = 256;
+            glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+            individual = (uint32_t)((opts.size + alignment - 1) / alignment * alignment);
+            length = (size_t)individual * opts.count;
+        }
+
         unsigned ubo;
         glGenBuffers(1, &ubo);
         glBindBuffer(GL_UNIFORM_BUFFER, ubo);
-        glBufferData(GL_UNIFORM_BUFFER, opts.size, nullptr, GL_DYNAMIC_DRAW);
+        glBufferData(GL_UNIFORM_BUFFER, length, nullptr, GL_DYNAMIC_DRAW);
         glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
-        pUniformBuffer ret = std::make_shared<shp_t<UniformBuffer>>(opts.size, ubo);
+        pUniformBuffer ret = std::make_shared<shp_t<UniformBuffer>>(length, ubo, individual);
         if(key == INT32_MIN) return ret;
         return singleton->uniformBuffers[key] = std::move(ret);
     }
@@ -1498,7 +1507,8 @@ namespace onart
             LOGWITH("Invalid call: render pass not begun");
             return;
         }
-        glBindBufferRange(GL_UNIFORM_BUFFER, pos, ub->ubo, 0, ub->length);
+        if (ub->individual) { glBindBufferRange(GL_UNIFORM_BUFFER, pos, ub->ubo, (GLintptr)ub->individual * ubPos, ub->individual); }
+        else { glBindBufferRange(GL_UNIFORM_BUFFER, pos, ub->ubo, 0, ub->length); }
     }
 
     void WGLMachine::RenderPass::bind(uint32_t pos, const pTexture& tx) {
@@ -1679,19 +1689,25 @@ namespace onart
              for (; location < p->vspec.size(); location++) {
                  enableAttribute(p->vertexSize, p->vspec[location]);
              }
-             if (instanceInfo) {
-                 glBindBuffer(GL_ARRAY_BUFFER, instanceInfo->vb);
-                 uint32_t iloc = 0;
-                 for (; iloc < p->ispec.size(); iloc++, location++) {
-                     enableAttribute(p->instanceAttrStride, p->ispec[iloc]);
-                     glVertexAttribDivisor(location, 1);
-                 }
-             }
              glBindVertexArray(0);
              glBindBuffer(GL_ARRAY_BUFFER, 0);
              glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
          }
          glBindVertexArray(mesh->vao);
+         if (instanceInfo) {
+             // WebGL 2에는 base instance 그리기가 없으므로 인스턴스 속성의 시작 위치를 istart만큼 옮겨 흉내냄
+             // 인스턴스 버퍼는 호출마다 다를 수 있으므로 VAO에 고정하지 않고 매번 다시 지정함
+             Pipeline* p = pipelines[currentPass];
+             glBindBuffer(GL_ARRAY_BUFFER, instanceInfo->vb);
+             uint32_t location = (uint32_t)p->vspec.size();
+             for (uint32_t iloc = 0; iloc < p->ispec.size(); iloc++, location++) {
+                 PipelineInputVertexSpec spec = p->ispec[iloc];
+                 spec.offset += (int)(istart * p->instanceAttrStride);
+                 enableAttribute(p->instanceAttrStride, spec);
+                 glVertexAttribDivisor(location, 1);
+             }
+             glBindBuffer(GL_ARRAY_BUFFER, 0);
+         }
          if(mesh->icount) {
              if((uint64_t)start + count > mesh->icount){
                  LOGWITH("Invalid call: this mesh has",mesh->icount,"indices but",start,"~",(uint64_t)start+count,"requested to be drawn");
@@ -1701,7 +1717,7 @@ namespace onart
              if(count == 0){
                  count = uint32_t(mesh->icount - start);
              }
-             glDrawElementsInstanced(GL_TRIANGLES, mesh->icount, mesh->idxType, mesh->idxType == GL_UNSIGNED_INT ? (void*)((uint32_t*)0 + start) : (void*)((uint16_t*)0 + start), instanceCount);
+             glDrawElementsInstanced(GL_TRIANGLES, count, mesh->idxType, mesh->idxType == GL_UNSIGNED_INT ? (void*)((uint32_t*)0 + start) : (void*)((uint16_t*)0 + start), instanceCount);
          }
          else {
              if((uint64_t)start + count > mesh->vcount){
@@ -2241,8 +2257,13 @@ namespace onart
     }
 
     void WGLMachine::UniformBuffer::update(const void* input, uint32_t index, uint32_t offset, uint32_t size){
+        uint64_t begin = (uint64_t)individual * index + offset;
+        if (begin + size > length) {
+            LOGWITH("Requested buffer update range is invalid");
+            return;
+        }
         glBindBuffer(GL_UNIFORM_BUFFER, ubo);
-        glBufferSubData(GL_UNIFORM_BUFFER, offset, size, input);
+        glBufferSubData(GL_UNIFORM_BUFFER, (GLintptr)begin, size, input);
         glBindBuffer(GL_UNIFORM_BUFFER, 0);
     }
 
@@ -2252,7 +2273,7 @@ namespace onart
 
     void WGLMachine::UniformBuffer::resize(uint32_t size) {    }
 
-    WGLMachine::UniformBuffer::UniformBuffer(uint32_t length, unsigned ubo) :ubo(ubo), length(length) {}
+    WGLMachine::UniformBuffer::UniformBuffer(uint32_t length, unsigned ubo, uint32_t individual) :ubo(ubo), length(length), individual(individual) {}
 
     WGLMachine::UniformBuffer::~UniformBuffer(){
         glDeleteBuffers(1, &ubo);
@@ -638,10 +638,12 @@ namespace onart {
             void resize(uint32_t size);
             /// @brief 유니폼 버퍼의 내용을 갱신합니다. 넘치게 데이터를 줘도 추가 할당은 하지 않으므로 주의하세요.
             /// @param input 입력 데이터
-            /// @param index 사용되지 않습니다.
-            /// @param offset 데이터 내에서 몇 바이트째부터 수정할지
-            /// @param size 덮어쓸 양
+            /// @param index 동적 유니폼 버퍼인 경우 갱신할 항목 번호입니다. 동적 유니폼 버퍼가 아니면 사용되지 않습니다.
+            /// @param offset 데이터 내에서 몇 바이트째부터 수정할지 (index번째 항목의 시작 기준)
+            /// @param size 덮어쓸 양. 여러 항목에 걸쳐도 되므로 여러 항목을 한 번에 갱신할 수 있습니다.
             void update(const void* input, uint32_t index, uint32_t offset, uint32_t size);
+            /// @brief 동적 유니폼 버퍼의 항목 간격(바이트)을 리턴합니다. 동적 유니폼 버퍼가 아니면 0을 리턴합니다.
+            inline uint32_t getStride() const { return individual; }
             /// @brief 0을 리턴합니다.
             uint16_t getIndex();
             /// @brief 0을 리턴합니다.
@@ -649,12 +651,13 @@ namespace onart {
             /// @brief 128바이트 크기의 고정 유니폼버퍼를 업데이트합니다. 이것은 모든 파이프라인이 공유하며, 셰이더의 바인딩 11번으로 접근할 수 있습니다.
             static void updatePush(const void* input, uint32_t offset, uint32_t size);
         protected:
-            UniformBuffer(uint32_t length, unsigned ubo);
+            UniformBuffer(uint32_t length, unsigned ubo, uint32_t individual = 0);
             ~UniformBuffer();
         private:
             unsigned ubo;
             bool shouldSync = false;
             uint32_t length;
+            uint32_t individual; // 동적 유니폼 버퍼 항목 간격 (동적이 아니면 0)
     };
 
     template<class FATTR, class... ATTR>
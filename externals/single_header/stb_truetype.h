@@ -0,0 +1,819 @@
+// stb_truetype.h - reduced - public domain
+//
+// A reduced TrueType font loader and rasterizer exposing a subset of the API of
+// Sean Barrett's stb_truetype (http://nothings.org/stb). The function names and
+// signatures below match upstream, so the full upstream header can be dropped in
+// over this file without touching any caller.
+//
+// Supported:
+//    - TrueType outlines ('glyf'), simple and composite glyphs
+//    - cmap subtable formats 0, 4, 6, 12, 13
+//    - horizontal metrics ('hhea', 'hmtx') and pair kerning ('kern' format 0)
+//    - font collections (.ttc)
+//    - anti-aliased 8-bit coverage rendering (signed area accumulation)
+// Not supported (upstream has them):
+//    - CFF outlines (.otf with 'CFF ' instead of 'glyf'): stbtt_InitFont fails
+//    - GPOS kerning, SDF/packing/baked-char helpers, subpixel shift, oversampling
+//
+// USAGE
+//    #define STB_TRUETYPE_IMPLEMENTATION
+// in exactly one C or C++ file before including this file.
+//
+// Memory is allocated through STBTT_malloc(size, userdata) / STBTT_free(ptr, userdata),
+// which default to malloc/free.
+//
+// LICENSE
+//    This software is dual-licensed to the public domain and under the MIT license,
+//    following upstream stb_truetype. Choose whichever you prefer.
+
+#ifndef __STB_INCLUDE_STB_TRUETYPE_H__
+#define __STB_INCLUDE_STB_TRUETYPE_H__
+
+#ifdef STBTT_STATIC
+#define STBTT_DEF static
+#else
+#define STBTT_DEF extern
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct stbtt_fontinfo
+{
+   void           * userdata;
+   unsigned char  * data;              // pointer to .ttf file
+   int              fontstart;         // offset of start of font
+
+   int numGlyphs;                      // number of glyphs, needed for range checking
+
+   int loca,head,glyf,hhea,hmtx,kern;  // table locations as offset from start of .ttf
+   int index_map;                      // a cmap mapping for our chosen character encoding
+   int indexToLocFormat;               // format needed to map from glyph index to glyph
+} stbtt_fontinfo;
+
+enum {
+   STBTT_vmove=1,
+   STBTT_vline,
+   STBTT_vcurve
+};
+
+#ifndef stbtt_vertex
+#define stbtt_vertex_type short
+typedef struct
+{
+   stbtt_vertex_type x,y,cx,cy;
+   unsigned char type,padding;
+} stbtt_vertex;
+#endif
+
+// Each .ttf/.ttc file may have more than one font. Each font has a sequential
+// index number starting from 0. Returns the offset of the font, or -1 if the
+// index is out of range.
+STBTT_DEF int stbtt_GetFontOffsetForIndex(const unsigned char *data, int index);
+
+// Given an offset into the file that defines a font, this function builds the
+// necessary cached info for the rest of the system. Returns 0 on failure.
+STBTT_DEF int stbtt_InitFont(stbtt_fontinfo *info, const unsigned char *data, int offset);
+
+// Returns the glyph index for the unicode codepoint, or 0 if the font has none.
+STBTT_DEF int stbtt_FindGlyphIndex(const stbtt_fontinfo *info, int unicode_codepoint);
+
+// Scale factor that makes the distance from the highest ascender to the lowest
+// descender equal to 'pixels'.
+STBTT_DEF float stbtt_ScaleForPixelHeight(const stbtt_fontinfo *info, float pixels);
+
+// ascent/descent/lineGap in unscaled units ('hhea').
+STBTT_DEF void stbtt_GetFontVMetrics(const stbtt_fontinfo *info, int *ascent, int *descent, int *lineGap);
+
+STBTT_DEF void stbtt_GetGlyphHMetrics(const stbtt_fontinfo *info, int glyph_index, int *advanceWidth, int *leftSideBearing);
+STBTT_DEF int  stbtt_GetGlyphKernAdvance(const stbtt_fontinfo *info, int glyph1, int glyph2);
+STBTT_DEF int  stbtt_GetCodepointKernAdvance(const stbtt_fontinfo *info, int ch1, int ch2);
+
+// Unscaled bounding box of the glyph. Returns 0 if the glyph has no outline.
+STBTT_DEF int stbtt_GetGlyphBox(const stbtt_fontinfo *info, int glyph_index, int *x0, int *y0, int *x1, int *y1);
+
+// Returns the number of vertices and fills *vertices with an array to be freed by stbtt_FreeShape.
+STBTT_DEF int  stbtt_GetGlyphShape(const stbtt_fontinfo *info, int glyph_index, stbtt_vertex **vertices);
+STBTT_DEF void stbtt_FreeShape(const stbtt_fontinfo *info, stbtt_vertex *vertices);
+
+// Pixel bounding box of the glyph bitmap; y grows downward, so y0 is usually negative.
+STBTT_DEF void stbtt_GetGlyphBitmapBox(const stbtt_fontinfo *font, int glyph, float scale_x, float scale_y, int *ix0, int *iy0, int *ix1, int *iy1);
+
+// Renders the glyph into output (out_w x out_h, row stride out_stride). The bitmap is
+// placed so that its top-left corner matches (ix0, iy0) of stbtt_GetGlyphBitmapBox.
+STBTT_DEF void stbtt_MakeGlyphBitmap(const stbtt_fontinfo *info, unsigned char *output, int out_w, int out_h, int out_stride, float scale_x, float scale_y, int glyph);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __STB_INCLUDE_STB_TRUETYPE_H__
+
+#ifdef STB_TRUETYPE_IMPLEMENTATION
+
+#ifndef STBTT_malloc
+#include <stdlib.h>
+#define STBTT_malloc(x,u)  ((void)(u),malloc(x))
+#define STBTT_free(x,u)    ((void)(u),free(x))
+#endif
+
+#ifndef STBTT_memcpy
+#include <string.h>
+#define STBTT_memcpy       memcpy
+#define STBTT_memset       memset
+#endif
+
+#ifndef STBTT_ifloor
+#include <math.h>
+#define STBTT_ifloor(x)    ((int) floor(x))
+#define STBTT_iceil(x)     ((int) ceil(x))
+#define STBTT_sqrt(x)      sqrt(x)
+#define STBTT_fabs(x)      fabs(x)
+#endif
+
+#ifndef STBTT_assert
+#include <assert.h>
+#define STBTT_assert(x)    assert(x)
+#endif
+
+typedef unsigned char  stbtt_uint8;
+typedef signed   char  stbtt_int8;
+typedef unsigned short stbtt_uint16;
+typedef signed   short stbtt_int16;
+typedef unsigned int   stbtt_uint32;
+typedef signed   int   stbtt_int32;
+
+#define ttBYTE(p)     (* (stbtt_uint8 *) (p))
+#define ttCHAR(p)     (* (stbtt_int8 *) (p))
+
+static stbtt_uint16 ttUSHORT(const stbtt_uint8 *p) { return p[0]*256 + p[1]; }
+static stbtt_int16  ttSHORT(const stbtt_uint8 *p)  { return (stbtt_int16)(p[0]*256 + p[1]); }
+static stbtt_uint32 ttULONG(const stbtt_uint8 *p)  { return ((stbtt_uint32)p[0]<<24) + (p[1]<<16) + (p[2]<<8) + p[3]; }
+static stbtt_int32  ttLONG(const stbtt_uint8 *p)   { return (stbtt_int32)ttULONG(p); }
+
+#define stbtt_tag4(p,c0,c1,c2,c3) ((p)[0] == (c0) && (p)[1] == (c1) && (p)[2] == (c2) && (p)[3] == (c3))
+#define stbtt_tag(p,str)           stbtt_tag4(p,str[0],str[1],str[2],str[3])
+
+static int stbtt__isfont(const stbtt_uint8 *font)
+{
+   if (stbtt_tag4(font, '1',0,0,0))  return 1; // TrueType 1
+   if (stbtt_tag(font, "typ1"))      return 1; // TrueType with type 1 font
+   if (stbtt_tag(font, "OTTO"))      return 1; // OpenType with CFF
+   if (stbtt_tag4(font, 0,1,0,0))    return 1; // OpenType 1.0
+   if (stbtt_tag(font, "true"))      return 1; // Apple specification for TrueType fonts
+   return 0;
+}
+
+static stbtt_uint32 stbtt__find_table(const stbtt_uint8 *data, stbtt_uint32 fontstart, const char *tag)
+{
+   stbtt_int32 num_tables = ttUSHORT(data+fontstart+4);
+   stbtt_uint32 tabledir = fontstart + 12;
+   stbtt_int32 i;
+   for (i=0; i < num_tables; ++i) {
+      stbtt_uint32 loc = tabledir + 16*i;
+      if (stbtt_tag(data+loc+0, tag))
+         return ttULONG(data+loc+8);
+   }
+   return 0;
+}
+
+STBTT_DEF int stbtt_GetFontOffsetForIndex(const unsigned char *font_collection, int index)
+{
+   if (stbtt__isfont(font_collection))
+      return index == 0 ? 0 : -1;
+   if (stbtt_tag(font_collection, "ttcf")) {
+      if (ttULONG(font_collection+4) == 0x00010000 || ttULONG(font_collection+4) == 0x00020000) {
+         stbtt_int32 n = ttLONG(font_collection+8);
+         if (index < 0 || index >= n)
+            return -1;
+         return ttULONG(font_collection+12+index*4);
+      }
+   }
+   return -1;
+}
+
+STBTT_DEF int stbtt_InitFont(stbtt_fontinfo *info, const unsigned char *data, int fontstart)
+{
+   stbtt_uint32 cmap, t;
+   stbtt_int32 i, numTables;
+   int best = -1;
+
+   info->data = (unsigned char *) data;
+   info->fontstart = fontstart;
+
+   cmap = stbtt__find_table(info->data, fontstart, "cmap");
+   info->loca = stbtt__find_table(info->data, fontstart, "loca");
+   info->head = stbtt__find_table(info->data, fontstart, "head");
+   info->glyf = stbtt__find_table(info->data, fontstart, "glyf");
+   info->hhea = stbtt__find_table(info->data, fontstart, "hhea");
+   info->hmtx = stbtt__find_table(info->data, fontstart, "hmtx");
+   info->kern = stbtt__find_table(info->data, fontstart, "kern");
+
+   if (!cmap || !info->head || !info->hhea || !info->hmtx)
+      return 0;
+   if (!info->glyf || !info->loca)
+      return 0; // CFF outlines are not supported by this reduced version
+
+   t = stbtt__find_table(info->data, fontstart, "maxp");
+   info->numGlyphs = t ? ttUSHORT(info->data+t+4) : 0xffff;
+
+   // prefer a full unicode subtable, then a BMP one
+   info->index_map = 0;
+   numTables = ttUSHORT(info->data + cmap + 2);
+   for (i=0; i < numTables; ++i) {
+      stbtt_uint32 encoding_record = cmap + 4 + 8 * i;
+      int platform = ttUSHORT(info->data+encoding_record);
+      int encoding = ttUSHORT(info->data+encoding_record+2);
+      int rank = -1;
+      if (platform == 3) { // Microsoft
+         if (encoding == 10) rank = 3;      // UCS-4
+         else if (encoding == 1) rank = 2;  // UCS-2
+      } else if (platform == 0) { // Unicode
+         rank = (encoding == 4 || encoding == 6) ? 3 : 1;
+      }
+      if (rank > best) {
+         best = rank;
+         info->index_map = cmap + ttULONG(info->data+encoding_record+4);
+      }
+   }
+   if (info->index_map == 0)
+      return 0;
+
+   info->indexToLocFormat = ttUSHORT(info->data+info->head + 50);
+   return 1;
+}
+
+STBTT_DEF int stbtt_FindGlyphIndex(const stbtt_fontinfo *info, int unicode_codepoint)
+{
+   stbtt_uint8 *data = info->data;
+   stbtt_uint32 index_map = info->index_map;
+
+   stbtt_uint16 format = ttUSHORT(data + index_map + 0);
+   if (format == 0) { // apple byte encoding
+      stbtt_int32 bytes = ttUSHORT(data + index_map + 2);
+      if (unicode_codepoint >= 0 && unicode_codepoint < bytes-6)
+         return ttBYTE(data + index_map + 6 + unicode_codepoint);
+      return 0;
+   } else if (format == 6) {
+      stbtt_uint32 first = ttUSHORT(data + index_map + 6);
+      stbtt_uint32 count = ttUSHORT(data + index_map + 8);
+      if ((stbtt_uint32) unicode_codepoint >= first && (stbtt_uint32) unicode_codepoint < first+count)
+         return ttUSHORT(data + index_map + 10 + (unicode_codepoint - first)*2);
+      return 0;
+   } else if (format == 4) { // standard mapping for windows fonts: binary search collection of ranges
+      stbtt_uint16 segcount = ttUSHORT(data+index_map+6) >> 1;
+      stbtt_uint32 endCount = index_map + 14;
+      stbtt_uint32 startCount = endCount + segcount*2 + 2;
+      stbtt_uint32 idDelta = startCount + segcount*2;
+      stbtt_uint32 idRangeOffset = idDelta + segcount*2;
+      stbtt_int32 lo = 0, hi = (stbtt_int32)segcount - 1;
+
+      if (unicode_codepoint < 0 || unicode_codepoint > 0xffff)
+         return 0;
+
+      while (lo <= hi) {
+         stbtt_int32 mid = (lo + hi) >> 1;
+         stbtt_uint16 end = ttUSHORT(data + endCount + 2*mid);
+         stbtt_uint16 start = ttUSHORT(data + startCount + 2*mid);
+         if (unicode_codepoint > end) {
+            lo = mid + 1;
+         } else if (unicode_codepoint < start) {
+            hi = mid - 1;
+         } else {
+            stbtt_uint16 offset = ttUSHORT(data + idRangeOffset + 2*mid);
+            stbtt_uint16 glyph;
+            if (offset == 0)
+               return (stbtt_uint16) (unicode_codepoint + ttSHORT(data + idDelta + 2*mid));
+            glyph = ttUSHORT(data + offset + (unicode_codepoint-start)*2 + idRangeOffset + 2*mid);
+            if (glyph == 0)
+               return 0;
+            return (stbtt_uint16) (glyph + ttSHORT(data + idDelta + 2*mid));
+         }
+      }
+      return 0;
+   } else if (format == 12 || format == 13) {
+      stbtt_uint32 ngroups = ttULONG(data+index_map+12);
+      stbtt_int32 low = 0, high = (stbtt_int32)ngroups - 1;
+      // binary search the right group
+      while (low <= high) {
+         stbtt_int32 mid = low + ((high-low) >> 1);
+         stbtt_uint32 start_char = ttULONG(data+index_map+16+mid*12);
+         stbtt_uint32 end_char = ttULONG(data+index_map+16+mid*12+4);
+         if ((stbtt_uint32) unicode_codepoint < start_char)
+            high = mid - 1;
+         else if ((stbtt_uint32) unicode_codepoint > end_char)
+            low = mid + 1;
+         else {
+            stbtt_uint32 start_glyph = ttULONG(data+index_map+16+mid*12+8);
+            if (format == 12)
+               return start_glyph + unicode_codepoint - start_char;
+            else // format == 13
+               return start_glyph;
+         }
+      }
+      return 0;
+   }
+   return 0;
+}
+
+static int stbtt__GetGlyfOffset(const stbtt_fontinfo *info, int glyph_index)
+{
+   int g1,g2;
+
+   if (glyph_index < 0 || glyph_index >= info->numGlyphs) return -1; // glyph index out of range
+   if (info->indexToLocFormat >= 2)    return -1; // unknown index->glyph map format
+
+   if (info->indexToLocFormat == 0) {
+      g1 = info->glyf + ttUSHORT(info->data + info->loca + glyph_index * 2) * 2;
+      g2 = info->glyf + ttUSHORT(info->data + info->loca + glyph_index * 2 + 2) * 2;
+   } else {
+      g1 = info->glyf + ttULONG (info->data + info->loca + glyph_index * 4);
+      g2 = info->glyf + ttULONG (info->data + info->loca + glyph_index * 4 + 4);
+   }
+
+   return g1==g2 ? -1 : g1; // if length is 0, return -1
+}
+
+STBTT_DEF int stbtt_GetGlyphBox(const stbtt_fontinfo *info, int glyph_index, int *x0, int *y0, int *x1, int *y1)
+{
+   int g = stbtt__GetGlyfOffset(info, glyph_index);
+   if (g < 0) return 0;
+
+   if (x0) *x0 = ttSHORT(info->data + g + 2);
+   if (y0) *y0 = ttSHORT(info->data + g + 4);
+   if (x1) *x1 = ttSHORT(info->data + g + 6);
+   if (y1) *y1 = ttSHORT(info->data + g + 8);
+   return 1;
+}
+
+static void stbtt_setvertex(stbtt_vertex *v, stbtt_uint8 type, stbtt_int32 x, stbtt_int32 y, stbtt_int32 cx, stbtt_int32 cy)
+{
+   v->type = type;
+   v->x = (stbtt_int16) x;
+   v->y = (stbtt_int16) y;
+   v->cx = (stbtt_int16) cx;
+   v->cy = (stbtt_int16) cy;
+}
+
+static int stbtt__close_shape(stbtt_vertex *vertices, int num_vertices, int was_off, int start_off,
+    stbtt_int32 sx, stbtt_int32 sy, stbtt_int32 scx, stbtt_int32 scy, stbtt_int32 cx, stbtt_int32 cy)
+{
+   if (start_off) {
+      if (was_off)
+         stbtt_setvertex(&vertices[num_vertices++], STBTT_vcurve, (cx+scx)>>1, (cy+scy)>>1, cx,cy);
+      stbtt_setvertex(&vertices[num_vertices++], STBTT_vcurve, sx,sy,scx,scy);
+   } else {
+      if (was_off)
+         stbtt_setvertex(&vertices[num_vertices++], STBTT_vcurve,sx,sy,cx,cy);
+      else
+         stbtt_setvertex(&vertices[num_vertices++], STBTT_vline,sx,sy,0,0);
+   }
+   return num_vertices;
+}
+
+static int stbtt__GetGlyphShapeTT(const stbtt_fontinfo *info, int glyph_index, stbtt_vertex **pvertices, int depth)
+{
+   stbtt_int16 numberOfContours;
+   stbtt_uint8 *endPtsOfContours;
+   stbtt_uint8 *data = info->data;
+   stbtt_vertex *vertices=0;
+   int num_vertices=0;
+   int g = stbtt__GetGlyfOffset(info, glyph_index);
+
+   *pvertices = NULL;
+
+   if (g < 0) return 0;
+
+   numberOfContours = ttSHORT(data + g);
+
+   if (numberOfContours > 0) {
+      stbtt_uint8 flags=0,flagcount;
+      stbtt_int32 ins, i,j=0,m,n, next_move, was_off=0, off, start_off=0;
+      stbtt_int32 x,y,cx,cy,sx,sy, scx,scy;
+      stbtt_uint8 *points;
+      endPtsOfContours = (data + g + 10);
+      ins = ttUSHORT(data + g + 10 + numberOfContours * 2);
+      points = data + g + 10 + numberOfContours * 2 + 2 + ins;
+
+      n = 1+ttUSHORT(endPtsOfContours + numberOfContours*2-2);
+
+      m = n + 2*numberOfContours;  // a loose bound on how many vertices we might need
+      vertices = (stbtt_vertex *) STBTT_malloc(m * sizeof(vertices[0]), info->userdata);
+      if (vertices == 0)
+         return 0;
+
+      next_move = 0;
+      flagcount=0;
+
+      // in first pass, we load uninterpreted data into the allocated array
+      // above, shifted to the end of the array so we won't overwrite it when
+      // we create our final data starting from the front
+
+      off = m - n; // starting offset for uninterpreted data, regardless of how m ends up being calculated
+
+      // first load flags
+      for (i=0; i < n; ++i) {
+         if (flagcount == 0) {
+            flags = *points++;
+            if (flags & 8)
+               flagcount = *points++;
+         } else
+            --flagcount;
+         vertices[off+i].type = flags;
+      }
+
+      // now load x coordinates
+      x=0;
+      for (i=0; i < n; ++i) {
+         flags = vertices[off+i].type;
+         if (flags & 2) {
+            stbtt_int16 dx = *points++;
+            x += (flags & 16) ? dx : -dx;
+         } else {
+            if (!(flags & 16)) {
+               x = x + (stbtt_int16) (points[0]*256 + points[1]);
+               points += 2;
+            }
+         }
+         vertices[off+i].x = (stbtt_int16) x;
+      }
+
+      // now load y coordinates
+      y=0;
+      for (i=0; i < n; ++i) {
+         flags = vertices[off+i].type;
+         if (flags & 4) {
+            stbtt_int16 dy = *points++;
+            y += (flags & 32) ? dy : -dy;
+         } else {
+            if (!(flags & 32)) {
+               y = y + (stbtt_int16) (points[0]*256 + points[1]);
+               points += 2;
+            }
+         }
+         vertices[off+i].y = (stbtt_int16) y;
+      }
+
+      // now convert them to our format
+      num_vertices=0;
+      sx = sy = cx = cy = scx = scy = 0;
+      for (i=0; i < n; ++i) {
+         flags = vertices[off+i].type;
+         x     = (stbtt_int16) vertices[off+i].x;
+         y     = (stbtt_int16) vertices[off+i].y;
+
+         if (next_move == i) {
+            if (i != 0)
+               num_vertices = stbtt__close_shape(vertices, num_vertices, was_off, start_off, sx,sy,scx,scy,cx,cy);
+
+            // now start the new one
+            start_off = !(flags & 1);
+            if (start_off) {
+               // if we start off with an off-curve point, then when we need to find a point on the curve
+               // where we can start, and we need to save some state for when we wraparound.
+               scx = x;
+               scy = y;
+               if (!(vertices[off+i+1].type & 1)) {
+                  // next point is also a curve point, so interpolate an on-point curve
+                  sx = (x + (stbtt_int32) vertices[off+i+1].x) >> 1;
+                  sy = (y + (stbtt_int32) vertices[off+i+1].y) >> 1;
+               } else {
+                  // otherwise just use the next point as our start point
+                  sx = (stbtt_int32) vertices[off+i+1].x;
+                  sy = (stbtt_int32) vertices[off+i+1].y;
+                  ++i; // we're using point i+1 as the starting point, so skip it
+               }
+            } else {
+               sx = x;
+               sy = y;
+            }
+            stbtt_setvertex(&vertices[num_vertices++], STBTT_vmove,sx,sy,0,0);
+            was_off = 0;
+            next_move = 1 + ttUSHORT(endPtsOfContours+j*2);
+            ++j;
+         } else {
+            if (!(flags & 1)) { // if it's a curve
+               if (was_off) // two off-curve control points in a row means interpolate an on-curve midpoint
+                  stbtt_setvertex(&vertices[num_vertices++], STBTT_vcurve, (cx+x)>>1, (cy+y)>>1, cx, cy);
+               cx = x;
+               cy = y;
+               was_off = 1;
+            } else {
+               if (was_off)
+                  stbtt_setvertex(&vertices[num_vertices++], STBTT_vcurve, x,y, cx, cy);
+               else
+                  stbtt_setvertex(&vertices[num_vertices++], STBTT_vline, x,y,0,0);
+               was_off = 0;
+            }
+         }
+      }
+      num_vertices = stbtt__close_shape(vertices, num_vertices, was_off, start_off, sx,sy,scx,scy,cx,cy);
+   } else if (numberOfContours < 0 && depth < 8) {
+      // Compound shapes.
+      int more = 1;
+      stbtt_uint8 *comp = data + g + 10;
+      num_vertices = 0;
+      vertices = 0;
+      while (more) {
+         stbtt_uint16 flags, gidx;
+         int comp_num_verts = 0, i;
+         stbtt_vertex *comp_verts = 0, *tmp = 0;
+         float mtx[6] = {1,0,0,1,0,0};
+
+         flags = ttSHORT(comp); comp+=2;
+         gidx = ttSHORT(comp); comp+=2;
+
+         if (flags & 2) { // XY values
+            if (flags & 1) { // shorts
+               mtx[4] = ttSHORT(comp); comp+=2;
+               mtx[5] = ttSHORT(comp); comp+=2;
+            } else {
+               mtx[4] = ttCHAR(comp); comp+=1;
+               mtx[5] = ttCHAR(comp); comp+=1;
+            }
+         } else {
+            // point matching is not supported; the component is placed at the origin
+            comp += (flags & 1) ? 4 : 2;
+         }
+         if (flags & (1<<3)) { // WE_HAVE_A_SCALE
+            mtx[0] = mtx[3] = ttSHORT(comp)/16384.0f; comp+=2;
+            mtx[1] = mtx[2] = 0;
+         } else if (flags & (1<<6)) { // WE_HAVE_AN_X_AND_YSCALE
+            mtx[0] = ttSHORT(comp)/16384.0f; comp+=2;
+            mtx[1] = mtx[2] = 0;
+            mtx[3] = ttSHORT(comp)/16384.0f; comp+=2;
+         } else if (flags & (1<<7)) { // WE_HAVE_A_TWO_BY_TWO
+            mtx[0] = ttSHORT(comp)/16384.0f; comp+=2;
+            mtx[1] = ttSHORT(comp)/16384.0f; comp+=2;
+            mtx[2] = ttSHORT(comp)/16384.0f; comp+=2;
+            mtx[3] = ttSHORT(comp)/16384.0f; comp+=2;
+         }
+
+         // Get indexed glyph.
+         comp_num_verts = stbtt__GetGlyphShapeTT(info, gidx, &comp_verts, depth + 1);
+         if (comp_num_verts > 0) {
+            // Transform vertices.
+            for (i = 0; i < comp_num_verts; ++i) {
+               stbtt_vertex* v = &comp_verts[i];
+               stbtt_vertex_type x,y;
+               x=v->x; y=v->y;
+               v->x = (stbtt_vertex_type)(mtx[0]*x + mtx[2]*y + mtx[4]);
+               v->y = (stbtt_vertex_type)(mtx[1]*x + mtx[3]*y + mtx[5]);
+               x=v->cx; y=v->cy;
+               v->cx = (stbtt_vertex_type)(mtx[0]*x + mtx[2]*y + mtx[4]);
+               v->cy = (stbtt_vertex_type)(mtx[1]*x + mtx[3]*y + mtx[5]);
+            }
+            // Append vertices.
+            tmp = (stbtt_vertex*)STBTT_malloc((num_vertices+comp_num_verts)*sizeof(stbtt_vertex), info->userdata);
+            if (!tmp) {
+               if (vertices) STBTT_free(vertices, info->userdata);
+               if (comp_verts) STBTT_free(comp_verts, info->userdata);
+               return 0;
+            }
+            if (num_vertices > 0 && vertices) STBTT_memcpy(tmp, vertices, num_vertices*sizeof(stbtt_vertex));
+            STBTT_memcpy(tmp+num_vertices, comp_verts, comp_num_verts*sizeof(stbtt_vertex));
+            if (vertices) STBTT_free(vertices, info->userdata);
+            vertices = tmp;
+            STBTT_free(comp_verts, info->userdata);
+            num_vertices += comp_num_verts;
+         }
+         // More components ?
+         more = flags & (1<<5);
+      }
+   }
+
+   *pvertices = vertices;
+   return num_vertices;
+}
+
+STBTT_DEF int stbtt_GetGlyphShape(const stbtt_fontinfo *info, int glyph_index, stbtt_vertex **pvertices)
+{
+   return stbtt__GetGlyphShapeTT(info, glyph_index, pvertices, 0);
+}
+
+STBTT_DEF void stbtt_FreeShape(const stbtt_fontinfo *info, stbtt_vertex *v)
+{
+   STBTT_free(v, info->userdata);
+}
+
+STBTT_DEF void stbtt_GetGlyphHMetrics(const stbtt_fontinfo *info, int glyph_index, int *advanceWidth, int *leftSideBearing)
+{
+   stbtt_uint16 numOfLongHorMetrics = ttUSHORT(info->data+info->hhea + 34);
+   if (glyph_index < numOfLongHorMetrics) {
+      if (advanceWidth)     *advanceWidth    = ttSHORT(info->data + info->hmtx + 4*glyph_index);
+      if (leftSideBearing)  *leftSideBearing = ttSHORT(info->data + info->hmtx + 4*glyph_index + 2);
+   } else {
+      if (advanceWidth)     *advanceWidth    = ttSHORT(info->data + info->hmtx + 4*(numOfLongHorMetrics-1));
+      if (leftSideBearing)  *leftSideBearing = ttSHORT(info->data + info->hmtx + 4*numOfLongHorMetrics + 2*(glyph_index - numOfLongHorMetrics));
+   }
+}
+
+STBTT_DEF int stbtt_GetGlyphKernAdvance(const stbtt_fontinfo *info, int glyph1, int glyph2)
+{
+   stbtt_uint8 *data = info->data + info->kern;
+   stbtt_uint32 needle, straw;
+   int l, r, m;
+
+   // we only look at the first table. it must be 'horizontal' and format 0.
+   if (!info->kern)
+      return 0;
+   if (ttUSHORT(data+2) < 1) // number of tables, need at least 1
+      return 0;
+   if (ttUSHORT(data+8) != 1) // horizontal flag must be set in format
+      return 0;
+
+   l = 0;
+   r = ttUSHORT(data+10) - 1;
+   needle = glyph1 << 16 | glyph2;
+   while (l <= r) {
+      m = (l + r) >> 1;
+      straw = ttULONG(data+18+(m*6)); // note: unaligned read
+      if (needle < straw)
+         r = m - 1;
+      else if (needle > straw)
+         l = m + 1;
+      else
+         return ttSHORT(data+22+(m*6));
+   }
+   return 0;
+}
+
+STBTT_DEF int stbtt_GetCodepointKernAdvance(const stbtt_fontinfo *info, int ch1, int ch2)
+{
+   if (!info->kern) // if no kerning table, don't waste time looking up both codepoint->glyphs
+      return 0;
+   return stbtt_GetGlyphKernAdvance(info, stbtt_FindGlyphIndex(info,ch1), stbtt_FindGlyphIndex(info,ch2));
+}
+
+STBTT_DEF void stbtt_GetFontVMetrics(const stbtt_fontinfo *info, int *ascent, int *descent, int *lineGap)
+{
+   if (ascent ) *ascent  = ttSHORT(info->data+info->hhea + 4);
+   if (descent) *descent = ttSHORT(info->data+info->hhea + 6);
+   if (lineGap) *lineGap = ttSHORT(info->data+info->hhea + 8);
+}
+
+STBTT_DEF float stbtt_ScaleForPixelHeight(const stbtt_fontinfo *info, float height)
+{
+   int fheight = ttSHORT(info->data + info->hhea + 4) - ttSHORT(info->data + info->hhea + 6);
+   return (float) height / fheight;
+}
+
+STBTT_DEF void stbtt_GetGlyphBitmapBox(const stbtt_fontinfo *font, int glyph, float scale_x, float scale_y, int *ix0, int *iy0, int *ix1, int *iy1)
+{
+   int x0=0,y0=0,x1,y1; // =0 suppresses compiler warning
+   if (!stbtt_GetGlyphBox(font, glyph, &x0,&y0,&x1,&y1)) {
+      // e.g. space character
+      if (ix0) *ix0 = 0;
+      if (iy0) *iy0 = 0;
+      if (ix1) *ix1 = 0;
+      if (iy1) *iy1 = 0;
+   } else {
+      // move to integral bboxes (treating pixels as little squares, what pixels get touched)?
+      if (ix0) *ix0 = STBTT_ifloor( x0 * scale_x);
+      if (iy0) *iy0 = STBTT_ifloor(-y1 * scale_y);
+      if (ix1) *ix1 = STBTT_iceil ( x1 * scale_x);
+      if (iy1) *iy1 = STBTT_iceil (-y0 * scale_y);
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+//  Rasterizer
+//
+//  Each edge adds its signed area to an accumulation buffer, one cell per pixel
+//  plus one spare column. A running sum along each row then gives the coverage.
+//  Curves are flattened first.
+
+static void stbtt__accumulate_line(float *acc, int w, int h, float x0, float y0, float x1, float y1)
+{
+   float dir = 1.0f, dxdy, x, tmp;
+   int y, ystart, yend;
+   if (y0 == y1) return;
+   if (y0 > y1) {
+      dir = -1.0f;
+      tmp = x0; x0 = x1; x1 = tmp;
+      tmp = y0; y0 = y1; y1 = tmp;
+   }
+   dxdy = (x1 - x0) / (y1 - y0);
+   x = x0;
+   if (y0 < 0) x -= y0 * dxdy;
+   ystart = y0 < 0 ? 0 : (int) y0;
+   yend = STBTT_iceil(y1);
+   if (yend > h) yend = h;
+   for (y = ystart; y < yend; ++y) {
+      float *row = acc + y * (w + 1);
+      float top = (float) y > y0 ? (float) y : y0;
+      float bottom = (float) (y + 1) < y1 ? (float) (y + 1) : y1;
+      float dy = bottom - top;
+      float xnext = x + dxdy * dy;
+      float d = dy * dir;
+      float xa = x < xnext ? x : xnext, xb = x < xnext ? xnext : x;
+      int xai, xbi;
+      if (xa < 0) xa = 0;
+      if (xb < 0) xb = 0;
+      if (xa > (float) w) xa = (float) w;
+      if (xb > (float) w) xb = (float) w;
+      xai = (int) xa;
+      xbi = STBTT_iceil(xb);
+      if (xai >= w) xai = w - 1; // an edge on the right border still lands in the spare column
+      if (xbi <= xai + 1) {
+         // the edge stays within one pixel column on this row
+         float xmf = 0.5f * (xa + xb) - (float) xai;
+         row[xai] += d - d * xmf;
+         row[xai + 1] += d * xmf;
+      } else {
+         float s = 1.0f / (xb - xa);
+         float xaf = xa - (float) xai;
+         float a0 = 0.5f * s * (1.0f - xaf) * (1.0f - xaf);
+         float xbf = xb - (float) xbi + 1.0f;
+         float am = 0.5f * s * xbf * xbf;
+         int xi;
+         row[xai] += d * a0;
+         if (xbi == xai + 2) {
+            row[xai + 1] += d * (1.0f - a0 - am);
+         } else {
+            float a1 = s * (1.5f - xaf);
+            float a2;
+            row[xai + 1] += d * (a1 - a0);
+            for (xi = xai + 2; xi < xbi - 1; ++xi)
+               row[xi] += d * s;
+            a2 = a1 + (float) (xbi - xai - 3) * s;
+            row[xbi - 1] += d * (1.0f - a2 - am);
+         }
+         row[xbi] += d * am;
+      }
+      x = xnext;
+   }
+}
+
+STBTT_DEF void stbtt_MakeGlyphBitmap(const stbtt_fontinfo *info, unsigned char *output, int out_w, int out_h, int out_stride, float scale_x, float scale_y, int glyph)
+{
+   stbtt_vertex *vertices;
+   int num_verts, ix0, iy0, i, x, y;
+   float *acc, px = 0, py = 0;
+
+   if (out_w <= 0 || out_h <= 0) return;
+   if (scale_x == 0) scale_x = scale_y;
+   if (scale_y == 0) scale_y = scale_x;
+
+   stbtt_GetGlyphBitmapBox(info, glyph, scale_x, scale_y, &ix0, &iy0, 0, 0);
+   for (y = 0; y < out_h; ++y)
+      STBTT_memset(output + y * out_stride, 0, out_w);
+
+   num_verts = stbtt_GetGlyphShape(info, glyph, &vertices);
+   if (num_verts <= 0) return;
+
+   acc = (float *) STBTT_malloc(sizeof(float) * (out_w + 1) * out_h, info->userdata);
+   if (!acc) {
+      STBTT_free(vertices, info->userdata);
+      return;
+   }
+   STBTT_memset(acc, 0, sizeof(float) * (out_w + 1) * out_h);
+
+   for (i = 0; i < num_verts; ++i) {
+      // font units (y up) to bitmap pixels (y down)
+      float vx = vertices[i].x * scale_x - ix0;
+      float vy = -vertices[i].y * scale_y - iy0;
+      if (vertices[i].type == STBTT_vline) {
+         stbtt__accumulate_line(acc, out_w, out_h, px, py, vx, vy);
+      } else if (vertices[i].type == STBTT_vcurve) {
+         float cx = vertices[i].cx * scale_x - ix0;
+         float cy = -vertices[i].cy * scale_y - iy0;
+         // with n segments the chord error of a quadratic is |p0 - 2c + p1| / (4 n^2); keep it under 0.25px
+         float ddx = px - 2 * cx + vx, ddy = py - 2 * cy + vy;
+         float dev = (float) STBTT_sqrt(ddx * ddx + ddy * ddy);
+         int n = 1 + (int) STBTT_sqrt(dev), k;
+         float lx = px, ly = py;
+         if (n > 64) n = 64;
+         for (k = 1; k <= n; ++k) {
+            float t = (float) k / n, it = 1 - t;
+            float qx = it * it * px + 2 * it * t * cx + t * t * vx;
+            float qy = it * it * py + 2 * it * t * cy + t * t * vy;
+            stbtt__accumulate_line(acc, out_w, out_h, lx, ly, qx, qy);
+            lx = qx;
+            ly = qy;
+         }
+      }
+      px = vx;
+      py = vy;
+   }
+
+   for (y = 0; y < out_h; ++y) {
+      const float *row = acc + y * (out_w + 1);
+      unsigned char *dst = output + y * out_stride;
+      float sum = 0;
+      for (x = 0; x < out_w; ++x) {
+         float c;
+         sum += row[x];
+         c = STBTT_fabs(sum);
+         if (c > 1.0f) c = 1.0f;
+         dst[x] = (unsigned char) (c * 255.0f + 0.5f);
+      }
+   }
+
+   STBTT_free(acc, info->userdata);
+   STBTT_free(vertices, info->userdata);
+}
+
+#endif // STB_TRUETYPE_IMPLEMENTATION
@@ -0,0 +1,377 @@
+#define STB_IMAGE_IMPLEMENTATION
+
+#include "../externals/single_header/stb_image.h"
+#include "../externals/vulkan/vulkan.h"
+#define KHRONOS_STATIC
+#include "../externals/ktx/ktx.h"
+#include "../YERM_PC/yr_rectpack.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/*
+인덱스 파일(<출력>.yrat) 형식. 모두 리틀 엔디안이며 다음 실행 시 캐시로도 사용됩니다.
+    char magic[4] = "YRAT"
+    uint32_t version, pageWidth, pageHeight, padding, flags(1: uastc, 2: srgb), pageCount, spriteCount
+    spriteCount개의 스프라이트 (이름 순):
+        uint64_t hash           원본 파일 내용의 FNV-1a 해시
+        uint32_t page, x, y     페이지 번호와 패딩을 포함한 영역의 위치(px)
+        uint32_t width, height  원본 이미지 크기(px)
+        float texrect[4]        get2DInstancedPipeline에 그대로 줄 수 있는 값 (xy: 배율, zw: 오프셋)
+        uint16_t nameLength
+        char name[nameLength]   입력 디렉토리 기준 상대 경로('/' 구분)
+페이지는 <출력>_<페이지 번호>.ktx2로 저장됩니다.
+*/
+
+using onart::RectPacker;
+namespace fs = std::filesystem;
+
+constexpr uint32_t INDEX_VERSION = 1;
+
+struct Options {
+    uint32_t pageWidth = 2048, pageHeight = 2048, padding = 1, flags = 1;
+    inline bool operator==(const Options& o) const { return pageWidth == o.pageWidth && pageHeight == o.pageHeight && padding == o.padding && flags == o.flags; }
+};
+
+struct Sprite {
+    std::string name;
+    fs::path path;
+    std::vector<uint8_t> file;
+    uint64_t hash = 0;
+    uint32_t width = 0, height = 0;
+    uint32_t page = UINT32_MAX;
+    RectPacker::Rect rect{};
+    bool valid = false;
+};
+
+struct CachedSprite {
+    uint64_t hash;
+    uint32_t page;
+    RectPacker::Rect rect;
+    uint32_t width, height;
+};
+
+static uint64_t fnv1a(const uint8_t* data, size_t size) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; i++) {
+        h ^= data[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+template<class F>
+static void parallelFor(size_t count, size_t threads, F&& f) {
+    std::atomic<size_t> next{ 0 };
+    auto work = [&]() { for (size_t i; (i = next.fetch_add(1)) < count;) { f(i); } };
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads && t < count; t++) { pool.emplace_back(work); }
+    work();
+    for (std::thread& t : pool) { t.join(); }
+}
+
+static bool readFile(const fs::path& path, std::vector<uint8_t>& out) {
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (!f) return false;
+    out.resize((size_t)f.tellg());
+    f.seekg(0);
+    return (bool)f.read((char*)out.data(), out.size());
+}
+
+template<class T>
+static bool readPOD(std::ifstream& f, T& v) { return (bool)f.read((char*)&v, sizeof(T)); }
+template<class T>
+static void writePOD(std::ofstream& f, const T& v) { f.write((const char*)&v, sizeof(T)); }
+
+static bool loadIndex(const fs::path& path, Options& opts, uint32_t& pageCount, std::unordered_map<std::string, CachedSprite>& cache) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+    char magic[4];
+    uint32_t version, spriteCount;
+    if (!f.read(magic, 4) || std::memcmp(magic, "YRAT", 4) != 0) return false;
+    if (!readPOD(f, version) || version != INDEX_VERSION) return false;
+    if (!readPOD(f, opts.pageWidth) || !readPOD(f, opts.pageHeight) || !readPOD(f, opts.padding) || !readPOD(f, opts.flags)) return false;
+    if (!readPOD(f, pageCount) || !readPOD(f, spriteCount)) return false;
+    for (uint32_t i = 0; i < spriteCount; i++) {
+        CachedSprite c;
+        float texrect[4];
+        uint16_t nameLength;
+        if (!readPOD(f, c.hash) || !readPOD(f, c.page) || !readPOD(f, c.rect.x) || !readPOD(f, c.rect.y) || !readPOD(f, c.width) || !readPOD(f, c.height)) return false;
+        if (!f.read((char*)texrect, sizeof(texrect)) || !readPOD(f, nameLength)) return false;
+        std::string name(nameLength, '\0');
+        if (!f.read(name.data(), nameLength)) return false;
+        cache[name] = c;
+    }
+    return true;
+}
+
+static bool writeIndex(const fs::path& path, const Options& opts, uint32_t pageCount, const std::vector<Sprite>& sprites) {
+    std::ofstream f(path, std::ios::binary);
+    if (!f) return false;
+    uint32_t spriteCount = 0;
+    for (const Sprite& s : sprites) { if (s.valid) spriteCount++; }
+    f.write("YRAT", 4);
+    writePOD(f, INDEX_VERSION);
+    writePOD(f, opts.pageWidth);
+    writePOD(f, opts.pageHeight);
+    writePOD(f, opts.padding);
+    writePOD(f, opts.flags);
+    writePOD(f, pageCount);
+    writePOD(f, spriteCount);
+    const float iw = 1.0f / opts.pageWidth, ih = 1.0f / opts.pageHeight;
+    for (const Sprite& s : sprites) {
+        if (!s.valid) continue;
+        const float texrect[4] = { s.width * iw, s.height * ih, (s.rect.x + opts.padding) * iw, (s.rect.y + opts.padding) * ih };
+        writePOD(f, s.hash);
+        writePOD(f, s.page);
+        writePOD(f, s.rect.x);
+        writePOD(f, s.rect.y);
+        writePOD(f, s.width);
+        writePOD(f, s.height);
+        f.write((const char*)texrect, sizeof(texrect));
+        writePOD(f, (uint16_t)s.name.size());
+        f.write(s.name.data(), s.name.size());
+    }
+    return (bool)f;
+}
+
+// 패딩 영역은 가장자리 픽셀을 늘려 채웁니다. (yr_atlas.cpp의 TextureAtlas와 같은 방식)
+static void blit(std::vector<uint8_t>& page, const Options& opts, const Sprite& s, const uint8_t* rgba) {
+    const size_t rowBytes = (size_t)s.width * 4;
+    const uint32_t left = s.rect.x + opts.padding, top = s.rect.y + opts.padding;
+    for (uint32_t y = 0; y < s.height; y++) {
+        uint8_t* row = &page[(((size_t)top + y) * opts.pageWidth + left) * 4];
+        std::memcpy(row, rgba + y * rowBytes, rowBytes);
+        for (uint32_t p = 1; p <= opts.padding; p++) {
+            std::memcpy(row - p * 4, row, 4);
+            std::memcpy(row + rowBytes + (p - 1) * 4, row + rowBytes - 4, 4);
+        }
+    }
+    const size_t paddedBytes = (size_t)s.rect.width * 4;
+    const uint8_t* first = &page[((size_t)top * opts.pageWidth + s.rect.x) * 4];
+    const uint8_t* last = &page[(((size_t)top + s.height - 1) * opts.pageWidth + s.rect.x) * 4];
+    for (uint32_t p = 1; p <= opts.padding; p++) {
+        std::memcpy(&page[(((size_t)top - p) * opts.pageWidth + s.rect.x) * 4], first, paddedBytes);
+        std::memcpy(&page[(((size_t)top + s.height - 1 + p) * opts.pageWidth + s.rect.x) * 4], last, paddedBytes);
+    }
+}
+
+static bool writePage(const fs::path& path, const Options& opts, const std::vector<uint8_t>& pixels) {
+    ktxTexture2* texture;
+    ktxTextureCreateInfo info{};
+    info.vkFormat = (opts.flags & 2) ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+    info.baseWidth = opts.pageWidth;
+    info.baseHeight = opts.pageHeight;
+    info.baseDepth = 1;
+    info.numDimensions = 2;
+    info.numFaces = 1;
+    info.numLayers = 1;
+    info.numLevels = 1; // 아틀라스에 밉을 만들면 이웃 이미지와 섞이므로 1로 고정
+    info.isArray = KTX_FALSE;
+    info.generateMipmaps = KTX_FALSE;
+    ktx_error_code_e result = ktxTexture2_Create(&info, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &texture);
+    if (result != KTX_SUCCESS) {
+        printf("KTX create failed: %d\n", result);
+        return false;
+    }
+    result = ktxTexture_SetImageFromMemory(ktxTexture(texture), 0, 0, 0, pixels.data(), pixels.size());
+    if (result == KTX_SUCCESS) {
+        ktxBasisParams params{};
+        params.structSize = sizeof(params);
+        params.compressionLevel = KTX_ETC1S_DEFAULT_COMPRESSION_LEVEL;
+        params.uastc = (opts.flags & 1) ? KTX_TRUE : KTX_FALSE;
+        params.threadCount = 1; // 페이지 단위로 병렬 처리하므로
+        result = ktxTexture2_CompressBasisEx(texture, &params);
+    }
+    if (result == KTX_SUCCESS) {
+        result = ktxTexture_WriteToNamedFile(ktxTexture(texture), path.string().c_str());
+    }
+    ktxTexture_Destroy(ktxTexture(texture));
+    if (result != KTX_SUCCESS) {
+        printf("KTX write failed (%s): %d\n", path.string().c_str(), result);
+        return false;
+    }
+    return true;
+}
+
+static fs::path pagePath(const fs::path& prefix, uint32_t page) {
+    fs::path p = prefix;
+    p += "_" + std::to_string(page) + ".ktx2";
+    return p;
+}
+
+static bool isImage(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) { return (char)std::tolower((unsigned char)c); });
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp" || ext == ".tga";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Usage: %s input_directory output_prefix [page_size] [padding] [threads] [etc1s?] [load as srgb?]\n", argv[0]);
+        printf("Writes output_prefix.yrat (sprite index) and output_prefix_<n>.ktx2 (pages). Pages whose images did not change are not encoded again.\n");
+        printf("[etc1s?] and [load as srgb?] will be activated if the argument equals y or Y\n");
+        return 0;
+    }
+    auto yes = [](const char* arg) { return (arg[0] == 'y' || arg[0] == 'Y') && arg[1] == '\0'; };
+    const fs::path inputDir(argv[1]);
+    const fs::path prefix(argv[2]);
+    Options opts;
+    if (argc >= 4) { opts.pageWidth = opts.pageHeight = (uint32_t)std::atoi(argv[3]); }
+    if (argc >= 5) { opts.padding = (uint32_t)std::atoi(argv[4]); }
+    size_t threads = std::thread::hardware_concurrency();
+    if (argc >= 6) { threads = (size_t)std::atoi(argv[5]); }
+    if (threads == 0) { threads = 1; }
+    if (argc >= 7 && yes(argv[6])) { opts.flags &= ~1u; }
+    if (argc >= 8 && yes(argv[7])) { opts.flags |= 2u; }
+    if (opts.pageWidth == 0) {
+        printf("Invalid page size\n");
+        return 1;
+    }
+
+    std::error_code ec;
+    std::vector<Sprite> sprites;
+    for (fs::recursive_directory_iterator it(inputDir, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file() || !isImage(it->path())) continue;
+        Sprite& s = sprites.emplace_back();
+        s.path = it->path();
+        s.name = it->path().lexically_relative(inputDir).generic_string();
+    }
+    if (ec) {
+        printf("Failed to read directory %s: %s\n", inputDir.string().c_str(), ec.message().c_str());
+        return 1;
+    }
+    std::sort(sprites.begin(), sprites.end(), [](const Sprite& a, const Sprite& b) { return a.name < b.name; });
+
+    // 파일 읽기와 해시, 크기 확인은 디코딩 없이 병렬로
+    parallelFor(sprites.size(), threads, [&](size_t i) {
+        Sprite& s = sprites[i];
+        int x, y, ch;
+        if (!readFile(s.path, s.file) || !stbi_info_from_memory(s.file.data(), (int)s.file.size(), &x, &y, &ch)) return;
+        s.hash = fnv1a(s.file.data(), s.file.size());
+        s.width = (uint32_t)x;
+        s.height = (uint32_t)y;
+        s.valid = s.width + opts.padding * 2 <= opts.pageWidth && s.height + opts.padding * 2 <= opts.pageHeight;
+    });
+    for (const Sprite& s : sprites) {
+        if (!s.valid) { printf("Skipped %s: unreadable or larger than a page\n", s.name.c_str()); }
+    }
+
+    Options cachedOpts;
+    uint32_t cachedPageCount = 0;
+    std::unordered_map<std::string, CachedSprite> cache;
+    const fs::path indexPath = fs::path(prefix).concat(".yrat");
+    const bool useCache = loadIndex(indexPath, cachedOpts, cachedPageCount, cache) && cachedOpts == opts;
+
+    std::vector<RectPacker> packers;
+    std::vector<uint8_t> dirty;
+    size_t reused = 0;
+    if (useCache) {
+        packers.resize(cachedPageCount, RectPacker(opts.pageWidth, opts.pageHeight));
+        dirty.resize(cachedPageCount, 0);
+        for (Sprite& s : sprites) {
+            if (!s.valid) continue;
+            auto it = cache.find(s.name);
+            if (it == cache.end()) continue;
+            const CachedSprite& c = it->second;
+            RectPacker::Rect r{ c.rect.x, c.rect.y, s.width + opts.padding * 2, s.height + opts.padding * 2 };
+            if (c.hash == s.hash && c.width == s.width && c.height == s.height && c.page < cachedPageCount && packers[c.page].occupy(r)) {
+                s.page = c.page;
+                s.rect = r;
+                reused++;
+                cache.erase(it);
+            }
+        }
+        // 남은 캐시 항목은 지워졌거나 바뀐 것이므로 그 페이지는 다시 만들어야 함
+        for (auto& kv : cache) {
+            if (kv.second.page < cachedPageCount) { dirty[kv.second.page] = 1; }
+        }
+    }
+
+    std::vector<Sprite*> pending;
+    for (Sprite& s : sprites) {
+        if (s.valid && s.page == UINT32_MAX) { pending.push_back(&s); }
+    }
+    std::sort(pending.begin(), pending.end(), [](const Sprite* a, const Sprite* b) { return a->height != b->height ? a->height > b->height : a->width > b->width; });
+    for (Sprite* s : pending) {
+        const uint32_t w = s->width + opts.padding * 2, h = s->height + opts.padding * 2;
+        uint32_t page = 0;
+        for (; page < packers.size(); page++) {
+            if (packers[page].insert(w, h, s->rect)) break;
+        }
+        if (page == packers.size()) {
+            packers.emplace_back(opts.pageWidth, opts.pageHeight);
+            dirty.push_back(1);
+            packers.back().insert(w, h, s->rect);
+        }
+        s->page = page;
+        dirty[page] = 1;
+    }
+
+    // 빈 페이지를 없애고 뒤 페이지 번호를 당김. 번호가 바뀐 페이지는 파일 이름이 바뀌므로 다시 씀
+    std::vector<uint32_t> remap(packers.size());
+    uint32_t pageCount = 0;
+    for (uint32_t p = 0; p < packers.size(); p++) {
+        if (packers[p].empty()) {
+            remap[p] = UINT32_MAX;
+            continue;
+        }
+        remap[p] = pageCount;
+        dirty[pageCount] = dirty[p] || pageCount != p || !fs::exists(pagePath(prefix, pageCount));
+        pageCount++;
+    }
+    for (Sprite& s : sprites) {
+        if (s.valid) { s.page = remap[s.page]; }
+    }
+
+    std::vector<uint32_t> rebuild;
+    for (uint32_t p = 0; p < pageCount; p++) {
+        if (dirty[p]) { rebuild.push_back(p); }
+    }
+    std::vector<std::vector<Sprite*>> members(pageCount);
+    for (Sprite& s : sprites) {
+        if (s.valid && dirty[s.page]) { members[s.page].push_back(&s); }
+    }
+    std::atomic<bool> failed{ false };
+    // 페이지 수가 스레드 수보다 적을 때도 디코딩은 모든 스레드로 나눠서 함
+    parallelFor(rebuild.size(), threads, [&](size_t i) {
+        const uint32_t p = rebuild[i];
+        std::vector<uint8_t> pixels((size_t)opts.pageWidth * opts.pageHeight * 4);
+        std::vector<uint8_t*> decoded(members[p].size());
+        parallelFor(members[p].size(), threads / rebuild.size() + 1, [&](size_t k) {
+            const Sprite* s = members[p][k];
+            int x, y, ch;
+            decoded[k] = stbi_load_from_memory(s->file.data(), (int)s->file.size(), &x, &y, &ch, 4);
+        });
+        for (size_t k = 0; k < members[p].size(); k++) {
+            if (!decoded[k]) {
+                printf("Failed to decode %s\n", members[p][k]->name.c_str());
+                failed = true;
+                continue;
+            }
+            blit(pixels, opts, *members[p][k], decoded[k]);
+            stbi_image_free(decoded[k]);
+        }
+        if (!writePage(pagePath(prefix, p), opts, pixels)) { failed = true; }
+    });
+    for (uint32_t p = pageCount; p < std::max(cachedPageCount, (uint32_t)packers.size()); p++) {
+        fs::remove(pagePath(prefix, p), ec);
+    }
+    if (failed || !writeIndex(indexPath, opts, pageCount, sprites)) {
+        fs::remove(indexPath, ec); // 다음 실행에서 모두 새로 만들도록
+        printf("Atlas build failed\n");
+        return 1;
+    }
+    printf("%zu images (%zu unchanged), %u pages (%zu rebuilt)\n", sprites.size(), reused, pageCount, rebuild.size());
+    return 0;
+}
@@ -0,0 +1,410 @@
+#include "../YERM_PC/yr_scene.h"
+#include "../YERM_PC/yr_geometry.hpp"
+#include "../YERM_PC/yr_bits.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace onart;
+
+// 기준값 계산용 배정밀도 구현. 엔진 코드와 독립적으로 작성해야 회귀를 잡을 수 있음
+struct dmat4 {
+    double a[16];
+    double& operator[](int i) { return a[i]; }
+    double operator[](int i) const { return a[i]; }
+};
+
+static dmat4 toD(const mat4& m) { dmat4 r; for (int i = 0; i < 16; i++) { r[i] = m[i]; } return r; }
+
+static dmat4 dmul(const dmat4& l, const dmat4& r) {
+    dmat4 o;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            double s = 0;
+            for (int k = 0; k < 4; k++) { s += l[i * 4 + k] * r[k * 4 + j]; }
+            o[i * 4 + j] = s;
+        }
+    }
+    return o;
+}
+
+static dmat4 dinverse(const dmat4& m) {
+    double a[4][8];
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) { a[i][j] = m[i * 4 + j]; a[i][j + 4] = i == j; }
+    }
+    for (int c = 0; c < 4; c++) {
+        int p = c;
+        for (int r = c + 1; r < 4; r++) { if (std::abs(a[r][c]) > std::abs(a[p][c])) p = r; }
+        for (int j = 0; j < 8; j++) { std::swap(a[c][j], a[p][j]); }
+        const double d = a[c][c];
+        for (int j = 0; j < 8; j++) { a[c][j] /= d; }
+        for (int r = 0; r < 4; r++) {
+            if (r == c) continue;
+            const double f = a[r][c];
+            for (int j = 0; j < 8; j++) { a[r][j] -= f * a[c][j]; }
+        }
+    }
+    dmat4 o;
+    for (int i = 0; i < 4; i++) { for (int j = 0; j < 4; j++) { o[i * 4 + j] = a[i][j + 4]; } }
+    return o;
+}
+
+struct dquat { double w, x, y, z; };
+
+static dquat toD(const Quaternion& q) { return { q.c1, q.ci, q.cj, q.ck }; }
+
+static dmat4 dTRS(const vec3& t, const dquat& q, const vec3& s) {
+    const double w = q.w, x = q.x, y = q.y, z = q.z;
+    return { {
+        (1 - 2 * (y * y + z * z)) * s.x, 2 * (x * y - w * z) * s.y, 2 * (x * z + w * y) * s.z, t.x,
+        2 * (x * y + w * z) * s.x, (1 - 2 * (x * x + z * z)) * s.y, 2 * (y * z - w * x) * s.z, t.y,
+        2 * (x * z - w * y) * s.x, 2 * (y * z + w * x) * s.y, (1 - 2 * (x * x + y * y)) * s.z, t.z,
+        0, 0, 0, 1
+    } };
+}
+
+static dmat4 dLookAt(const vec3& eye, const vec3& at, const vec3& up) {
+    double n[3] = { (double)eye.x - at.x, (double)eye.y - at.y, (double)eye.z - at.z };
+    auto normalize = [](double* v) { double l = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]); v[0] /= l; v[1] /= l; v[2] /= l; };
+    auto cross = [](const double* a, const double* b, double* o) { o[0] = a[1] * b[2] - a[2] * b[1]; o[1] = a[2] * b[0] - a[0] * b[2]; o[2] = a[0] * b[1] - a[1] * b[0]; };
+    normalize(n);
+    double u0[3] = { up.x, up.y, up.z }, u[3], v[3];
+    cross(u0, n, u); normalize(u);
+    cross(n, u, v);
+    const double e[3] = { eye.x, eye.y, eye.z };
+    return { {
+        u[0], u[1], u[2], -(u[0] * e[0] + u[1] * e[1] + u[2] * e[2]),
+        v[0], v[1], v[2], -(v[0] * e[0] + v[1] * e[1] + v[2] * e[2]),
+        n[0], n[1], n[2], -(n[0] * e[0] + n[1] * e[1] + n[2] * e[2]),
+        0, 0, 0, 1
+    } };
+}
+
+static void dRotate(const vec3& v, const dquat& q, double* o) {
+    // q * v * conj(q). 단위 사원수가 아니면 엔진 구현과 같이 |q|^2배가 됨
+    const dquat p{ 0, v.x, v.y, v.z };
+    auto qmul = [](const dquat& a, const dquat& b) {
+        return dquat{
+            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+            a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w
+        };
+    };
+    const dquat r = qmul(qmul(q, p), dquat{ q.w, -q.x, -q.y, -q.z });
+    o[0] = r.x; o[1] = r.y; o[2] = r.z;
+}
+
+static dquat dSlerp(const dquat& a, dquat b, double t) {
+    double c = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+    c = std::min(1.0, std::max(-1.0, c));
+    const double th = std::acos(c), s = std::sin(th);
+    if (s < 1e-7) return a;
+    const double wa = std::sin((1 - t) * th) / s, wb = std::sin(t * th) / s;
+    dquat r{ a.w * wa + b.w * wb, a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb };
+    const double l = std::sqrt(r.w * r.w + r.x * r.x + r.y * r.y + r.z * r.z);
+    return { r.w / l, r.x / l, r.y / l, r.z / l };
+}
+
+static double relErr(double got, double ref) { return std::abs(got - ref) / std::max(1.0, std::abs(ref)); }
+// 아래 두 허용 오차는 측정값이 아니라 형식의 정밀도에서 유도함
+// binary16: 가수 10비트이므로 최근접 반올림의 상대 오차는 2^-11 이하. 절사 변환까지 허용하도록 2배를 둠
+static const double HALF_TOLERANCE = 2.0 * std::ldexp(1.0, -11);
+// int16 * Q15 배율: mulhi 후 1비트 이동에서 절사로 2 미만, 배율을 Q15로 내릴 때 |x| * 2^-15 <= 1 미만
+static const double Q15_MUL_TOLERANCE = 2.0 + 32768.0 * std::ldexp(1.0, -15);
+static double matErr(const mat4& m, const dmat4& r) { double e = 0; for (int i = 0; i < 16; i++) { e = std::max(e, relErr(m[i], r[i])); } return e; }
+
+static volatile float sink;
+
+// 초월함수 근사: 배열 전체에 4레인/8레인 판을 적용
+template<class F>
+static void apply4(const float* x, float* y, size_t n, F&& f) { for (size_t i = 0; i + 4 <= n; i += 4) storeu(f(loadu(x + i)), y + i); }
+static void sin4All(const float* x, float* y, size_t n) { apply4(x, y, n, [](float128 v) { return sin(v); }); }
+static void exp4All(const float* x, float* y, size_t n) { apply4(x, y, n, [](float128 v) { return exp(v); }); }
+static void log4All(const float* x, float* y, size_t n) { apply4(x, y, n, [](float128 v) { return log(v); }); }
+static void rsqrt4All(const float* x, float* y, size_t n) { apply4(x, y, n, [](float128 v) { return rsqrtNR(v); }); }
+static void atan24All(const float* x, const float* z, float* y, size_t n) { for (size_t i = 0; i + 4 <= n; i += 4) storeu(atan2(loadu(x + i), loadu(z + i)), y + i); }
+#ifdef YR_USING_AVX2
+YR_TARGET_AVX2 static void sin8All(const float* x, float* y, size_t n) { for (size_t i = 0; i + 8 <= n; i += 8) _mm256_storeu_ps(y + i, avx2::sin(_mm256_loadu_ps(x + i))); }
+YR_TARGET_AVX2 static void exp8All(const float* x, float* y, size_t n) { for (size_t i = 0; i + 8 <= n; i += 8) _mm256_storeu_ps(y + i, avx2::exp(_mm256_loadu_ps(x + i))); }
+YR_TARGET_AVX2 static void log8All(const float* x, float* y, size_t n) { for (size_t i = 0; i + 8 <= n; i += 8) _mm256_storeu_ps(y + i, avx2::log(_mm256_loadu_ps(x + i))); }
+YR_TARGET_AVX2 static void rsqrt8All(const float* x, float* y, size_t n) { for (size_t i = 0; i + 8 <= n; i += 8) _mm256_storeu_ps(y + i, avx2::rsqrtNR(_mm256_loadu_ps(x + i))); }
+YR_TARGET_AVX2 static void atan28All(const float* x, const float* z, float* y, size_t n) { for (size_t i = 0; i + 8 <= n; i += 8) _mm256_storeu_ps(y + i, avx2::atan2(_mm256_loadu_ps(x + i), _mm256_loadu_ps(z + i))); }
+#endif
+
+struct Case {
+    const char* name;
+    double tolerance;
+    std::function<void()> run;    // 측정 대상. 한 번 호출에 count번 연산
+    std::function<double()> check; // 기준값 대비 최대 상대 오차
+    size_t count;
+};
+
+template<class F>
+static double bestNs(int repeat, size_t count, F&& f) {
+    double best = 1e30;
+    for (int i = 0; i < repeat; i++) {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - begin).count());
+    }
+    return best / (double)count;
+}
+
+int main(int argc, char* argv[]) {
+    const int repeat = argc >= 2 ? atoi(argv[1]) : 50;
+    const size_t N = 4096;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f), pos(-10.0f, 10.0f), scl(0.5f, 2.0f), t01(0.0f, 1.0f);
+
+    std::vector<vec3> P(N), S(N), V(N);
+    std::vector<Quaternion> Q(N), Q2(N);
+    std::vector<float> T(N);
+    std::vector<mat4> A(N), B(N), O(N);
+    for (size_t i = 0; i < N; i++) {
+        P[i] = vec3(pos(rng), pos(rng), pos(rng));
+        S[i] = vec3(scl(rng), scl(rng), scl(rng));
+        V[i] = vec3(unit(rng), unit(rng), unit(rng));
+        Q[i] = Quaternion::rotation(vec3(unit(rng), unit(rng), unit(rng) + 2.0f).normal(), pos(rng));
+        Q2[i] = Quaternion::rotation(vec3(unit(rng), unit(rng) + 2.0f, unit(rng)).normal(), pos(rng));
+        T[i] = t01(rng);
+        A[i] = mat4::TRS(P[i], Q[i], S[i]);
+        B[i] = mat4::TRS(V[i], Q2[i], S[(i + 1) % N]);
+    }
+
+    // SoA 사본
+    std::vector<float> px(N), py(N), pz(N), sx(N), sy(N), sz(N), qw(N), qx(N), qy(N), qz(N), rw(N), rx(N), ry(N), rz(N);
+    std::vector<float> ox(N), oy(N), oz(N), ow(N);
+    for (size_t i = 0; i < N; i++) {
+        px[i] = P[i].x; py[i] = P[i].y; pz[i] = P[i].z;
+        sx[i] = S[i].x; sy[i] = S[i].y; sz[i] = S[i].z;
+        qw[i] = Q[i].c1; qx[i] = Q[i].ci; qy[i] = Q[i].cj; qz[i] = Q[i].ck;
+        rw[i] = Q2[i].c1; rx[i] = Q2[i].ci; ry[i] = Q2[i].cj; rz[i] = Q2[i].ck;
+    }
+    const vec3SoA pSoA{ px.data(), py.data(), pz.data() }, sSoA{ sx.data(), sy.data(), sz.data() }, oSoA{ ox.data(), oy.data(), oz.data() };
+    const QuaternionSoA qSoA{ qw.data(), qx.data(), qy.data(), qz.data() }, rSoA{ rw.data(), rx.data(), ry.data(), rz.data() };
+    const QuaternionSoA oqSoA{ ow.data(), ox.data(), oy.data(), oz.data() };
+
+    // 배열 연산용
+    std::vector<float> fa(N), fb(N), fo(N);
+    std::vector<int16_t> ia(N), ib(N), io(N);
+    for (size_t i = 0; i < N; i++) {
+        fa[i] = pos(rng); fb[i] = scl(rng);
+        ia[i] = (int16_t)(rng() & 0xffff); ib[i] = (int16_t)(rng() & 0xffff);
+    }
+
+    // 초월함수용 입력: 각도 [-100, 100], 지수 [-80, 80], 로그/역제곱근 [2^-100, 2^100]
+    std::vector<float> ang(N), ex(N), lg(N), yo(N);
+    std::uniform_real_distribution<float> angD(-100.0f, 100.0f), expD(-80.0f, 80.0f), lgD(-100.0f, 100.0f);
+    for (size_t i = 0; i < N; i++) { ang[i] = angD(rng); ex[i] = expD(rng); lg[i] = std::exp2(lgD(rng)); }
+    auto relCheck = [&](const std::vector<float>& in, double (*ref)(double)) {
+        double e = 0;
+        for (size_t i = 0; i < N; i++) { const double r = ref(in[i]); e = std::max(e, std::abs(yo[i] - r) / std::max(std::abs(r), 1e-30)); }
+        return e;
+    };
+    auto absCheck = [&](const std::vector<float>& in, double (*ref)(double)) {
+        double e = 0;
+        for (size_t i = 0; i < N; i++) { e = std::max(e, std::abs(yo[i] - ref(in[i]))); }
+        return e;
+    };
+    auto atan2Check = [&] {
+        double e = 0;
+        for (size_t i = 0; i < N; i++) { e = std::max(e, std::abs(yo[i] - std::atan2((double)fa[i], (double)ang[i]))); }
+        return e;
+    };
+    double (*dsin)(double) = std::sin;
+    double (*dexp)(double) = std::exp;
+    double (*dlog)(double) = std::log;
+    double (*drsqrt)(double) = [](double x) { return 1.0 / std::sqrt(x); };
+
+    // 교차 검사용: P 중심, S 반 길이인 상자와 S.x 반지름인 구. 일괄 검사 결과는 스칼라 판정과 어긋난 개수를 오차로 봄
+    std::vector<float> bnx(N), bny(N), bnz(N), bxx(N), bxy(N), bxz(N), br(N), bt(N);
+    std::vector<uint8_t> hit(N);
+    for (size_t i = 0; i < N; i++) {
+        bnx[i] = P[i].x - S[i].x; bny[i] = P[i].y - S[i].y; bnz[i] = P[i].z - S[i].z;
+        bxx[i] = P[i].x + S[i].x; bxy[i] = P[i].y + S[i].y; bxz[i] = P[i].z + S[i].z;
+        br[i] = S[i].x;
+    }
+    const AABBSoA boxSoA{ { bnx.data(), bny.data(), bnz.data() }, { bxx.data(), bxy.data(), bxz.data() } };
+    const SphereSoA sphSoA{ pSoA, br.data() }, sph2SoA{ { py.data(), pz.data(), px.data() }, br.data() };
+    auto boxAt = [&](size_t i) { return AABB(vec3(bnx[i], bny[i], bnz[i]), vec3(bxx[i], bxy[i], bxz[i])); };
+    const Frustum frustum = Frustum::fromMatrix(mat4::perspective(1.0f, 1.5f, 0.5f, 30.0f) * mat4::lookAt(vec3(2, 3, -15), vec3(0, 0, 0), vec3(0, 1, 0)));
+    const Ray ray(vec3(-20, 0.5f, 0.25f), vec3(1, 0.02f, -0.01f));
+    auto cullCheck = [&] { size_t m = 0; for (size_t i = 0; i < N; i++) m += hit[i] != (uint8_t)intersects(frustum, boxAt(i)); return (double)m; };
+    auto rayCheck = [&] {
+        size_t m = 0;
+        for (size_t i = 0; i < N; i++) { float t; m += raycast(ray, boxAt(i), t) ? t != bt[i] : bt[i] != std::numeric_limits<float>::infinity(); }
+        return (double)m;
+    };
+
+    // 정점 속성 양자화용: 일괄 변환은 스칼라 함수와 어긋난 개수, 왕복은 최대 오차를 봄
+    std::vector<uint16_t> hq(N);
+    std::vector<int16_t> sq(N), oq(2 * N);
+    std::vector<uint8_t> uq(N);
+    std::vector<float> nrm(3 * N), nrmOut(3 * N);
+    for (size_t i = 0; i < N; i++) {
+        const vec3 n = V[i] / V[i].length();
+        nrm[3 * i] = n.x; nrm[3 * i + 1] = n.y; nrm[3 * i + 2] = n.z;
+    }
+    auto octCheck = [&] {
+        double e = 0;
+        for (size_t i = 0; i < N; i++) {
+            const double d = (double)nrmOut[3 * i] * nrm[3 * i] + (double)nrmOut[3 * i + 1] * nrm[3 * i + 1] + (double)nrmOut[3 * i + 2] * nrm[3 * i + 2];
+            e = std::max(e, std::acos(std::min(1.0, d)));
+        }
+        return e;
+    };
+
+    // 부모 변경 시 행렬 분해(mat2prs) 측정용
+    Transform* parentA = Transform::create();
+    Transform* parentB = Transform::create();
+    parentA->setPosition(vec3(1, 2, 3)); parentA->setRotation(Q[0]); parentA->setScale(vec3(1.5f));
+    parentB->setPosition(vec3(-3, 0, 2)); parentB->setRotation(Q[1]); parentB->setScale(vec3(0.75f));
+    std::vector<Transform*> nodes(256);
+    std::vector<mat4> nodeGlobal(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        nodes[i] = Transform::create(parentA);
+        nodes[i]->setPosition(P[i]); nodes[i]->setRotation(Q[i]); nodes[i]->setScale(vec3(S[i].x));
+        nodeGlobal[i] = nodes[i]->getGlobalTransform();
+    }
+    bool nodesOnA = true;
+
+    std::vector<Case> cases = {
+        { "mat4 operator*", 1e-5, [&] { for (size_t i = 0; i < N; i++) O[i] = A[i] * B[i]; },
+            [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, matErr(O[i], dmul(toD(A[i]), toD(B[i])))); return e; }, N },
+        { "mulAll(mat4)", 1e-5, [&] { mulAll(A.data(), B.data(), O.data(), N); },
+            [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, matErr(O[i], dmul(toD(A[i]), toD(B[i])))); return e; }, N },
+        { "mat4::inverse", 1e-4, [&] { for (size_t i = 0; i < N; i++) O[i] = A[i].inverse(); },
+            [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, matErr(O[i], dinverse(toD(A[i])))); return e; }, N },
+        { "mat4::affineInverse", 1e-4, [&] { for (size_t i = 0; i < N; i++) O[i] = A[i].affineInverse(); },
+            [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, matErr(O[i], dinverse(toD(A[i])))); return e; }, N },
+        { "mat4::TRS", 1e-5, [&] { for (size_t i = 0; i < N; i++) O[i] = mat4::TRS(P[i], Q[i], S[i]); },
+            [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, matErr(O[i], dTRS(P[i], toD(Q[i]), S[i]))); return e; }, N },
+        { "TRSAll", 1e-5, [&] { TRSAll(pSoA, qSoA, sSoA, O.data(), N); },
+            [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, matErr(O[i], dTRS(P[i], toD(Q[i]), S[i]))); return e; }, N },
+        // lookAt은 vec3::normal()을 거치며, SSE에서는 근사 역제곱근(상대 오차 1.5 * 2^-12 이하)을 사용함
+        { "mat4::lookAt", 5e-4, [&] { for (size_t i = 0; i < N; i++) O[i] = mat4::lookAt(P[i], V[i], vec3(0, 1, 0)); },
+            [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, matErr(O[i], dLookAt(P[i], V[i], vec3(0, 1, 0)))); return e; }, N },
+        { "transformPointsAll", 1e-5, [&] { transformPointsAll(A[0], pSoA, oSoA, N); },
+            [&] {
+                double e = 0; const dmat4 m = toD(A[0]);
+                for (size_t i = 0; i < N; i++) {
+                    const double r[3] = { m[0] * px[i] + m[1] * py[i] + m[2] * pz[i] + m[3], m[4] * px[i] + m[5] * py[i] + m[6] * pz[i] + m[7], m[8] * px[i] + m[9] * py[i] + m[10] * pz[i] + m[11] };
+                    e = std::max({ e, relErr(ox[i], r[0]), relErr(oy[i], r[1]), relErr(oz[i], r[2]) });
+                }
+                return e;
+            }, N },
+        { "rotate(vec3, Quaternion)", 1e-5, [&] { for (size_t i = 0; i < N; i++) V[(i + 1) % N] = rotate(V[i], Q[i]).normal(); },
+            [&] {
+                double e = 0;
+                for (size_t i = 0; i < N; i++) {
+                    double r[3]; dRotate(V[i], toD(Q[i]), r);
+                    vec3 g = rotate(V[i], Q[i]);
+                    e = std::max({ e, relErr(g.x, r[0]), relErr(g.y, r[1]), relErr(g.z, r[2]) });
+                }
+                return e;
+            }, N },
+        { "slerp", 1e-3, [&] { float s = 0; for (size_t i = 0; i < N; i++) s += slerp(Q[i], Q2[i], T[i]).c1; sink = s; },
+            [&] {
+                double e = 0;
+                for (size_t i = 0; i < N; i++) {
+                    Quaternion g = slerp(Q[i], Q2[i], T[i]); dquat r = dSlerp(toD(Q[i]), toD(Q2[i]), T[i]);
+                    e = std::max({ e, relErr(g.c1, r.w), relErr(g.ci, r.x), relErr(g.cj, r.y), relErr(g.ck, r.z) });
+                }
+                return e;
+            }, N },
+        { "slerpAll", 1e-3, [&] { slerpAll(qSoA, rSoA, T.data(), oqSoA, N); },
+            [&] {
+                double e = 0;
+                for (size_t i = 0; i < N; i++) {
+                    dquat r = dSlerp(toD(Q[i]), toD(Q2[i]), T[i]);
+                    e = std::max({ e, relErr(ow[i], r.w), relErr(ox[i], r.x), relErr(oy[i], r.y), relErr(oz[i], r.z) });
+                }
+                return e;
+            }, N },
+        { "Quaternion::rotation(euler)", 2e-6, [&] { for (size_t i = 0; i < N; i++) Q2[(i + 1) % N] = Quaternion::rotation(ang[i], V[i].x, V[i].y); },
+            [&] {
+                double e = 0;
+                for (size_t i = 0; i < N; i++) {
+                    Quaternion g = Quaternion::rotation(ang[i], V[i].x, V[i].y);
+                    const double r = ang[i] * 0.5, p = V[i].x * 0.5, y = V[i].y * 0.5;
+                    const double cr = std::cos(r), sr = std::sin(r), cp = std::cos(p), sp = std::sin(p), cy = std::cos(y), sy = std::sin(y);
+                    e = std::max({ e, relErr(g.c1, cr * cp * cy + sr * sp * sy), relErr(g.ci, sr * cp * cy - cr * sp * sy), relErr(g.cj, cr * sp * cy + sr * cp * sy), relErr(g.ck, cr * cp * sy - sr * sp * cy) });
+                }
+                return e;
+            }, N },
+        { "sin(float128)", 1e-7, [&] { sin4All(ang.data(), yo.data(), N); }, [&] { return absCheck(ang, dsin); }, N },
+        { "exp(float128)", 2e-7, [&] { exp4All(ex.data(), yo.data(), N); }, [&] { return relCheck(ex, dexp); }, N },
+        { "log(float128)", 2e-7, [&] { log4All(lg.data(), yo.data(), N); }, [&] { return relCheck(lg, dlog); }, N },
+        { "atan2(float128)", 4e-7, [&] { atan24All(fa.data(), ang.data(), yo.data(), N); }, atan2Check, N },
+        { "rsqrtNR(float128)", 4e-7, [&] { rsqrt4All(lg.data(), yo.data(), N); }, [&] { return relCheck(lg, drsqrt); }, N },
+        { "std::sin (reference)", 1e-7, [&] { for (size_t i = 0; i < N; i++) yo[i] = std::sin(ang[i]); }, [&] { return absCheck(ang, dsin); }, N },
+#ifdef YR_USING_AVX2
+        { "avx2::sin", 1e-7, [&] { if (avx2::ENABLED) sin8All(ang.data(), yo.data(), N); else sin4All(ang.data(), yo.data(), N); }, [&] { return absCheck(ang, dsin); }, N },
+        { "avx2::exp", 2e-7, [&] { if (avx2::ENABLED) exp8All(ex.data(), yo.data(), N); else exp4All(ex.data(), yo.data(), N); }, [&] { return relCheck(ex, dexp); }, N },
+        { "avx2::log", 2e-7, [&] { if (avx2::ENABLED) log8All(lg.data(), yo.data(), N); else log4All(lg.data(), yo.data(), N); }, [&] { return relCheck(lg, dlog); }, N },
+        { "avx2::atan2", 4e-7, [&] { if (avx2::ENABLED) atan28All(fa.data(), ang.data(), yo.data(), N); else atan24All(fa.data(), ang.data(), yo.data(), N); }, atan2Check, N },
+        { "avx2::rsqrtNR", 4e-7, [&] { if (avx2::ENABLED) rsqrt8All(lg.data(), yo.data(), N); else rsqrt4All(lg.data(), yo.data(), N); }, [&] { return relCheck(lg, drsqrt); }, N },
+#endif
+        { "intersects(Frustum, AABB)", 0, [&] { for (size_t i = 0; i < N; i++) hit[i] = intersects(frustum, boxAt(i)); }, cullCheck, N },
+        { "intersectsAll(Frustum, AABB)", 0, [&] { intersectsAll(frustum, boxSoA, hit.data(), N); }, cullCheck, N },
+        { "intersectsAll(Frustum, Sphere)", 0, [&] { intersectsAll(frustum, sphSoA, hit.data(), N); },
+            [&] { size_t m = 0; for (size_t i = 0; i < N; i++) m += hit[i] != (uint8_t)intersects(frustum, Sphere(P[i], br[i])); return (double)m; }, N },
+        { "intersectsAll(Sphere, Sphere)", 0, [&] { intersectsAll(sphSoA, sph2SoA, hit.data(), N); },
+            [&] { size_t m = 0; for (size_t i = 0; i < N; i++) m += hit[i] != (uint8_t)intersects(Sphere(P[i], br[i]), Sphere(vec3(py[i], pz[i], px[i]), br[i])); return (double)m; }, N },
+        { "raycast(Ray, AABB)", 0, [&] { for (size_t i = 0; i < N; i++) if (!raycast(ray, boxAt(i), bt[i])) bt[i] = std::numeric_limits<float>::infinity(); }, rayCheck, N },
+        { "raycastAll(Ray, AABB)", 0, [&] { raycastAll(ray, boxSoA, bt.data(), N); }, rayCheck, N },
+        { "floatToHalf", 0, [&] { for (size_t i = 0; i < N; i++) hq[i] = floatToHalf(fa[i]); }, [&] { size_t m = 0; for (size_t i = 0; i < N; i++) m += hq[i] != floatToHalf(fa[i]); return (double)m; }, N },
+        { "floatToHalfAll", 0, [&] { floatToHalfAll(fa.data(), hq.data(), N); }, [&] { size_t m = 0; for (size_t i = 0; i < N; i++) m += hq[i] != floatToHalf(fa[i]); return (double)m; }, N },
+        { "halfToFloatAll", HALF_TOLERANCE, [&] { halfToFloatAll(hq.data(), fo.data(), N); }, [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, relErr(fo[i], fa[i])); return e; }, N },
+        { "floatToSnorm16All", 0, [&] { floatToSnorm16All(T.data(), sq.data(), N); }, [&] { size_t m = 0; for (size_t i = 0; i < N; i++) m += sq[i] != floatToSnorm16(T[i]); return (double)m; }, N },
+        { "snorm16ToFloatAll", 2e-5, [&] { snorm16ToFloatAll(sq.data(), fo.data(), N); }, [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, std::abs((double)fo[i] - T[i])); return e; }, N },
+        { "floatToUnorm8All", 0, [&] { floatToUnorm8All(T.data(), uq.data(), N); }, [&] { size_t m = 0; for (size_t i = 0; i < N; i++) m += uq[i] != floatToUnorm8(T[i]); return (double)m; }, N },
+        { "unorm8ToFloatAll", 2e-3, [&] { unorm8ToFloatAll(uq.data(), fo.data(), N); }, [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, std::abs((double)fo[i] - T[i])); return e; }, N },
+        { "octEncodeAll", 0, [&] { octEncodeAll(nrm.data(), oq.data(), N); },
+            [&] { size_t m = 0; for (size_t i = 0; i < N; i++) { int16_t o[2]; octEncode(&nrm[3 * i], o); m += o[0] != oq[2 * i] || o[1] != oq[2 * i + 1]; } return (double)m; }, N },
+        { "octDecodeAll (rad)", 1e-3, [&] { octDecodeAll(oq.data(), nrmOut.data(), N); }, octCheck, N },
+        { "setParent (mat2prs)", 1e-4, [&] { nodesOnA = !nodesOnA; for (Transform* t : nodes) t->setParent(nodesOnA ? parentA : parentB); },
+            [&] { double e = 0; for (size_t i = 0; i < nodes.size(); i++) e = std::max(e, matErr(nodes[i]->getGlobalTransform(), toD(nodeGlobal[i]))); return e; }, nodes.size() },
+        { "addAll(float*, float*)", 0, [&] { std::copy(fa.begin(), fa.end(), fo.begin()); addAll(fo.data(), fb.data(), N); },
+            [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, relErr(fo[i], fa[i] + fb[i])); return e; }, N },
+        { "mulAll(float*, float)", 0, [&] { std::copy(fa.begin(), fa.end(), fo.begin()); mulAll(fo.data(), 1.25f, N); },
+            [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, relErr(fo[i], fa[i] * 1.25f)); return e; }, N },
+        { "mulAll(float*, float*)", 0, [&] { std::copy(fa.begin(), fa.end(), fo.begin()); mulAll(fo.data(), fb.data(), N); },
+            [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, relErr(fo[i], fa[i] * fb[i])); return e; }, N },
+        { "divAll(float*, float*)", 0, [&] { std::copy(fa.begin(), fa.end(), fo.begin()); divAll(fo.data(), fb.data(), N); },
+            [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, relErr(fo[i], fa[i] / fb[i])); return e; }, N },
+        { "addsAll(int16_t*)", 0, [&] { std::copy(ia.begin(), ia.end(), io.begin()); addsAll(io.data(), ib.data(), N); },
+            [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, (double)std::abs(io[i] - std::min(32767, std::max(-32768, ia[i] + ib[i])))); return e; }, N },
+        { "mulAll(int16_t*, float)", Q15_MUL_TOLERANCE, [&] { std::copy(ia.begin(), ia.end(), io.begin()); mulAll(io.data(), 0.625f, N); },
+            [&] { double e = 0; for (size_t i = 0; i < N; i++) e = std::max(e, std::abs(io[i] - ia[i] * 0.625)); return e; }, N },
+    };
+
+#ifdef YR_USING_AVX2
+    printf("SIMD: %s, repeat %d, %zu elements\n", avx2::ENABLED ? "SSE + AVX2/FMA" : "SSE", repeat, N);
+#elif defined(YR_USING_SIMD)
+    printf("SIMD: 128-bit, repeat %d, %zu elements\n", repeat, N);
+#else
+    printf("SIMD: none, repeat %d, %zu elements\n", repeat, N);
+#endif
+    printf("%-30s %12s %12s %10s\n", "case", "ns/op", "max err", "tolerance");
+    int failed = 0;
+    for (Case& c : cases) {
+        const double ns = bestNs(repeat, c.count, c.run);
+        const double err = c.check();
+        const bool ok = err <= c.tolerance;
+        failed += !ok;
+        printf("%-30s %12.3f %12.3g %10.0e %s\n", c.name, ns, err, c.tolerance, ok ? "ok" : "FAIL");
+    }
+    delete parentA;
+    delete parentB;
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,132 @@
+#include "../YERM_PC/yr_scene.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace onart;
+
+struct Shape {
+    const char* name;
+    uint32_t roots;
+    uint32_t childrenPerNode;
+    uint32_t depth;
+};
+
+struct NodeInit {
+    int32_t parent;
+    vec3 position;
+    Quaternion rotation;
+    vec3 scale;
+};
+
+static std::vector<NodeInit> makeNodes(const Shape& shape) {
+    std::vector<NodeInit> nodes;
+    std::vector<int32_t> level, next;
+    srand(1);
+    auto push = [&](int32_t parent) {
+        NodeInit n;
+        n.parent = parent;
+        n.position = vec3((float)(rand() % 100) * 0.1f, (float)(rand() % 100) * 0.1f, (float)(rand() % 100) * 0.1f);
+        n.rotation = Quaternion::rotation(vec3(0.3f, 1, 0.2f).normal(), (float)(rand() % 628) * 0.01f);
+        n.scale = vec3(1.0f + (float)(rand() % 10) * 0.01f);
+        nodes.push_back(n);
+        return (int32_t)nodes.size() - 1;
+    };
+    for (uint32_t r = 0; r < shape.roots; r++) { level.push_back(push(-1)); }
+    for (uint32_t d = 1; d < shape.depth; d++) {
+        next.clear();
+        for (int32_t p : level) {
+            for (uint32_t c = 0; c < shape.childrenPerNode; c++) { next.push_back(push(p)); }
+        }
+        level.swap(next);
+    }
+    return nodes;
+}
+
+template<class F>
+static double measure(int repeat, F&& f) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; i++) { f(i); }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count() / repeat;
+}
+
+static bool run(const Shape& shape, ThreadPool& pool, int repeat) {
+    std::vector<NodeInit> init = makeNodes(shape);
+    const size_t count = init.size();
+
+    std::vector<Transform*> legacy(count);
+    TransformHierarchy serial, parallel;
+    std::vector<TransformHandle> hs(count), hp(count);
+    for (size_t i = 0; i < count; i++) {
+        const NodeInit& n = init[i];
+        legacy[i] = Transform::create(n.parent >= 0 ? legacy[n.parent] : nullptr);
+        hs[i] = serial.create(n.parent >= 0 ? hs[n.parent] : TransformHandle{});
+        hp[i] = parallel.create(n.parent >= 0 ? hp[n.parent] : TransformHandle{});
+        legacy[i]->setPosition(n.position);
+        legacy[i]->setRotation(n.rotation);
+        legacy[i]->setScale(n.scale);
+        serial.setPosition(hs[i], n.position);
+        serial.setRotation(hs[i], n.rotation);
+        serial.setScale(hs[i], n.scale);
+        parallel.setPosition(hp[i], n.position);
+        parallel.setRotation(hp[i], n.rotation);
+        parallel.setScale(hp[i], n.scale);
+    }
+
+    // 매 반복마다 루트를 움직여 모든 노드를 다시 계산하게 함
+    std::vector<size_t> roots;
+    for (size_t i = 0; i < count; i++) { if (init[i].parent < 0) roots.push_back(i); }
+
+    double tLegacy = measure(repeat, [&](int it) {
+        for (size_t r : roots) { legacy[r]->setPositionX((float)it); }
+        for (Transform* t : legacy) { t->getGlobalTransform(); }
+    });
+    double tSerial = measure(repeat, [&](int it) {
+        for (size_t r : roots) { serial.setPosition(hs[r], vec3((float)it, init[r].position.y, init[r].position.z)); }
+        serial.update();
+    });
+    double tParallel = measure(repeat, [&](int it) {
+        for (size_t r : roots) { parallel.setPosition(hp[r], vec3((float)it, init[r].position.y, init[r].position.z)); }
+        parallel.update(pool);
+    });
+
+    // 루트만 움직이고 일부 노드만 조회하는 경우. 조회하지 않은 노드는 계산하지 않아야 함
+    double tSparse = measure(repeat, [&](int it) {
+        for (size_t r : roots) { legacy[r]->setPositionX((float)(repeat - it)); }
+        for (size_t i = 0; i < count; i += 100) { legacy[i]->getGlobalTransform(); }
+    });
+    for (size_t r : roots) { legacy[r]->setPositionX((float)(repeat - 1)); }
+
+    bool identical = true;
+    for (size_t i = 0; i < count && identical; i++) {
+        const mat4& a = legacy[i]->getGlobalTransform();
+        const mat4& b = serial.getGlobalTransform(hs[i]);
+        const mat4& c = parallel.getGlobalTransform(hp[i]);
+        identical = std::memcmp(&a, &b, sizeof(mat4)) == 0 && std::memcmp(&b, &c, sizeof(mat4)) == 0;
+    }
+    printf("%-14s %8zu nodes | Transform %8.3f ms (1%% queried %7.3f ms) | serial %8.3f ms | parallel %8.3f ms | %s\n",
+        shape.name, count, tLegacy, tSparse, tSerial, tParallel, identical ? "identical" : "MISMATCH");
+
+    for (size_t r : roots) { delete legacy[r]; }
+    return identical;
+}
+
+int main(int argc, char* argv[]) {
+    size_t threads = std::thread::hardware_concurrency();
+    if (argc >= 2) { threads = (size_t)atoi(argv[1]); }
+    int repeat = argc >= 3 ? atoi(argv[2]) : 20;
+    ThreadPool pool(threads);
+    printf("worker threads: %zu (max 8), repeat: %d\n", threads > 8 ? (size_t)8 : threads, repeat);
+    const Shape shapes[] = {
+        { "wide-shallow", 2000, 50, 2 },
+        { "balanced", 16, 4, 7 },
+        { "deep-narrow", 64, 1, 1000 },
+    };
+    bool ok = true;
+    for (const Shape& shape : shapes) { ok &= run(shape, pool, repeat); }
+    return ok ? 0 : 1;
+}